@@ -0,0 +1,70 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "AsyncFileWriter.h"
+
+#include <cassert>
+#include <fstream>
+#include <unistd.h>
+
+Timer AsyncFileWriter::wait_tm_("AsyncFileWriter::wait");
+Timer AsyncFileWriter::write_tm_("AsyncFileWriter::write");
+
+AsyncFileWriter::AsyncFileWriter(const short max_num_try)
+    : max_num_try_(max_num_try), status_(0)
+{
+    assert(max_num_try_ > 0);
+}
+
+AsyncFileWriter::~AsyncFileWriter() { wait(); }
+
+// executed by background thread
+void AsyncFileWriter::writeBuffer()
+{
+    write_tm_.start();
+
+    status_ = -1;
+    for (short count = 0; count < max_num_try_ && status_ < 0; count++)
+    {
+        if (count > 0) sleep(1);
+
+        std::ofstream out(filename_.c_str(), std::ios::out | std::ios::binary);
+        if (!out) continue;
+
+        out.write(buffer_.data(), buffer_.size());
+        out.close();
+        if (out) status_ = 0;
+    }
+
+    write_tm_.stop();
+}
+
+int AsyncFileWriter::wait()
+{
+    if (thread_.joinable())
+    {
+        wait_tm_.start();
+        thread_.join();
+        wait_tm_.stop();
+    }
+
+    return status_;
+}
+
+int AsyncFileWriter::submit(const std::string& filename)
+{
+    const int status = wait();
+
+    buffer_.swap(staging_);
+    filename_ = filename;
+
+    thread_ = std::thread(&AsyncFileWriter::writeBuffer, this);
+
+    return status;
+}
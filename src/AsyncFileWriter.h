@@ -0,0 +1,77 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_ASYNCFILEWRITER_H
+#define MGMOL_ASYNCFILEWRITER_H
+
+#include "Timer.h"
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Write files in a background thread so that computation can proceed
+// while data is transferred to disk.
+// Double buffering: the caller fills a staging buffer while the previous
+// buffer may still be written; submit() waits for completion of the
+// previous write (fence) before swapping buffers and starting a new write.
+// No MPI or HDF5 calls are made by the background thread.
+class AsyncFileWriter
+{
+    static Timer wait_tm_;
+    static Timer write_tm_;
+
+    // max. number of attempts at writing a file
+    const short max_num_try_;
+
+    std::thread thread_;
+
+    // buffer filled by caller
+    std::vector<char> staging_;
+
+    // buffer being written by thread_, and its destination
+    std::vector<char> buffer_;
+    std::string filename_;
+
+    // status of last write (0 if successful)
+    int status_;
+
+    void writeBuffer();
+
+public:
+    AsyncFileWriter(const short max_num_try = 1);
+
+    // waits for completion of write in progress
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    std::vector<char>& stagingBuffer() { return staging_; }
+
+    // Start writing content of staging buffer to file "filename",
+    // after completion of previous write.
+    // Returns status of previous write (0 if successful)
+    int submit(const std::string& filename);
+
+    // Wait for completion of write in progress, if any, and return its
+    // status (0 if successful)
+    int wait();
+
+    bool busy() const { return thread_.joinable(); }
+
+    static void printTimers(std::ostream& os)
+    {
+        wait_tm_.print(os);
+        write_tm_.print(os);
+    }
+};
+
+#endif
@@ -95,6 +95,12 @@ void ChebyshevApproximation<MatrixType>::buildChebyshevNodes(
         nodeT++;
     }
 
+    // traces of polynomials (moments), so that the trace of any
+    // approximation can later be evaluated from its coefficients only
+    tracesTk_.resize(n);
+    for (int k = 0; k < n; k++)
+        tracesTk_[k] = nodesTk_[k].trace();
+
     // done ...
 
     build_nodes_tm_.stop();
@@ -149,6 +155,22 @@ MatrixType ChebyshevApproximation<MatrixType>::computeChebyshevApproximation()
     return matX;
 }
 
+// Compute trace of Chebyshev approximation given vectors of coefficients and
+// traces of Chebyshev nodes
+template <class MatrixType>
+double ChebyshevApproximation<
+    MatrixType>::computeChebyshevApproximationTrace() const
+{
+    assert(static_cast<int>(tracesTk_.size()) == order_);
+    assert(static_cast<int>(coeffs_.size()) == order_);
+
+    double trace = 0.;
+    for (int k = 0; k < order_; k++)
+        trace += coeffs_[k] * tracesTk_[k];
+
+    return trace;
+}
+
 // Compute Chebyshev approximation given extents of approximation and matrix
 // argument (for computing polynomials)
 template <class MatrixType>
@@ -22,6 +22,7 @@ class ChebyshevApproximation : public ChebyshevApproximationInterface
 
 private:
     std::vector<MatrixType> nodesTk_; // Chebyshev nodes (polynomials)
+    std::vector<double> tracesTk_; // traces of Chebyshev nodes (moments)
 
     // Shift and scale matrix H so that spectrum is in range [-1, 1].
     // NOTE: Matrix is modified on return
@@ -41,6 +42,9 @@ public:
     void buildChebyshevNodes(const double a, const double b, MatrixType& H);
     // Compute Chebyshev approximation stored data (coeffs_ and nodesTk_)
     MatrixType computeChebyshevApproximation();
+    // Compute trace of Chebyshev approximation from coeffs_ and tracesTk_,
+    // without any matrix operation
+    double computeChebyshevApproximationTrace() const;
     // Compute Chebyshev approximation given extents of approximation and matrix
     // argument (for computing polynomials)
     MatrixType computeChebyshevApproximation(
@@ -0,0 +1,239 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "ChebyshevFilterDMStrategy.h"
+#include "Control.h"
+#include "ExtendedGridOrbitals.h"
+#include "Ions.h"
+#include "LocGridOrbitals.h"
+#include "MGmol.h"
+#include "MGmol_MPI.h"
+#include "ProjectedMatrices.h"
+#include "ReplicatedMatrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+template <class OrbitalsType, class MatrixType>
+Timer ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::filter_tm_(
+    "ChebyshevFilterDMStrategy::filter");
+template <class OrbitalsType, class MatrixType>
+Timer ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::bound_tm_(
+    "ChebyshevFilterDMStrategy::bound");
+
+template <class OrbitalsType, class MatrixType>
+ChebyshevFilterDMStrategy<OrbitalsType,
+    MatrixType>::ChebyshevFilterDMStrategy(Ions& ions,
+    ProjectedMatricesInterface* proj_matrices,
+    MGmol<OrbitalsType>* mgmol_strategy, const short degree)
+    : ions_(ions),
+      proj_matrices_(
+          dynamic_cast<ProjectedMatrices<MatrixType>*>(proj_matrices)),
+      mgmol_strategy_(mgmol_strategy),
+      degree_(degree),
+      emax_(-1.)
+{
+    assert(degree_ > 0);
+
+    // checked in Control::checkOptions
+    if (proj_matrices_ == nullptr)
+    {
+        std::cerr << "ChebyshevFilterDMStrategy requires dense projected "
+                     "matrices"
+                  << std::endl;
+        MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+        mmpi.abort();
+    }
+}
+
+template <class OrbitalsType, class MatrixType>
+void ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::initialize(
+    OrbitalsType& orbitals)
+{
+    rayleighRitz(orbitals);
+}
+
+template <class OrbitalsType, class MatrixType>
+int ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::update(
+    OrbitalsType& orbitals)
+{
+    Control& ct = *(Control::instance());
+
+    if (emax_ < 0.) estimateUpperBound(orbitals);
+
+    // filter interval: [highest Ritz value, upper bound of spectrum],
+    // with lowest Ritz value used to scale polynomial
+    // (only the Ritz values actually computed are meaningful)
+    const std::vector<double>& eigenvalues = proj_matrices_->getEigenvalues();
+    const int neig = std::min(ct.numst, proj_matrices_->getNumEigenvalues());
+    const double a0 = eigenvalues[0];
+    const double a  = eigenvalues[neig - 1];
+    if (a > a0 && a < emax_)
+    {
+        if (onpe0 && ct.verbose > 1)
+            (*MPIdata::sout) << "ChebyshevFilterDMStrategy: filter interval ["
+                             << a << "," << emax_ << "]" << std::endl;
+        filter(orbitals, a, emax_, a0);
+    }
+    else
+    {
+        // bound is outdated, recompute it for next update
+        if (onpe0)
+            (*MPIdata::sout) << "ChebyshevFilterDMStrategy: highest Ritz "
+                                "value above spectrum bound, skip filtering"
+                             << std::endl;
+        emax_ = -1.;
+    }
+
+    // normalize first as filtered vectors can become quite small...
+    orbitals.normalize();
+    orbitals.orthonormalizeLoewdin(false, nullptr, false);
+
+    orbitals.setDataWithGhosts();
+    orbitals.trade_boundaries();
+
+    // H matrix for filtered orbitals
+    mgmol_strategy_->updateHmatrix(orbitals, ions_);
+
+    rayleighRitz(orbitals);
+
+    return 0;
+}
+
+// rotate orbitals into Ritz vectors and build DM
+template <class OrbitalsType, class MatrixType>
+void ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::rayleighRitz(
+    OrbitalsType& orbitals)
+{
+    Control& ct = *(Control::instance());
+
+    MatrixType zz("Z", ct.numst, ct.numst);
+
+    proj_matrices_->updateDMwithEigenstatesAndRotate(
+        orbitals.getIterativeIndex(), zz);
+
+    orbitals.multiply_by_matrix(zz);
+    orbitals.setDataWithGhosts();
+    orbitals.trade_boundaries();
+}
+
+// Estimate upper bound of spectrum of H by a few steps of power method
+// applied to all the orbitals, using for each one Rayleigh quotient plus
+// residual norm, as an interval containing an eigenvalue
+template <class OrbitalsType, class MatrixType>
+void ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::estimateUpperBound(
+    OrbitalsType& orbitals)
+{
+    bound_tm_.start();
+
+    Control& ct        = *(Control::instance());
+    const short maxits = 10;
+
+    OrbitalsType y("ChebyshevFilter_y", orbitals);
+    OrbitalsType hy("ChebyshevFilter_hy", orbitals, false);
+    y.normalize();
+    for (short it = 0; it < maxits; it++)
+    {
+        mgmol_strategy_->applyH(ions_, y, hy);
+        if (it == maxits - 1) break;
+
+        y.assign(hy);
+        y.normalize();
+    }
+
+    std::vector<DISTMATDTYPE> yhy(ct.numst);
+    std::vector<DISTMATDTYPE> hyhy(ct.numst);
+    hy.computeDiagonalElementsDotProduct(y, yhy);
+    hy.computeDiagonalElementsDotProduct(hy, hyhy);
+
+    emax_ = yhy[0];
+    for (int i = 0; i < ct.numst; i++)
+    {
+        const double res = std::sqrt(std::max(0., hyhy[i] - yhy[i] * yhy[i]));
+        emax_            = std::max(emax_, yhy[i] + res);
+    }
+
+    if (onpe0 && ct.verbose > 0)
+        (*MPIdata::sout) << "ChebyshevFilterDMStrategy: upper bound of "
+                            "spectrum = "
+                         << emax_ << std::endl;
+
+    bound_tm_.stop();
+}
+
+// Apply Chebyshev polynomial of degree degree_ damping the interval [a,b],
+// scaled so that it is of order one at a0 (Zhou et al., Algorithm 4.1).
+template <class OrbitalsType, class MatrixType>
+void ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::filter(
+    OrbitalsType& orbitals, const double a, const double b, const double a0)
+{
+    assert(b > a);
+    assert(a > a0);
+
+    filter_tm_.start();
+
+    const double e   = 0.5 * (b - a);
+    const double c   = 0.5 * (b + a);
+    double sigma     = e / (a0 - c);
+    const double tau = 2. / sigma;
+
+    std::unique_ptr<OrbitalsType> x(
+        new OrbitalsType("ChebyshevFilter_x", orbitals));
+    std::unique_ptr<OrbitalsType> y(
+        new OrbitalsType("ChebyshevFilter_y", orbitals, false));
+    std::unique_ptr<OrbitalsType> ynew(
+        new OrbitalsType("ChebyshevFilter_ynew", orbitals, false));
+
+    // y = (H-c)*x*sigma/e
+    mgmol_strategy_->applyH(ions_, *x, *y);
+    y->axpy(-c, *x);
+    y->scal(sigma / e);
+
+    for (short i = 1; i < degree_; i++)
+    {
+        // ynew = 2*(H-c)*y*sigma_new/e - sigma*sigma_new*x
+        const double sigma_new = 1. / (tau - sigma);
+        mgmol_strategy_->applyH(ions_, *y, *ynew);
+        ynew->axpy(-c, *y);
+        ynew->scal(2. * sigma_new / e);
+        ynew->axpy(-sigma * sigma_new, *x);
+
+        std::swap(x, y);
+        std::swap(y, ynew);
+        sigma = sigma_new;
+    }
+
+    orbitals.assign(*y);
+    orbitals.applyMask();
+
+    // y inherited its iterative index from orbitals before filtering
+    orbitals.incrementIterativeIndex();
+
+    filter_tm_.stop();
+}
+
+template <class OrbitalsType, class MatrixType>
+void ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>::printTimers(
+    std::ostream& os)
+{
+    filter_tm_.print(os);
+    bound_tm_.print(os);
+}
+
+template class ChebyshevFilterDMStrategy<LocGridOrbitals,
+    dist_matrix::DistMatrix<double>>;
+template class ChebyshevFilterDMStrategy<ExtendedGridOrbitals,
+    dist_matrix::DistMatrix<double>>;
+#ifdef HAVE_MAGMA
+template class ChebyshevFilterDMStrategy<ExtendedGridOrbitals,
+    ReplicatedMatrix>;
+#endif
@@ -0,0 +1,70 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_CHEBYSHEVFILTERDMSTRATEGY_H
+#define MGMOL_CHEBYSHEVFILTERDMSTRATEGY_H
+
+#include "DMStrategy.h"
+#include "Timer.h"
+
+#include <iostream>
+
+class Ions;
+class ProjectedMatricesInterface;
+template <class OrbitalsType>
+class MGmol;
+template <class MatrixType>
+class ProjectedMatrices;
+
+// Chebyshev filtered subspace iteration (Zhou, Saad, Tiago, Chelikowsky,
+// J. Comput. Phys. 219 (2006)):
+// at each update, orbitals are multiplied by a Chebyshev polynomial in H
+// damping the part of the spectrum above the current highest Ritz value,
+// then orthonormalized and rotated into Ritz vectors
+// (Rayleigh-Ritz step), from which the DM is built.
+template <class OrbitalsType, class MatrixType>
+class ChebyshevFilterDMStrategy : public DMStrategy<OrbitalsType>
+{
+private:
+    Ions& ions_;
+    ProjectedMatrices<MatrixType>* proj_matrices_;
+    MGmol<OrbitalsType>* mgmol_strategy_;
+
+    // degree of polynomial filter
+    const short degree_;
+
+    // estimate of largest eigenvalue of H (<0 if not computed yet)
+    double emax_;
+
+    static Timer filter_tm_;
+    static Timer bound_tm_;
+
+    void rayleighRitz(OrbitalsType& orbitals);
+    void estimateUpperBound(OrbitalsType& orbitals);
+    void filter(OrbitalsType& orbitals, const double a, const double b,
+        const double a0);
+
+public:
+    ChebyshevFilterDMStrategy(Ions& ions,
+        ProjectedMatricesInterface* proj_matrices,
+        MGmol<OrbitalsType>* mgmol_strategy, const short degree);
+
+    void initialize(OrbitalsType& orbitals) override;
+    int update(OrbitalsType& orbitals) override;
+
+    bool needH() const override { return true; }
+
+    void stripDM() override {}
+    void dressDM() override {}
+    void reset() override {}
+
+    static void printTimers(std::ostream& os);
+};
+
+#endif
@@ -69,11 +69,20 @@ Control::Control()
     dm_approx_order        = 500;
     dm_approx_ndigits      = 1;
     dm_approx_power_maxits = 100;
+    dm_filter_degree       = 10;
+    dm_drop_tol            = 0.;
     wf_extrapolation_      = 1;
     verbose                = 0;
+    rho_accumulation_      = 1;
+    overlap_halo_comm_     = 0;
+    persistent_halo_comm_  = 0;
+    poisson_precision_     = 0;
+
+    poisson_agglomeration_min_points = 0;
 
     // undefined values
     dm_algo_                         = -1;
+    dm_eigensolver_                  = 0;
     short_sighted                    = -1;
     it_algo_type_                    = -1;
     DM_solver_                       = -1;
@@ -105,6 +114,10 @@ Control::Control()
     lr_volume_calc                   = -1;
     init_rc                          = -1.;
     out_restart_file_naming_strategy = 0;
+    out_restart_async                = 0;
+    out_restart_compression          = 0;
+    out_restart_compression_level    = 1;
+    out_restart_cb_nodes             = 0;
     tol_orb_centers_move             = 10.e8;
     restart_file_type                = -1;
     restart_info                     = -1;
@@ -139,6 +152,9 @@ Control::Control()
     conv_tol                          = -1.;
     thermostat_type                   = -1;
     hartree_reset_                    = -1;
+    hartree_extrapolation_            = -1;
+    hartree_adaptive_tol_factor_      = -1.;
+    projectors_reuse_tol_             = -1.;
     threshold_eigenvalue_gram_        = -1.;
     threshold_eigenvalue_gram_quench_ = -1.;
     pair_mlwf_distance_threshold_     = -1.;
@@ -264,6 +280,11 @@ void Control::print(std::ostream& os)
               "approximation interval = "
            << dm_approx_power_maxits << std::endl;
     }
+    if (DM_solver() == DMNonLinearSolverType::ChebyshevFilter)
+    {
+        os << " Chebyshev filtered subspace iteration, filter degree = "
+           << dm_filter_degree << std::endl;
+    }
     os << " Load balancing alpha for computing bias = " << load_balancing_alpha
        << std::endl;
     os << " Load balancing parameter for damping bias updates = "
@@ -347,7 +368,7 @@ void Control::sync(void)
     if (onpe0 && verbose > 0)
         (*MPIdata::sout) << "Control::sync()" << std::endl;
     // pack
-    const short size_short_buffer = 91;
+    const short size_short_buffer = 97;
     short* short_buffer           = new short[size_short_buffer];
     if (mype_ == 0)
     {
@@ -427,6 +448,10 @@ void Control::sync(void)
         short_buffer[73] = load_balancing_modulo;
         short_buffer[74] = write_clusters;
         short_buffer[75] = DM_solver_;
+        short_buffer[76] = rho_accumulation_;
+        short_buffer[77] = overlap_halo_comm_;
+        short_buffer[78] = persistent_halo_comm_;
+        short_buffer[79] = poisson_precision_;
         short_buffer[80] = dm_algo_;
         short_buffer[81] = dm_approx_order;
         short_buffer[82] = dm_approx_ndigits;
@@ -434,15 +459,22 @@ void Control::sync(void)
         short_buffer[84] = spread_penalty_type_;
         short_buffer[85] = dm_use_old_;
         short_buffer[86] = max_electronic_steps_tight_;
+        short_buffer[87] = hartree_extrapolation_;
         short_buffer[88] = hartree_reset_;
         short_buffer[89] = MD_last_step_;
         short_buffer[90] = (short)static_cast<int>(poisson_lap_type_);
+        short_buffer[91] = dm_filter_degree;
+        short_buffer[92] = out_restart_async;
+        short_buffer[93] = out_restart_compression;
+        short_buffer[94] = out_restart_compression_level;
+        short_buffer[95] = out_restart_cb_nodes;
+        short_buffer[96] = dm_eigensolver_;
     }
     else
     {
         memset(&short_buffer[0], 0, size_short_buffer * sizeof(short));
     }
-    const short size_int_buffer = 4;
+    const short size_int_buffer = 5;
     int* int_buffer             = new int[size_int_buffer];
     if (mype_ == 0)
     {
@@ -450,13 +482,14 @@ void Control::sync(void)
         int_buffer[1] = nel_;
         int_buffer[2] = nempty_;
         int_buffer[3] = num_ions;
+        int_buffer[4] = poisson_agglomeration_min_points;
     }
     else
     {
         memset(&int_buffer[0], 0, size_int_buffer * sizeof(int));
     }
 
-    const short size_float_buffer = 43;
+    const short size_float_buffer = 47;
     float* float_buffer           = new float[size_float_buffer];
     if (mype_ == 0)
     {
@@ -502,6 +535,10 @@ void Control::sync(void)
         float_buffer[40] = threshold_eigenvalue_gram_quench_;
         float_buffer[41] = pair_mlwf_distance_threshold_;
         float_buffer[42] = e0_;
+        float_buffer[43] = hartree_adaptive_tol_factor_;
+        float_buffer[44] = dm_tol;
+        float_buffer[45] = dm_drop_tol;
+        float_buffer[46] = projectors_reuse_tol_;
     }
     else
     {
@@ -531,6 +568,7 @@ void Control::sync(void)
     mmpi.bcast(restart_file, comm_global_);
     mmpi.bcast(out_restart_file, comm_global_);
     mmpi.bcast(md_print_filename, comm_global_);
+    mmpi.bcast(profile_output, comm_global_);
 
     short npot = pot_filenames_.size();
     mpirc      = MPI_Bcast(&npot, 1, MPI_SHORT, 0, comm_global_);
@@ -639,6 +677,10 @@ void Control::sync(void)
     load_balancing_modulo            = short_buffer[73];
     write_clusters                   = short_buffer[74];
     DM_solver_                       = short_buffer[75];
+    rho_accumulation_                = short_buffer[76];
+    overlap_halo_comm_               = short_buffer[77];
+    persistent_halo_comm_            = short_buffer[78];
+    poisson_precision_               = short_buffer[79];
     dm_algo_                         = short_buffer[80];
     dm_approx_order                  = short_buffer[81];
     dm_approx_ndigits                = short_buffer[82];
@@ -646,15 +688,24 @@ void Control::sync(void)
     spread_penalty_type_             = short_buffer[84];
     dm_use_old_                      = short_buffer[85];
     max_electronic_steps_tight_      = short_buffer[86];
+    hartree_extrapolation_           = short_buffer[87];
     hartree_reset_                   = short_buffer[88];
     MD_last_step_                    = short_buffer[89];
     poisson_lap_type_ = static_cast<PoissonFDtype>(short_buffer[90]);
+    dm_filter_degree  = short_buffer[91];
+    out_restart_async             = short_buffer[92];
+    out_restart_compression       = short_buffer[93];
+    out_restart_compression_level = short_buffer[94];
+    out_restart_cb_nodes          = short_buffer[95];
+    dm_eigensolver_               = short_buffer[96];
 
     numst    = int_buffer[0];
     nel_     = int_buffer[1];
     nempty_  = int_buffer[2];
     num_ions = int_buffer[3];
 
+    poisson_agglomeration_min_points = int_buffer[4];
+
     betaAnderson                      = float_buffer[0];
     spread_penalty_target_            = float_buffer[1];
     precond_factor                    = float_buffer[2];
@@ -697,6 +748,10 @@ void Control::sync(void)
     threshold_eigenvalue_gram_quench_ = float_buffer[40];
     pair_mlwf_distance_threshold_     = float_buffer[41];
     e0_                               = float_buffer[42];
+    hartree_adaptive_tol_factor_      = float_buffer[43];
+    dm_tol                            = float_buffer[44];
+    dm_drop_tol                       = float_buffer[45];
+    projectors_reuse_tol_             = float_buffer[46];
     max_electronic_steps_loose_       = max_electronic_steps;
 
     delete[] short_buffer;
@@ -1382,6 +1437,9 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
                 pseudopot_flags_.push_back(filter_flag);
         }
 
+        projectors_reuse_tol_
+            = vm["Potentials.projectors_reuse_tol"].as<float>();
+
         if (vm.count("Potentials.external"))
         {
             char bin_flag = vm["Potentials.binExternal"].as<bool>() ? 'a' : 'b';
@@ -1408,6 +1466,8 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         str = vm["Restart.input_type"].as<std::string>();
         if (str.compare("distributed") == 0)
             restart_file_type = 0;
+        else if (str.compare("single_file_direct") == 0)
+            restart_file_type = 3;
         else
             restart_file_type = 1;
 
@@ -1440,6 +1500,21 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
 
         checkpoint = vm["Restart.interval"].as<short>();
 
+        out_restart_async = vm["Restart.async"].as<bool>() ? 1 : 0;
+
+        str = vm["Restart.compression"].as<std::string>();
+        if (str.compare("none") == 0)
+            out_restart_compression = 0;
+        else if (str.compare("deflate") == 0)
+            out_restart_compression = 1;
+        else if (str.compare("shuffle_deflate") == 0)
+            out_restart_compression = 2;
+        else
+            out_restart_compression = -1;
+        out_restart_compression_level
+            = vm["Restart.compression_level"].as<short>();
+        out_restart_cb_nodes = vm["Restart.cb_nodes"].as<short>();
+
         rescale_v_ = vm["Restart.rescale_v"].as<double>();
 
         // Poisson solver
@@ -1484,6 +1559,14 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         if (str.compare("CG") == 0) diel_flag_ = 10;
         if (str.compare("MG") == 0) diel_flag_ = 0;
 
+        str = vm["Poisson.precision"].as<std::string>();
+        if (str.compare("double") == 0)
+            poisson_precision_ = 0;
+        else if (str.compare("mixed") == 0)
+            poisson_precision_ = 1;
+        else
+            poisson_precision_ = -1;
+
         str = vm["Poisson.diel"].as<std::string>();
         if (str.compare("on") == 0 || str.compare("ON") == 0) diel = 1;
         if (str.compare("off") == 0 || str.compare("OFF") == 0) diel = 0;
@@ -1491,6 +1574,12 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         bool poisson_reset = vm["Poisson.reset"].as<bool>();
         hartree_reset_     = poisson_reset ? 1 : 0;
 
+        bool poisson_extrapolate = vm["Poisson.extrapolate"].as<bool>();
+        hartree_extrapolation_   = poisson_extrapolate ? 1 : 0;
+
+        hartree_adaptive_tol_factor_
+            = vm["Poisson.adaptive_tol_factor"].as<float>();
+
         poisson_pc_nu1  = vm["Poisson.nu1"].as<short>();
         poisson_pc_nu2  = vm["Poisson.nu2"].as<short>();
         vh_init         = vm["Poisson.max_steps_initial"].as<short>();
@@ -1661,6 +1750,8 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         str = vm["Coloring.scope"].as<std::string>();
         if (str.compare("local") == 0) coloring_algo_ += 10;
 
+        profile_output = vm["Run.profile_output"].as<std::string>();
+
         str                         = vm["Run.type"].as<std::string>();
         max_electronic_steps        = vm["Quench.max_steps"].as<short>();
         max_electronic_steps_loose_ = max_electronic_steps;
@@ -1753,6 +1844,7 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
 
         nempty_ = vm["Orbitals.nempty"].as<short>();
         str     = vm["Orbitals.type"].as<std::string>();
+        if (str.compare("Eigenfunctions") == 0) orbital_type_ = 0;
         if (str.compare("NO") == 0) orbital_type_ = 1;
         if (str.compare("Orthonormal") == 0) orbital_type_ = 2;
         std::cout << "Orbitals type: " << str << std::endl;
@@ -1828,12 +1920,43 @@ void Control::setOptions(const boost::program_options::variables_map& vm)
         else
             dm_algo_ = 2;
 
-        dm_tol = vm["DensityMatrix.tol"].as<float>();
+        str = vm["DensityMatrix.eigensolver"].as<std::string>();
+        if (str.compare("QR") == 0)
+            dm_eigensolver_ = 0;
+        else if (str.compare("DivideAndConquer") == 0)
+            dm_eigensolver_ = 1;
+        else if (str.compare("MRRR") == 0)
+            dm_eigensolver_ = 2;
+        else
+            dm_eigensolver_ = -1;
+
+        dm_tol      = vm["DensityMatrix.tol"].as<float>();
+        dm_drop_tol = vm["DensityMatrix.drop_tol"].as<float>();
 
         str = vm["DensityMatrix.solver"].as<std::string>();
         if (str.compare("Mixing") == 0) DM_solver_ = 0;
         if (str.compare("MVP") == 0) DM_solver_ = 1;
         if (str.compare("HMVP") == 0) DM_solver_ = 2;
+        if (str.compare("ChebyshevFilter") == 0) DM_solver_ = 3;
+        dm_filter_degree = vm["DensityMatrix.filter_degree"].as<short>();
+
+        str = vm["Rho.accumulation"].as<std::string>();
+        if (str.compare("atomic") == 0)
+            rho_accumulation_ = 0;
+        else if (str.compare("blocked") == 0)
+            rho_accumulation_ = 1;
+        else
+            rho_accumulation_ = -1;
+
+        bool overlap_halo_comm = vm["Orbitals.overlap_halo_comm"].as<bool>();
+        overlap_halo_comm_     = overlap_halo_comm ? 1 : 0;
+
+        bool persistent_halo_comm
+            = vm["Parallel.persistent_halo_comm"].as<bool>();
+        persistent_halo_comm_ = persistent_halo_comm ? 1 : 0;
+
+        poisson_agglomeration_min_points
+            = vm["Poisson.agglomeration_min_points"].as<int>();
 
         load_balancing_alpha = vm["LoadBalancing.alpha"].as<float>();
         load_balancing_damping_tol
@@ -1899,6 +2022,18 @@ int Control::checkOptions()
         return -1;
     }
 
+    if (RhoAccumulation() == RhoAccumulationType::UNDEFINED)
+    {
+        std::cerr << "ERROR: unknown Rho accumulation type\n";
+        return -1;
+    }
+
+    if (poisson_precision_ < 0)
+    {
+        std::cerr << "ERROR: unknown Poisson precision\n";
+        return -1;
+    }
+
     if (short_sighted && lap_type == 0)
     {
         std::cerr
@@ -1907,6 +2042,49 @@ int Control::checkOptions()
         return -1;
     }
 
+    if (DM_solver() == DMNonLinearSolverType::ChebyshevFilter)
+    {
+        if (getOrthoType() != OrthoType::Eigenfunctions)
+        {
+            std::cerr << "ERROR: Chebyshev filter requires "
+                         "Orbitals.type=Eigenfunctions"
+                      << std::endl;
+            return -1;
+        }
+        if (lap_type == 0)
+        {
+            std::cerr << "ERROR: Mehrstellen not compatible with Chebyshev "
+                         "filter!"
+                      << std::endl;
+            return -1;
+        }
+        if (short_sighted)
+        {
+            std::cerr << "ERROR: Short-sighted algorithm not compatible with "
+                         "Chebyshev filter!"
+                      << std::endl;
+            return -1;
+        }
+        if (dm_filter_degree < 1)
+        {
+            std::cerr << "ERROR: Chebyshev filter degree must be > 0"
+                      << std::endl;
+            return -1;
+        }
+    }
+
+    if (dm_eigensolver_ < 0)
+    {
+        std::cerr << "ERROR: unknown DensityMatrix.eigensolver" << std::endl;
+        return -1;
+    }
+
+    if (dm_drop_tol < 0.)
+    {
+        std::cerr << "ERROR: DensityMatrix.drop_tol must be >= 0" << std::endl;
+        return -1;
+    }
+
     if (it_algo_type_ == 3 && lap_type == 0)
     {
         std::cerr
@@ -1923,7 +2101,39 @@ int Control::checkOptions()
         return -1;
     }
 
-    if (restart_file_type == 1 && !globalColoring() && restart_info > 2)
+    if (out_restart_compression < 0)
+    {
+        std::cerr << "ERROR: unknown Restart.compression" << std::endl;
+        return -1;
+    }
+
+    if (out_restart_compression > 0
+        && (out_restart_compression_level < 1
+               || out_restart_compression_level > 9))
+    {
+        std::cerr << "ERROR: restart compression level must be in [1,9]!!!"
+                  << std::endl;
+        return -1;
+    }
+
+    if (out_restart_cb_nodes < 0)
+    {
+        std::cerr << "ERROR: Restart.cb_nodes must be >= 0!!!" << std::endl;
+        return -1;
+    }
+
+#ifndef MGMOL_USE_HDF5P
+    if (restart_info > 0 && restart_file_type == 3)
+    {
+        std::cerr << "ERROR: Restart.input_type=single_file_direct requires "
+                     "MGmol built with parallel HDF5!!!"
+                  << std::endl;
+        return -1;
+    }
+#endif
+
+    if ((restart_file_type == 1 || restart_file_type == 3) && !globalColoring()
+        && restart_info > 2)
     {
         std::cerr << "ERROR: reading single restart file with wave functions "
                      "requires global coloring!!!"
@@ -1943,6 +2153,14 @@ int Control::checkOptions()
             << std::endl;
         return -1;
     }
+    if (short_sighted > 0 && DMEigensolver() == DMEigensolverType::SP2
+        && dm_mix < 1.)
+    {
+        (*MPIdata::sout) << "ERROR: Short-sighted SP2 requires "
+                            "DensityMatrix.mixing=1"
+                         << std::endl;
+        return -1;
+    }
     if (lrs_extrapolation > 0 && lrs_compute > 0)
     {
         (*MPIdata::sout) << "ERROR: must choose either extrapolation or "
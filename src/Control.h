@@ -62,6 +62,7 @@ enum class DMNonLinearSolverType
     Mixing,
     MVP,
     HMVP,
+    ChebyshevFilter,
     UNDEFINED
 };
 
@@ -73,6 +74,13 @@ enum class DMEigensolverType
     UNDEFINED
 };
 
+enum class RhoAccumulationType
+{
+    Atomic,
+    Blocked,
+    UNDEFINED
+};
+
 enum class OrthoType
 {
     Eigenfunctions,
@@ -189,6 +197,25 @@ private:
 
     short dm_algo_;
 
+    // dense symmetric eigensolver used in diagonalization
+    // 0 = QR, 1 = divide and conquer, 2 = MRRR
+    short dm_eigensolver_;
+
+    // algorithm to accumulate O(N^2) part of rho
+    // 0 = OpenMP atomics, 1 = blocks of rows owned by threads
+    short rho_accumulation_;
+
+    // overlap ghost values exchange of orbitals with
+    // FD stencil application on interior points
+    short overlap_halo_comm_;
+
+    // use persistent MPI requests for ghost values exchanges
+    short persistent_halo_comm_;
+
+    // precision of Poisson solver
+    // 0 = double, 1 = single precision V-cycles with double residuals
+    short poisson_precision_;
+
     // flag to decide if condition number of Gram matrix
     // should be computed during quench (value 2) or
     // only at the end of quench (value 1)
@@ -255,6 +282,8 @@ public:
 
     int getNel() const { return nel_; }
 
+    int getNempty() const { return nempty_; }
+
     double getNelSpin() const
     {
         assert(nelspin_ >= 0.);
@@ -399,6 +428,10 @@ public:
     short poisson_pc_nu2;
     short poisson_pc_nlev;
 
+    // merge MG subdomains of neighboring tasks below that number of
+    // points per task (0: never)
+    int poisson_agglomeration_min_points;
+
     PoissonFDtype poisson_lap_type_;
 
     short lap_type;
@@ -453,8 +486,13 @@ public:
     short dm_approx_ndigits;
     short dm_approx_power_maxits;
 
+    // degree of Chebyshev polynomial filter applied to orbitals
+    short dm_filter_degree;
+
     // SP2 options
     float dm_tol;
+    // entries of sparse SP2 iterates smaller than dm_drop_tol are dropped
+    float dm_drop_tol;
 
     // Initial number of v-cycles for hartree solution
     short vh_init;
@@ -526,6 +564,17 @@ public:
     // flag to reset Vh at beginning of each MD step
     short hartree_reset_;
 
+    // flag to extrapolate Vh from previous two MD steps
+    short hartree_extrapolation_;
+
+    // if > 0, relative tolerance of Hartree solves is set to that factor
+    // times the SCF convergence measure (dvrho per atom)
+    float hartree_adaptive_tol_factor_;
+
+    // max. displacement of an atom for which its nonlocal projectors
+    // are not recomputed (projectors always recomputed if negative)
+    float projectors_reuse_tol_;
+
     // short-sighted computation of selected elements of inverse
     short short_sighted;
     short fgmres_kim;
@@ -551,6 +600,15 @@ public:
     short out_restart_file_naming_strategy;
     short restart_file_type;
     short out_restart_file_type;
+    // write MD restart files asynchronously
+    short out_restart_async;
+    // HDF5 filters for restart datasets:
+    // 0: none, 1: deflate, 2: shuffle+deflate
+    short out_restart_compression;
+    short out_restart_compression_level;
+    // number of MPI-IO collective buffering aggregators
+    // (single_file output type only, 0 for MPI-IO default)
+    short out_restart_cb_nodes;
     short override_restart;
 
     short verbose;
@@ -562,6 +620,10 @@ public:
     short write_clusters;
     std::string load_balancing_output_file;
 
+    // prefix of files for hierarchical profiling data
+    // (profiling disabled if empty)
+    std::string profile_output;
+
     float reducedCutRadius() const { return 0.5 * cut_radius; }
     std::vector<Species>& getSpecies() { return sp_; }
     void setSpecies(Potentials& pot);
@@ -610,6 +672,9 @@ public:
     bool checkResidual() const { return (conv_criterion_ > 0); }
     bool checkMaxResidual() const { return (conv_criterion_ == 2); }
     bool resetVH() const { return (hartree_reset_ > 0); }
+    bool extrapolateVH() const { return (hartree_extrapolation_ > 0); }
+    float VHadaptiveTolFactor() const { return hartree_adaptive_tol_factor_; }
+    float projectorsReuseTol() const { return projectors_reuse_tol_; }
 
     OuterSolverType OuterSolver()
     {
@@ -670,11 +735,27 @@ public:
                 return DMNonLinearSolverType::MVP;
             case 2:
                 return DMNonLinearSolverType::HMVP;
+            case 3:
+                return DMNonLinearSolverType::ChebyshevFilter;
             default:
                 return DMNonLinearSolverType::UNDEFINED;
         }
     }
 
+    // dense symmetric eigensolver, as a flag for DistMatrix::setEigensolver
+    char DMDenseEigensolver() const
+    {
+        switch (dm_eigensolver_)
+        {
+            case 1:
+                return 'd';
+            case 2:
+                return 'r';
+            default:
+                return 'q';
+        }
+    }
+
     DMEigensolverType DMEigensolver() const
     {
         switch (dm_algo_)
@@ -690,6 +771,25 @@ public:
         }
     }
 
+    RhoAccumulationType RhoAccumulation() const
+    {
+        switch (rho_accumulation_)
+        {
+            case 0:
+                return RhoAccumulationType::Atomic;
+            case 1:
+                return RhoAccumulationType::Blocked;
+            default:
+                return RhoAccumulationType::UNDEFINED;
+        }
+    }
+
+    bool overlapHaloComm() const { return (overlap_halo_comm_ > 0); }
+
+    bool persistentHaloComm() const { return (persistent_halo_comm_ > 0); }
+
+    bool mixedPrecisionPoisson() const { return (poisson_precision_ == 1); }
+
     OrthoType getOrthoType()
     {
         switch (orbital_type_)
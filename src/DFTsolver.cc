@@ -17,6 +17,7 @@
 #include "Ions.h"
 #include "MGmol.h"
 #include "Potentials.h"
+#include "Profiler.h"
 #include "ProjectedMatricesInterface.h"
 #include "Rho.h"
 
@@ -261,6 +262,8 @@ int DFTsolver<OrbitalsType>::solve(OrbitalsType& orbitals,
     // main electronic structure outer loop
     for (short step = 0; step <= max_steps; step++)
     {
+        ProfilerStep profiler_step("SCF step", step);
+
         bool orthof = false;
         if (ct.orthof)
             orthof = ((((step + 1) % ct.orthof) == ct.max_changes_pot)
@@ -10,6 +10,7 @@
 #ifndef MGMOL_DMSTRATEGYFACTORY_H
 #define MGMOL_DMSTRATEGYFACTORY_H
 
+#include "ChebyshevFilterDMStrategy.h"
 #include "Control.h"
 #include "EigenDMStrategy.h"
 #include "FullyOccupiedNonOrthoDMStrategy.h"
@@ -45,6 +46,14 @@ public:
                 energy, electrostat, mgmol_strategy, proj_matrices, orbitals,
                 ct.short_sighted);
         }
+        else if (ct.DM_solver() == DMNonLinearSolverType::ChebyshevFilter)
+        {
+            if (mmpi.instancePE0())
+                std::cout << "ChebyshevFilterDMStrategy..." << std::endl;
+            dm_strategy
+                = new ChebyshevFilterDMStrategy<OrbitalsType, MatrixType>(ions,
+                    proj_matrices, mgmol_strategy, ct.dm_filter_degree);
+        }
         else
         {
             if (ct.fullyOccupied())
@@ -26,7 +26,8 @@ DensityMatrixSparse::DensityMatrixSparse(
     MGmol_MPI& mmpi     = *(MGmol_MPI::instance());
     orbital_occupation_ = mmpi.nspin() > 1 ? 1. : 2.;
 
-    orbitals_index_ = -1;
+    orbitals_index_     = -1;
+    packed_dm_uptodate_ = false;
 
     if (dim_ > 0)
     {
@@ -48,7 +49,8 @@ void DensityMatrixSparse::setUniform(const double nel, const int orbitals_index)
 {
     const double occ = (double)((double)nel / (double)dim_);
     assert(occ < 1.01);
-    orbitals_index_ = orbitals_index;
+    orbitals_index_     = orbitals_index;
+    packed_dm_uptodate_ = false;
     (*dm_).reset();
     const double uval = (double)occ * orbital_occupation_;
     for (std::vector<int>::const_iterator st = locvars_.begin();
@@ -64,7 +66,8 @@ void DensityMatrixSparse::setto2InvS(
     *dm_ = invS;
     dm_->scale(orbital_occupation_);
 
-    orbitals_index_ = orbitals_index;
+    orbitals_index_     = orbitals_index;
+    packed_dm_uptodate_ = false;
 }
 // build density matrix, given computed locally centered data
 void DensityMatrixSparse::assembleMatrixFromCenteredData(
@@ -92,7 +95,8 @@ void DensityMatrixSparse::assembleMatrixFromCenteredData(
     dtor_DM.updateLocalRows((*dm_));
     gather_DM_tm_.stop();
 
-    orbitals_index_ = orbitals_index;
+    orbitals_index_     = orbitals_index;
+    packed_dm_uptodate_ = false;
 }
 // compute trace of dot product dm_ . vsmat
 double DensityMatrixSparse::getTraceDotProductWithMat(
@@ -101,11 +105,20 @@ double DensityMatrixSparse::getTraceDotProductWithMat(
     assert(dm_ != nullptr);
     //   assert(dm_->n() != 0);
     /* compute trace */
+    // use packed copies of the rows needed (sorted columns),
+    // packing dm_ only once after each update
+    if (!packed_dm_uptodate_)
+    {
+        packed_dm_.assign(*dm_, locfcns_);
+        packed_dm_uptodate_ = true;
+    }
+    const CSRMatrix mat(*vsmat, locfcns_);
+
     double trace = 0.0;
     for (std::vector<int>::iterator itr = locfcns_.begin();
          itr != locfcns_.end(); ++itr)
     {
-        trace += (*dm_).AmultSymBdiag(vsmat, *itr);
+        trace += packed_dm_.AmultSymBdiag(mat, *itr);
     }
 
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
@@ -10,6 +10,7 @@
 #ifndef MGMOL_DENSITYMATRIXSPARSE_H
 #define MGMOL_DENSITYMATRIXSPARSE_H
 
+#include "CSRMatrix.h"
 #include "ClusterOrbitals.h"
 #include "DataDistribution.h"
 #include "LocalizationRegions.h"
@@ -32,6 +33,10 @@ class DensityMatrixSparse
 
     VariableSizeMatrix<sparserow>* dm_;
 
+    // packed copy of locally centered rows of dm_, for traces of products
+    CSRMatrix packed_dm_;
+    bool packed_dm_uptodate_;
+
     int orbitals_index_;
 
     double orbital_occupation_;
@@ -51,8 +56,9 @@ public:
     void setMatrix(
         const VariableSizeMatrix<sparserow>& mat, const int orbitals_index)
     {
-        *dm_            = mat;
-        orbitals_index_ = orbitals_index;
+        *dm_                = mat;
+        orbitals_index_     = orbitals_index;
+        packed_dm_uptodate_ = false;
     }
     void assembleMatrixFromCenteredData(const std::vector<double>& data,
         const std::vector<int>& locRowIds, const int* globalColIds,
@@ -70,7 +76,12 @@ public:
         assert(values.size() == cols.size());
     }
     double getTraceDotProductWithMat(VariableSizeMatrix<sparserow>* vsmat);
-    VariableSizeMatrix<sparserow>* mat() { return dm_; }
+    // dm_ may be modified by caller
+    VariableSizeMatrix<sparserow>* mat()
+    {
+        packed_dm_uptodate_ = false;
+        return dm_;
+    }
     void printDM(std::ostream& os, int nrows = NUM_PRINT_ROWS) const;
     void getLocalMatrix(LocalMatrices<MATDTYPE, memory_space_type>& localX,
         const std::vector<std::vector<int>>& global_indexes);
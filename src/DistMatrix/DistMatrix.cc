@@ -2189,8 +2189,53 @@ void DistMatrix<float>::sygst(int itype, char uplo, const DistMatrix<float>& b)
     }
 }
 ////////////////////////////////////////////////////////////////////////////////
+template <class T>
+void DistMatrix<T>::syev(
+    char jobz, char uplo, std::vector<T>& w, DistMatrix<T>& z)
+{
+    syev_tm_.start();
+
+    switch (eigensolver_)
+    {
+        case 'd':
+            // divide and conquer is only available with eigenvectors
+            if (jobz == 'v' || jobz == 'V')
+                syevd(jobz, uplo, w, z);
+            else
+                syevr(jobz, uplo, m_, w, z);
+            break;
+        case 'r':
+            syevr(jobz, uplo, m_, w, z);
+            break;
+        default:
+            syevQR(jobz, uplo, w, z);
+    }
+
+    syev_tm_.stop();
+}
+
+template <class T>
+int DistMatrix<T>::syev(
+    char jobz, char uplo, const int nev, std::vector<T>& w, DistMatrix<T>& z)
+{
+    assert(nev > 0);
+
+    // only MRRR computes a subset of the spectrum at a reduced cost
+    if (eigensolver_ != 'r' || nev >= m_)
+    {
+        syev(jobz, uplo, w, z);
+        return m_;
+    }
+
+    syev_tm_.start();
+    syevr(jobz, uplo, nev, w, z);
+    syev_tm_.stop();
+
+    return nev;
+}
+
 template <>
-void DistMatrix<double>::syev(
+void DistMatrix<double>::syevQR(
     char jobz, char uplo, std::vector<double>& w, DistMatrix<double>& z)
 {
     int info;
@@ -2228,7 +2273,7 @@ void DistMatrix<double>::syev(
 }
 
 template <>
-void DistMatrix<float>::syev(
+void DistMatrix<float>::syevQR(
     char jobz, char uplo, std::vector<float>& w, DistMatrix<float>& z)
 {
     int info;
@@ -2264,6 +2309,242 @@ void DistMatrix<float>::syev(
     MPI_Bcast(&w[0], m_, MPI_FLOAT, 0, comm_global_);
 #endif
 }
+
+template <>
+void DistMatrix<double>::syevd(
+    char jobz, char uplo, std::vector<double>& w, DistMatrix<double>& z)
+{
+    int info;
+    if (active_)
+    {
+        assert(m_ == n_);
+
+        // workspace query
+        int lwork  = -1;
+        int liwork = -1;
+        double qwork[1];
+        int qiwork[1];
+#ifdef SCALAPACK
+        assert(mb_ > 1);
+        int ione = 1;
+        pdsyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, qwork, &lwork, qiwork, &liwork,
+            &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<double> work(lwork);
+        std::vector<int> iwork(liwork);
+        pdsyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, work.data(), &lwork,
+            iwork.data(), &liwork, &info);
+#else
+        z = *this;
+        dsyevd(&jobz, &uplo, &m_, &z.val_[0], &m_, &w[0], qwork, &lwork,
+            qiwork, &liwork, &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<double> work(lwork);
+        std::vector<int> iwork(liwork);
+        dsyevd(&jobz, &uplo, &m_, &z.val_[0], &m_, &w[0], work.data(), &lwork,
+            iwork.data(), &liwork, &info);
+#endif
+        if (info != 0)
+        {
+            MGMOL_DISTMATRIX_ERROR(
+                "syevd, object " << object_name_ << ", info=" << info);
+        }
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], m_, MPI_DOUBLE, 0, comm_global_);
+#endif
+}
+
+template <>
+void DistMatrix<float>::syevd(
+    char jobz, char uplo, std::vector<float>& w, DistMatrix<float>& z)
+{
+    int info;
+    if (active_)
+    {
+        assert(m_ == n_);
+
+        // workspace query
+        int lwork  = -1;
+        int liwork = -1;
+        float qwork[1];
+        int qiwork[1];
+#ifdef SCALAPACK
+        assert(mb_ > 1);
+        int ione = 1;
+        pssyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, qwork, &lwork, qiwork, &liwork,
+            &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<float> work(lwork);
+        std::vector<int> iwork(liwork);
+        pssyevd(&jobz, &uplo, &m_, &val_[0], &ione, &ione, desc_, &w[0],
+            &z.val_[0], &ione, &ione, z.desc_, work.data(), &lwork,
+            iwork.data(), &liwork, &info);
+#else
+        z = *this;
+        ssyevd(&jobz, &uplo, &m_, &z.val_[0], &m_, &w[0], qwork, &lwork,
+            qiwork, &liwork, &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<float> work(lwork);
+        std::vector<int> iwork(liwork);
+        ssyevd(&jobz, &uplo, &m_, &z.val_[0], &m_, &w[0], work.data(), &lwork,
+            iwork.data(), &liwork, &info);
+#endif
+        if (info != 0)
+        {
+            MGMOL_DISTMATRIX_ERROR(
+                "syevd, object " << object_name_ << ", info=" << info);
+        }
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], m_, MPI_FLOAT, 0, comm_global_);
+#endif
+}
+
+template <>
+void DistMatrix<double>::syevr(char jobz, char uplo, const int nev,
+    std::vector<double>& w, DistMatrix<double>& z)
+{
+    assert(nev > 0);
+    assert(nev <= m_);
+
+    int info;
+    if (active_)
+    {
+        assert(m_ == n_);
+
+        // eigenpairs il to iu (Fortran indexes)
+        char range = (nev < m_) ? 'i' : 'a';
+        int il     = 1;
+        int iu     = nev;
+        double vl  = 0.;
+        double vu  = 0.;
+        int neig   = 0;
+
+        // workspace query
+        int lwork  = -1;
+        int liwork = -1;
+        double qwork[1];
+        int qiwork[1];
+#ifdef SCALAPACK
+        assert(mb_ > 1);
+        int ione = 1;
+        int nz   = 0;
+        pdsyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_, &vl,
+            &vu, &il, &iu, &neig, &nz, &w[0], &z.val_[0], &ione, &ione,
+            z.desc_, qwork, &lwork, qiwork, &liwork, &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<double> work(lwork);
+        std::vector<int> iwork(liwork);
+        pdsyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_, &vl,
+            &vu, &il, &iu, &neig, &nz, &w[0], &z.val_[0], &ione, &ione,
+            z.desc_, work.data(), &lwork, iwork.data(), &liwork, &info);
+#else
+        // dsyevr destroys its input matrix, so work on a copy of *this
+        std::vector<double> a(val_);
+        std::vector<int> isuppz(2 * m_);
+        double abstol = 0.;
+        dsyevr(&jobz, &range, &uplo, &m_, a.data(), &m_, &vl, &vu, &il, &iu,
+            &abstol, &neig, &w[0], &z.val_[0], &m_, isuppz.data(), qwork,
+            &lwork, qiwork, &liwork, &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<double> work(lwork);
+        std::vector<int> iwork(liwork);
+        dsyevr(&jobz, &range, &uplo, &m_, a.data(), &m_, &vl, &vu, &il, &iu,
+            &abstol, &neig, &w[0], &z.val_[0], &m_, isuppz.data(), work.data(),
+            &lwork, iwork.data(), &liwork, &info);
+#endif
+        if (info != 0 || neig != nev)
+        {
+            MGMOL_DISTMATRIX_ERROR("syevr, object " << object_name_
+                                                    << ", info=" << info
+                                                    << ", m=" << neig);
+        }
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], nev, MPI_DOUBLE, 0, comm_global_);
+#endif
+}
+
+template <>
+void DistMatrix<float>::syevr(char jobz, char uplo, const int nev,
+    std::vector<float>& w, DistMatrix<float>& z)
+{
+    assert(nev > 0);
+    assert(nev <= m_);
+
+    int info;
+    if (active_)
+    {
+        assert(m_ == n_);
+
+        // eigenpairs il to iu (Fortran indexes)
+        char range = (nev < m_) ? 'i' : 'a';
+        int il     = 1;
+        int iu     = nev;
+        float vl   = 0.;
+        float vu   = 0.;
+        int neig   = 0;
+
+        // workspace query
+        int lwork  = -1;
+        int liwork = -1;
+        float qwork[1];
+        int qiwork[1];
+#ifdef SCALAPACK
+        assert(mb_ > 1);
+        int ione = 1;
+        int nz   = 0;
+        pssyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_, &vl,
+            &vu, &il, &iu, &neig, &nz, &w[0], &z.val_[0], &ione, &ione,
+            z.desc_, qwork, &lwork, qiwork, &liwork, &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<float> work(lwork);
+        std::vector<int> iwork(liwork);
+        pssyevr(&jobz, &range, &uplo, &m_, &val_[0], &ione, &ione, desc_, &vl,
+            &vu, &il, &iu, &neig, &nz, &w[0], &z.val_[0], &ione, &ione,
+            z.desc_, work.data(), &lwork, iwork.data(), &liwork, &info);
+#else
+        // ssyevr destroys its input matrix, so work on a copy of *this
+        std::vector<float> a(val_);
+        std::vector<int> isuppz(2 * m_);
+        float abstol = 0.;
+        ssyevr(&jobz, &range, &uplo, &m_, a.data(), &m_, &vl, &vu, &il, &iu,
+            &abstol, &neig, &w[0], &z.val_[0], &m_, isuppz.data(), qwork,
+            &lwork, qiwork, &liwork, &info);
+        lwork  = (int)qwork[0];
+        liwork = qiwork[0];
+        std::vector<float> work(lwork);
+        std::vector<int> iwork(liwork);
+        ssyevr(&jobz, &range, &uplo, &m_, a.data(), &m_, &vl, &vu, &il, &iu,
+            &abstol, &neig, &w[0], &z.val_[0], &m_, isuppz.data(), work.data(),
+            &lwork, iwork.data(), &liwork, &info);
+#endif
+        if (info != 0 || neig != nev)
+        {
+            MGMOL_DISTMATRIX_ERROR("syevr, object " << object_name_
+                                                    << ", info=" << info
+                                                    << ", m=" << neig);
+        }
+    }
+
+#ifdef SCALAPACK
+    MPI_Bcast(&w[0], nev, MPI_FLOAT, 0, comm_global_);
+#endif
+}
 ////////////////////////////////////////////////////////////////////////////////
 template <>
 void DistMatrix<double>::gesvd(char jobu, char jobvt, std::vector<double>& s,
@@ -51,10 +51,15 @@ private:
     static Timer potri_tm_;
     static Timer potrf_tm_;
     static Timer trtri_tm_;
+    static Timer syev_tm_;
 
     static int distmatrix_def_block_size_;
     static BlacsContext* default_bc_;
 
+    // algorithm used by syev: 'q' (QR), 'd' (divide and conquer),
+    // 'r' (MRRR)
+    static char eigensolver_;
+
     std::string object_name_;
 
     const BlacsContext& bc_;
@@ -75,6 +80,13 @@ private:
 
     void setDiagonalValues(const T* const dmat);
 
+    // symmetric eigensolvers behind syev(); all of them overwrite *this
+    void syevQR(char jobz, char uplo, std::vector<T>& w, DistMatrix<T>& z);
+    void syevd(char jobz, char uplo, std::vector<T>& w, DistMatrix<T>& z);
+    // compute the nev lowest eigenpairs
+    void syevr(char jobz, char uplo, const int nev, std::vector<T>& w,
+        DistMatrix<T>& z);
+
     double dot(const DistMatrix<T>& a) const;
 
 protected:
@@ -92,6 +104,13 @@ public:
 
     static void setDefaultBlacsContext(BlacsContext* bc) { default_bc_ = bc; }
 
+    static void setEigensolver(const char algo)
+    {
+        assert(algo == 'q' || algo == 'd' || algo == 'r');
+        eigensolver_ = algo;
+    }
+    static char getEigensolver() { return eigensolver_; }
+
     static void printTimers(std::ostream& os)
     {
         allgather_tm_.print(os);
@@ -99,6 +118,7 @@ public:
         potri_tm_.print(os);
         trtri_tm_.print(os);
         potrf_tm_.print(os);
+        syev_tm_.print(os);
     }
 
     int nprow() const { return nprow_; }
@@ -339,6 +359,9 @@ public:
     double pocon(char, T);
     void sygst(int, char, const DistMatrix<T>&);
     void syev(char, char, std::vector<T>&, DistMatrix<T>&);
+    // compute (at least) the nev lowest eigenpairs
+    // return the number of eigenpairs computed
+    int syev(char, char, const int nev, std::vector<T>&, DistMatrix<T>&);
     void sygv(char, char, const char, DistMatrix<T>&, std::vector<T>&,
         DistMatrix<T>&);
     void gesvd(char jobu, char jobvt, std::vector<T>& s, DistMatrix<T>& u,
@@ -425,6 +448,9 @@ int DistMatrix<T>::distmatrix_def_block_size_ = 32;
 template <class T>
 BlacsContext* DistMatrix<T>::default_bc_ = nullptr;
 
+template <class T>
+char DistMatrix<T>::eigensolver_ = 'q';
+
 template <class T>
 Timer DistMatrix<T>::allgather_tm_("DistMatrix::matgather");
 
@@ -438,6 +464,8 @@ template <class T>
 Timer DistMatrix<T>::potrf_tm_("DistMatrix::potrf");
 template <class T>
 Timer DistMatrix<T>::trtri_tm_("DistMatrix::trtri");
+template <class T>
+Timer DistMatrix<T>::syev_tm_("DistMatrix::syev");
 
 } // namespace
 
@@ -115,6 +115,16 @@ extern "C"
         int*, int*, int*, double*, int*, int*);
     void pssyev(Pchar, Pchar, int*, float*, int*, int*, int*, float*, float*,
         int*, int*, int*, float*, int*, int*);
+    void pdsyevd(Pchar, Pchar, int*, double*, int*, int*, int*, double*,
+        double*, int*, int*, int*, double*, int*, int*, int*, int*);
+    void pssyevd(Pchar, Pchar, int*, float*, int*, int*, int*, float*, float*,
+        int*, int*, int*, float*, int*, int*, int*, int*);
+    void pdsyevr(Pchar, Pchar, Pchar, int*, double*, int*, int*, int*, double*,
+        double*, int*, int*, int*, int*, double*, double*, int*, int*, int*,
+        double*, int*, int*, int*, int*);
+    void pssyevr(Pchar, Pchar, Pchar, int*, float*, int*, int*, int*, float*,
+        float*, int*, int*, int*, int*, float*, float*, int*, int*, int*,
+        float*, int*, int*, int*, int*);
     void pdgesvd(Pchar, Pchar, int*, int*, double*, int*, int*, int*, double*,
         double*, int*, int*, int*, double*, int*, int*, int*, double*, int*,
         int*);
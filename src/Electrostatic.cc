@@ -24,6 +24,8 @@
 #include "ShiftedHartree.h"
 #include "mputils.h"
 
+#include <algorithm>
+
 Timer Electrostatic::solve_tm_("Electrostatic::solve");
 
 Electrostatic::Electrostatic(PoissonFDtype lap_type, const short bcPoisson[3],
@@ -54,6 +56,8 @@ Electrostatic::Electrostatic(PoissonFDtype lap_type, const short bcPoisson[3],
     Evhold_rho_      = NAN;
     eepsilon_        = 0.;
     iterative_index_ = -1;
+    max_sweeps_      = 0;
+    vh_minus1_       = nullptr;
 }
 
 Electrostatic::~Electrostatic()
@@ -63,6 +67,7 @@ Electrostatic::~Electrostatic()
     delete poisson_solver_;
     if (grhod_ != nullptr) delete grhod_;
     if (grhoc_ != nullptr) delete grhoc_;
+    clearOldVh();
 }
 
 void Electrostatic::setupInitialVh(const POTDTYPE* const vh_init)
@@ -251,12 +256,46 @@ const pb::GridFunc<POTDTYPE>& Electrostatic::getVh() const
 }
 
 void Electrostatic::setup(const short max_sweeps)
+{
+    max_sweeps_ = max_sweeps;
+    setupSolver(1.e-16);
+}
+
+void Electrostatic::setupSolver(const double tol)
 {
     Control& ct           = *(Control::instance());
     const short nu1       = ct.poisson_pc_nu1;
     const short nu2       = ct.poisson_pc_nu1;
     const short max_nlevs = ct.poisson_pc_nlev;
-    poisson_solver_->setup(nu1, nu2, max_sweeps, 1.e-16, max_nlevs);
+    poisson_solver_->setup(nu1, nu2, max_sweeps_, tol, max_nlevs);
+}
+
+void Electrostatic::extrapolateVh()
+{
+    const pb::GridFunc<POTDTYPE>& vh = poisson_solver_->vh();
+
+    if (vh_minus1_ == nullptr)
+    {
+        vh_minus1_ = new pb::GridFunc<POTDTYPE>(vh);
+        return;
+    }
+
+    // vh(t+dt) ~ 2*vh(t)-vh(t-dt)
+    pb::GridFunc<POTDTYPE> extrapolated(vh);
+    extrapolated.scal(2.);
+    extrapolated -= *vh_minus1_;
+
+    *vh_minus1_ = vh;
+    poisson_solver_->set_vh(extrapolated);
+}
+
+void Electrostatic::clearOldVh()
+{
+    if (vh_minus1_ != nullptr)
+    {
+        delete vh_minus1_;
+        vh_minus1_ = nullptr;
+    }
 }
 
 template <class T>
@@ -294,6 +333,19 @@ void Electrostatic::computeVh(const Ions& ions, Rho<T>& rho, Potentials& pot)
     else
         work = &vrho[0][0];
 
+    // Solve only as accurately as needed given the current SCF error:
+    // relative residual tolerance proportional to dvrho per atom,
+    // still limited to max_sweeps_ sweeps
+    Control& ct            = *(Control::instance());
+    const float tol_factor = ct.VHadaptiveTolFactor();
+    if (tol_factor > 0. && max_sweeps_ > 0)
+    {
+        const double max_tol = 1.e-2;
+        const double tol     = std::min(max_tol,
+            tol_factor * pot.scf_dvrho() / (double)ions.getNumIons());
+        setupSolver(tol);
+    }
+
     const pb::Grid& grid = diel_flag_ ? *pbGrid_ : mymesh->grid();
     pb::GridFunc<RHODTYPE> grho(grid, bc_[0], bc_[1], bc_[2]);
     grho.assign(work);
@@ -39,8 +39,16 @@ class Electrostatic
 
     int iterative_index_;
 
+    // max. number of multigrid sweeps per solve, as set in setup()
+    short max_sweeps_;
+
+    // Hartree potential at previous MD step, used for extrapolation
+    pb::GridFunc<POTDTYPE>* vh_minus1_;
+
     static Timer solve_tm_;
 
+    void setupSolver(const double tol);
+
 public:
     Electrostatic(PoissonFDtype lap_type, const short bc[3],
         const double screening_const = 0.);
@@ -64,6 +72,11 @@ public:
     void computeVhRho(Rho<T>& rho);
     void resetSolution() { poisson_solver_->resetVh(); }
 
+    // set initial guess for next solve to 2*vh(t)-vh(t-dt),
+    // or keep vh(t) if vh(t-dt) is not available
+    void extrapolateVh();
+    void clearOldVh();
+
     const pb::GridFunc<POTDTYPE>& getVh() const;
 
     double evhRho() const { return Evh_rho_; }
@@ -62,7 +62,17 @@ void Forces<T>::evaluateShiftedFields(Ion& ion,
     const RadialInter& lpot = ion.getLocalPot();
 
     auto lambda_radiallpot = [&lpot](double r) { return lpot.cubint(r); };
-    auto lambda_rhocomp    = [&sp](double r) { return sp.getRhoComp(r); };
+
+    // batched versions, for n radii at once
+    auto batch_radiallpot
+        = [&lpot](const int n, const double* const r, double* const val) {
+              lpot.cubint(n, r, val);
+          };
+    auto batch_rhocomp
+        = [&sp](const int n, const double* const r, double* const val) {
+              for (int i = 0; i < n; i++)
+                  val[i] = sp.getRhoComp(r[i]);
+          };
 
     Vector3D ref_position(ion.position(0), ion.position(1), ion.position(2));
 
@@ -90,11 +100,11 @@ void Forces<T>::evaluateShiftedFields(Ion& ion,
     }
     else
     {
-        evaluateRadialFunc(positions, lrad, var_pot, lambda_radiallpot);
+        evaluateRadialFunc(positions, lrad, var_pot, batch_radiallpot);
     }
     // evaluate Gaussian compensating charge on mesh
     // for shifted atomic poistions
-    evaluateRadialFunc(positions, lrad, var_charge, lambda_rhocomp);
+    evaluateRadialFunc(positions, lrad, var_charge, batch_rhocomp);
 
     evaluateShiftedFields_tm_.stop();
 }
@@ -196,7 +206,8 @@ void Forces<T>::evaluateSupersampledRadialFunc(
 template <class T>
 void Forces<T>::evaluateRadialFunc(const std::vector<Vector3D>& positions,
     const double lrad, std::vector<std::array<double, 3 * NPTS>>& var,
-    std::function<double(double)> const& lambda_radial)
+    std::function<void(const int, const double* const, double* const)> const&
+        batch_radial)
 {
     Control& ct = *(Control::instance());
 
@@ -217,6 +228,14 @@ void Forces<T>::evaluateRadialFunc(const std::vector<Vector3D>& positions,
 
     Vector3D point(0., 0., 0.);
 
+    // radii within lrad and function values, for all the shifted positions
+    // and all the points of a line of mesh along z,
+    // and index of each of these radii in the line
+    const int nline = dim2 * 3 * NPTS;
+    std::vector<double> radii(nline);
+    std::vector<double> vals(nline);
+    std::vector<int> indexes(nline);
+
     point[0] = mygrid.start(0);
 
     for (int ix = 0; ix < dim0; ix++)
@@ -226,31 +245,43 @@ void Forces<T>::evaluateRadialFunc(const std::vector<Vector3D>& positions,
         for (int iy = 0; iy < dim1; iy++)
         {
             point[2] = mygrid.start(2);
+
+            int index = 0;
+            int nin   = 0;
             for (int iz = 0; iz < dim2; iz++)
             {
-                short ishift = 0;
-                std::array<double, 3 * NPTS>& varpoint(var[offset]);
-
                 for (auto& position : positions)
                 {
                     const double r = position.minimage(point, ll, ct.bcPoisson);
                     if (r < lrad)
                     {
-                        varpoint[ishift] = lambda_radial(r);
-                    }
-                    else
-                    {
-                        varpoint[ishift] = 0.;
+                        radii[nin]   = r;
+                        indexes[nin] = index;
+                        nin++;
                     }
-                    ishift++;
+                    index++;
                 }
 
-                offset++;
-
                 point[2] += h2;
 
             } // end for iz
 
+            // interpolate radial function for all the radii within lrad
+            // in the line at once
+            if (nin > 0) batch_radial(nin, radii.data(), vals.data());
+
+            std::array<double, 3 * NPTS>* varline = &var[offset];
+            for (int iz = 0; iz < dim2; iz++)
+                varline[iz].fill(0.);
+            for (int i = 0; i < nin; i++)
+            {
+                const int iz        = indexes[i] / (3 * NPTS);
+                const int ishift    = indexes[i] % (3 * NPTS);
+                varline[iz][ishift] = vals[i];
+            }
+
+            offset += dim2;
+
             point[1] += h1;
 
         } // end for iy
@@ -58,7 +58,8 @@ private:
         std::function<double(double)> const&);
     void evaluateRadialFunc(const std::vector<Vector3D>& positions,
         const double lrad, std::vector<std::array<double, 3 * NPTS>>& var,
-        std::function<double(double)> const&);
+        std::function<void(const int, const double* const, double* const)>
+            const&);
     SquareLocalMatrices<double, MemorySpace::Host> getReplicatedDM();
 
 public:
@@ -8,6 +8,7 @@
 // Please also read this link https://github.com/llnl/mgmol/LICENSE
 
 #include "HDFrestart.h"
+#include "AsyncFileWriter.h"
 #include "Control.h"
 #include "LocalizationRegions.h"
 #include "MGmol_MPI.h"
@@ -74,6 +75,24 @@ HDFrestart::~HDFrestart()
     if (comm_active_ != MPI_COMM_NULL) MPI_Comm_free(&comm_active_);
 }
 
+// copy image of in-memory file into buffer
+herr_t HDFrestart::getFileImage(std::vector<char>& image) const
+{
+    assert(file_id_ >= 0);
+
+    herr_t err = H5Fflush(file_id_, H5F_SCOPE_LOCAL);
+    if (err < 0) return err;
+
+    ssize_t size = H5Fget_file_image(file_id_, nullptr, 0);
+    if (size < 0) return -1;
+
+    image.resize(size);
+    size = H5Fget_file_image(file_id_, image.data(), image.size());
+    if (size < 0) return -1;
+
+    return 0;
+}
+
 int HDFrestart::close()
 {
     if (closed_) return 0;
@@ -99,7 +118,19 @@ int HDFrestart::close()
     if (active_)
     {
         assert(file_id_ >= 0);
-        err = H5Fclose(file_id_);
+        if (writer_ != nullptr) err = getFileImage(writer_->stagingBuffer());
+
+        herr_t err_close = H5Fclose(file_id_);
+        if (err_close < 0) err = err_close;
+
+        if (writer_ != nullptr && err >= 0)
+        {
+            // start writing file to disk (after previous file is done)
+            if (writer_->submit(filename_) < 0)
+                (*MPIdata::serr) << "HDFrestart::close() --- asynchronous "
+                                    "write of previous file failed"
+                                 << std::endl;
+        }
     }
     else
     {
@@ -247,6 +278,8 @@ void HDFrestart::setupBlocks()
 #ifdef MGMOL_USE_HDF5P
     if (use_hdf5p_)
     {
+        // each task accesses its own block if data is not gathered in x
+        if (!gather_data_x_) offset_[0] = pes_.my_mpi(0) * block_[0];
         offset_[1] = pes_.my_mpi(1) * block_[1];
         offset_[2] = pes_.my_mpi(2) * block_[2];
     }
@@ -367,9 +400,10 @@ float HDFrestart::getMDTimeFromFile() const
 
 int HDFrestart::getMDstepFromFile() const { return getFromFile("MD_step"); }
 
-int HDFrestart::getFromFile(const std::string& attname) const
+int HDFrestart::getFromFile(
+    const std::string& attname, const int default_value) const
 {
-    int data                  = 1;
+    int data                  = default_value;
     std::string function_name = "HDFrestart::getFromFile()";
     if (onpe0)
     {
@@ -445,8 +479,9 @@ void HDFrestart::addReleaseNumber2File(const char* release)
 
 // constructor for one layer of PEs writing data
 HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
-    const unsigned gdim[3], const short option_number)
-    : pes_(pes), filename_(filename)
+    const unsigned gdim[3], const short option_number,
+    AsyncFileWriter* writer)
+    : pes_(pes), filename_(filename), writer_(writer)
 {
     MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
     comm_data_ = mmpi.commSameSpin();
@@ -454,6 +489,11 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
     create_file_tm_.start();
 
     setOptions(option_number);
+#ifdef MGMOL_USE_HDF5P
+    // parallel HDF5 writes directly into a shared file
+    if (use_hdf5p_) writer_ = nullptr;
+#endif
+    setCompression();
     verbosity_ = 0;
     closed_    = false;
 
@@ -518,8 +558,9 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
         if (use_hdf5p_)
         {
             // Set up file access property list with parallel I/O access
-            herr_t err_id
-                = H5Pset_fapl_mpio(access_plist, comm_active_, MPI_INFO_NULL);
+            MPI_Info info = createMPIIOhints();
+            herr_t err_id = H5Pset_fapl_mpio(access_plist, comm_active_, info);
+            MPI_Info_free(&info);
             if (err_id < 0)
             {
                 MGMOL_HDFRESTART_FAIL("H5Pset_fapl_mpio failed!!!");
@@ -532,8 +573,9 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
             // in memory, speeding reads and writes as no disk access is made.
             // File contents are stored only in memory until the file is closed.
             // The last parameter determines whether file contents are ever
-            // written to disk.
-            herr_t err_id = H5Pset_fapl_core(access_plist, 1024, 1);
+            // written to disk (done by writer_ otherwise).
+            herr_t err_id
+                = H5Pset_fapl_core(access_plist, 1024, writer_ == nullptr);
             if (err_id < 0) MGMOL_HDFRESTART_FAIL("H5Pset_fapl_core failed!!!");
         }
         /* create the file collectively */
@@ -567,6 +609,11 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
     LOG(GITHASH);
 #endif
 
+    // processor grid used to write data
+    add2File(pes_.n_mpi_task(0), "MPI_tasks_x");
+    add2File(pes_.n_mpi_task(1), "MPI_tasks_y");
+    add2File(pes_.n_mpi_task(2), "MPI_tasks_z");
+
     if (onpe0 && ct.verbose > 0)
         (*MPIdata::sout) << "Created HDF file with Data blocks: " << block_[0]
                          << " x " << block_[1] << " x " << block_[2]
@@ -578,7 +625,7 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
 // constructor reading data (existing file)
 HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
     const short option_number)
-    : pes_(pes), file_id_(-1)
+    : pes_(pes), file_id_(-1), writer_(nullptr)
 {
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
     comm_data_      = mmpi.commSameSpin();
@@ -587,7 +634,10 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
     Control& ct = *(Control::instance());
 
     setOptions(option_number);
-    filename_ = filename;
+    // filters are detected automatically by HDF5 when reading
+    compression_       = 0;
+    compression_level_ = 0;
+    filename_          = filename;
 #ifdef MGMOL_USE_HDF5P
     if (!use_hdf5p_)
 #endif
@@ -633,8 +683,9 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
         if (use_hdf5p_)
         {
             // Set up file access property list with parallel I/O access
-            herr_t err_id
-                = H5Pset_fapl_mpio(access_plist, comm_active_, MPI_INFO_NULL);
+            MPI_Info info = createMPIIOhints();
+            herr_t err_id = H5Pset_fapl_mpio(access_plist, comm_active_, info);
+            MPI_Info_free(&info);
             if (err_id < 0)
             {
                 MGMOL_HDFRESTART_FAIL("H5Pset_fapl_mpio failed!!!");
@@ -689,8 +740,8 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
             {
                 dimsf_[1] *= pes.n_mpi_task(1);
                 dimsf_[2] *= pes.n_mpi_task(2);
+                if (!gather_data_x_) dimsf_[0] *= pes.n_mpi_task(0);
             }
-            if (!gather_data_x_) dimsf_[0] *= pes.n_mpi_task(0);
 
             // close dataset
             status = H5Dclose(dset_id);
@@ -711,6 +762,11 @@ HDFrestart::HDFrestart(const std::string& filename, const pb::PEenv& pes,
 
     setupBlocks();
 
+#ifdef MGMOL_USE_HDF5P
+    if (!use_hdf5p_)
+#endif
+        checkProcessorGrid();
+
     setupWorkSpace();
 
     if (onpe0 && ct.verbose > 0)
@@ -1350,7 +1406,7 @@ int HDFrestart::read_1func_hdf5(T* vv, const std::string& datasetname)
             // Create property list for collective dataset read.
             if (pes_.n_mpi_tasks() > 1)
             {
-                plist_id = H5Pcreate(H5P_DATASET_XFER);
+                plist_id = createXferPlist();
             }
             else
             {
@@ -1559,7 +1615,7 @@ int HDFrestart::readData(
             // Create property list for collective dataset read.
             if (pes_.n_mpi_tasks() > 1)
             {
-                plist_id = H5Pcreate(H5P_DATASET_XFER);
+                plist_id = createXferPlist();
             }
         }
 #endif
@@ -1734,7 +1790,7 @@ int HDFrestart::writeData(T* data, hid_t space_id, hid_t memspace,
             // Create property list for collective dataset write.
             if (pes_.n_mpi_tasks() > 1)
             {
-                plist_id = H5Pcreate(H5P_DATASET_XFER);
+                plist_id = createXferPlist();
             }
         }
 #endif
@@ -1814,9 +1870,131 @@ void HDFrestart::setCommActive()
     else
     {
         comm_active_ = MPI_COMM_NULL;
+#ifdef MGMOL_USE_HDF5P
+        // all tasks access shared file
+        if (use_hdf5p_) MPI_Comm_dup(mmpi.commSameSpin(), &comm_active_);
+#endif
+    }
+}
+
+// Distributed files can only be read with the processor grid used to
+// write them, except in x for files holding full x lines
+// (files written by older versions are not checked)
+void HDFrestart::checkProcessorGrid() const
+{
+    const int nx = getFromFile("MPI_tasks_x", -1);
+    const int ny = getFromFile("MPI_tasks_y", -1);
+    const int nz = getFromFile("MPI_tasks_z", -1);
+    if (nx < 0 || ny < 0 || nz < 0) return;
+
+    if ((!gather_data_x_ && nx != pes_.n_mpi_task(0))
+        || ny != pes_.n_mpi_task(1) || nz != pes_.n_mpi_task(2))
+    {
+        MGMOL_HDFRESTART_FAIL("restart files " << filename_
+                              << " written with processor grid " << nx
+                              << " x " << ny << " x " << nz
+                              << ". Use a single_file restart to restart "
+                                 "on a different processor grid");
+        MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+        mmpi.abort();
+    }
+}
+
+void HDFrestart::setCompression()
+{
+    Control& ct = *(Control::instance());
+
+    compression_       = ct.out_restart_compression;
+    compression_level_ = ct.out_restart_compression_level;
+
+    if (compression_ > 0 && !H5Zfilter_avail(H5Z_FILTER_DEFLATE))
+    {
+        if (onpe0)
+            (*MPIdata::sout) << "HDFrestart: deflate filter not available, "
+                                "restart data will not be compressed"
+                             << std::endl;
+        compression_ = 0;
     }
+#ifdef MGMOL_USE_HDF5P
+#if !H5_VERSION_GE(1, 10, 2)
+    // parallel writes of filtered datasets not supported
+    if (use_hdf5p_ && compression_ > 0)
+    {
+        if (onpe0)
+            (*MPIdata::sout) << "HDFrestart: compression requires HDF5 "
+                                "1.10.2 or later for parallel writes"
+                             << std::endl;
+        compression_ = 0;
+    }
+#endif
+#endif
+}
+
+hid_t HDFrestart::createPlist()
+{
+    hid_t plist_id = H5P_DEFAULT;
+    if (!active_) return plist_id;
+
+    // filters require a chunked layout
+    bool chunked = (compression_ > 0);
+#ifdef MGMOL_USE_HDF5P
+    if (use_hdf5p_) chunked = true;
+#endif
+    if (chunked)
+    {
+        // Create chunked dataset.
+        // Each task writes exactly one chunk, so that (de)compression is
+        // done independently by each task without any read-modify-write
+        plist_id = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(plist_id, 3, block_);
+
+        // shuffle bytes of floating point values to group exponents and
+        // improve compression ratio
+        if (compression_ == 2) H5Pset_shuffle(plist_id);
+        if (compression_ > 0) H5Pset_deflate(plist_id, compression_level_);
+    }
+
+    return plist_id;
 }
 
+void HDFrestart::releasePlist(hid_t plist_id)
+{
+    if (plist_id != H5P_DEFAULT) H5Pclose(plist_id);
+}
+
+// dataset transfer property list for parallel HDF5 reads/writes
+hid_t HDFrestart::createXferPlist() const
+{
+    hid_t plist_id = H5Pcreate(H5P_DATASET_XFER);
+#ifdef MGMOL_USE_HDF5P
+    // collective I/O lets MPI-IO aggregate data from many tasks into
+    // large contiguous requests (required for filtered datasets)
+    if (use_hdf5p_) H5Pset_dxpl_mpio(plist_id, H5FD_MPIO_COLLECTIVE);
+#endif
+    return plist_id;
+}
+
+#ifdef MGMOL_USE_HDF5P
+// MPI-IO hints enabling collective buffering
+// (caller responsible for freeing MPI_Info object)
+MPI_Info HDFrestart::createMPIIOhints() const
+{
+    Control& ct = *(Control::instance());
+
+    MPI_Info info;
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "romio_cb_write", "enable");
+    MPI_Info_set(info, "romio_cb_read", "enable");
+    if (ct.out_restart_cb_nodes > 0)
+    {
+        std::string cb_nodes(std::to_string(ct.out_restart_cb_nodes));
+        MPI_Info_set(info, "cb_nodes", &cb_nodes[0]);
+    }
+
+    return info;
+}
+#endif
+
 void HDFrestart::setOptions(const short option_number)
 {
     switch (option_number)
@@ -1839,6 +2017,12 @@ void HDFrestart::setOptions(const short option_number)
 #endif
             gather_data_x_ = true;
             break;
+#ifdef MGMOL_USE_HDF5P
+        case 3: // 1 file for all tasks, each task reads its own block
+            use_hdf5p_     = true;
+            gather_data_x_ = false;
+            break;
+#endif
         default:
             MGMOL_HDFRESTART_FAIL(
                 "setOptions() --- type " << option_number << " undefined!!!");
@@ -26,6 +26,7 @@
 #include <string>
 #include <vector>
 
+class AsyncFileWriter;
 class LocalizationRegions;
 
 herr_t H5LTfind_dataset(hid_t file_id_, const char* datasetname);
@@ -68,6 +69,11 @@ class HDFrestart
 #endif
     bool gather_data_x_;
 
+    // HDF5 filters applied to mesh functions datasets
+    // (0: none, 1: deflate, 2: shuffle+deflate)
+    short compression_;
+    short compression_level_;
+
     short verbosity_;
 
     bool closed_;
@@ -78,11 +84,22 @@ class HDFrestart
     // MPI communicator for all tasks having data to write
     MPI_Comm comm_data_;
 
+    // if not null, file is built in memory and written to disk
+    // asynchronously by writer_ when closed
+    AsyncFileWriter* writer_;
+
     void appendTaskNumberToFilename();
     void setActivity();
     void setupBlocks();
     void setOptions(const short option_number);
     void addReleaseNumber2File(const char* release);
+    herr_t getFileImage(std::vector<char>& image) const;
+    void setCompression();
+    void checkProcessorGrid() const;
+    hid_t createXferPlist() const;
+#ifdef MGMOL_USE_HDF5P
+    MPI_Info createMPIIOhints() const;
+#endif
 
     template <class T>
     void gatherDataXdir(std::vector<T>& data);
@@ -112,7 +129,8 @@ public:
     HDFrestart(const std::string& filename, const pb::PEenv& pes,
         const short option_number);
     HDFrestart(const std::string& filename, const pb::PEenv& pes,
-        const unsigned gdim[3], const short option_number);
+        const unsigned gdim[3], const short option_number,
+        AsyncFileWriter* writer = nullptr);
 
     bool gatherDataX() const { return gather_data_x_; }
 #ifdef MGMOL_USE_HDF5P
@@ -278,29 +296,14 @@ public:
 
     float getMDTimeFromFile() const;
     int getMDstepFromFile() const;
-    int getFromFile(const std::string& attname) const;
-
-    hid_t createPlist()
-    {
-        hid_t plist_id = H5P_DEFAULT;
-#ifdef MGMOL_USE_HDF5P
-        if (use_hdf5p_ && active_)
-        {
-            // Create chunked dataset.
-            plist_id = H5Pcreate(H5P_DATASET_CREATE);
-            H5Pset_chunk(plist_id, 3, block_);
-        }
-#endif
-
-        return plist_id;
-    }
-
-    void releasePlist(hid_t plist_id)
-    {
-#ifdef MGMOL_USE_HDF5P
-        if (use_hdf5p_ && active_) H5Pclose(plist_id);
-#endif
-    }
+    int getFromFile(
+        const std::string& attname, const int default_value = 1) const;
+
+    // dataset creation property list for mesh functions:
+    // chunks aligned with data blocks of each task, with optional
+    // lossless compression
+    hid_t createPlist();
+    void releasePlist(hid_t plist_id);
 
     static void printTimers(std::ostream& os);
 };
@@ -16,6 +16,10 @@
 #include "ProjectedMatrices.h"
 #include "ReplicatedMatrix.h"
 
+#include <memory>
+#include <type_traits>
+#include <vector>
+
 template <class T>
 Hamiltonian<T>::Hamiltonian()
 {
@@ -82,6 +86,15 @@ const T& Hamiltonian<T>::applyLocal(T& phi, const bool force)
     return *hlphi_;
 }
 
+template <class T>
+void Hamiltonian<T>::applyLocal(T& phi, T& hphi)
+{
+    assert(phi.getIterativeIndex() >= 0);
+    assert(pot_->getIterativeIndex() >= 0);
+
+    applyLocal(phi.chromatic_number(), phi, hphi);
+}
+
 template <class T>
 void Hamiltonian<T>::applyLocal(const int ncolors, T& phi, T& hphi)
 {
@@ -98,61 +111,104 @@ void Hamiltonian<T>::applyLocal(const int ncolors, T& phi, T& hphi)
 
     const POTDTYPE* const vtot = pot_->vtot();
 
-    phi.setDataWithGhosts();
-    phi.trade_boundaries();
-
     using memory_space_type = typename T::memory_space_type;
 
-    if (ct.Mehrstellen())
+    // device copies go through a single MAGMA queue:
+    // only thread the host case
+    const bool threaded
+        = std::is_same<memory_space_type, MemorySpace::Host>::value;
+
+    pb::GridFuncVector<ORBDTYPE, memory_space_type>* gfv_phi
+        = phi.getPtDataWGhosts();
+
+    // optionally apply stencil on interior points while ghost values
+    // are being exchanged (host only)
+    phi.setDataWithGhosts();
+    const bool overlap_comm = ct.overlapHaloComm() && threaded
+                              && !gfv_phi->updated_boundaries();
+    if (overlap_comm)
     {
-        pb::GridFunc<POTDTYPE> gfpot(
-            mygrid, ct.bcWF[0], ct.bcWF[1], ct.bcWF[2]);
-        gfpot.assign(vtot);
-        gfpot.trade_boundaries();
-        const std::vector<std::vector<int>>& gid(phi.getOverlappingGids());
-        pb::GridFuncVector<ORBDTYPE, memory_space_type> gfvw1(
-            mygrid, ct.bcWF[0], ct.bcWF[1], ct.bcWF[2], gid);
-        pb::GridFuncVector<ORBDTYPE, memory_space_type>& gfvphi(
-            *phi.getPtDataWGhosts());
-        gfvw1.pointwiseProduct(gfvphi, gfpot);
-
-        pb::GridFuncVector<ORBDTYPE, memory_space_type> gfv_work1(
-            mygrid, ct.bcWF[0], ct.bcWF[1], ct.bcWF[2], gid);
-        // work1 = B*V*psi
-        gfvw1.applyRHS(0, gfv_work1);
-
-        pb::GridFuncVector<ORBDTYPE, memory_space_type>* gfv_phi
-            = phi.getPtDataWGhosts();
-        // gfvw1 = -Lap*phi
-        gfv_phi->applyLap(0, gfvw1);
-        // gfv_work1 = -Lap*phi + B*V*psi
-        gfv_work1.axpy(1., gfvw1);
-        // set hpsi data without ghosts
-        hphi.setPsi(gfv_work1);
+        gfv_phi->initiateTradeBoundaries();
     }
     else
     {
-        // This loop is not thread safe as GridFunc ghost values filling
-        // MPI calls may conflicts (all use the same tag)
-        //#pragma omp parallel for
-        for (int i = 0; i < ncolors; i++)
+        phi.trade_boundaries();
+
+        // Fill ghost values for all the colors at once, so that no
+        // MPI call (with a common tag) is made inside the color loop.
+        // Note: phi.trade_boundaries() may skip the exchange based on
+        // iterative index only, so we make sure it has been done here.
+        gfv_phi->trade_boundaries();
+    }
+
+    std::vector<pb::GridFunc<ORBDTYPE>*> gf_phi(ncolors);
+    for (int i = 0; i < ncolors; i++)
+    {
+        gf_phi[i] = &phi.getFuncWithGhosts(i);
+        assert(overlap_comm || gf_phi[i]->updated_boundaries());
+    }
+
+    // Mehrstellen operator needs potential values at neighboring points
+    const bool mehrstellen = ct.Mehrstellen();
+    std::unique_ptr<pb::GridFunc<POTDTYPE>> gfpot;
+    if (mehrstellen)
+    {
+        gfpot.reset(new pb::GridFunc<POTDTYPE>(
+            mygrid, ct.bcWF[0], ct.bcWF[1], ct.bcWF[2]));
+        gfpot->assign(vtot);
+        gfpot->trade_boundaries();
+    }
+
+    unsigned int const size = hphi.getNumpt();
+
+#pragma omp parallel if (threaded)
+    {
+        // one host view per thread, reused for all its colors
+        ORBDTYPE* host_view = MemorySpace::Memory<ORBDTYPE,
+            memory_space_type>::allocate_host_view(size);
+
+        // hphi = -Lap*phi + B*(V*phi) in one sweep, on region of subdomain
+        auto apply_colors = [&](const pb::StencilRegion region) {
+#pragma omp for
+            for (int i = 0; i < ncolors; i++)
+            {
+                ORBDTYPE* ihphi           = hphi.getPsi(i);
+                ORBDTYPE* ihphi_host_view = host_view;
+                MemorySpace::Memory<ORBDTYPE,
+                    memory_space_type>::copy_view_to_host(ihphi, size,
+                    ihphi_host_view);
+
+                if (mehrstellen)
+                    lapOper_->applyWithPot(
+                        *gf_phi[i], *gfpot, ihphi_host_view, region);
+                else
+                    lapOper_->applyWithPot(
+                        *gf_phi[i], vtot, ihphi_host_view, region);
+
+                MemorySpace::Memory<ORBDTYPE,
+                    memory_space_type>::copy_view_to_dev(ihphi_host_view,
+                    size, ihphi);
+            }
+        };
+
+        if (overlap_comm)
         {
-            using memory_space_type   = typename T::memory_space_type;
-            ORBDTYPE* ihphi           = hphi.getPsi(i);
-            unsigned int const size   = hphi.getNumpt();
-            ORBDTYPE* ihphi_host_view = MemorySpace::Memory<ORBDTYPE,
-                memory_space_type>::allocate_host_view(size);
-            MemorySpace::Memory<ORBDTYPE, memory_space_type>::copy_view_to_host(
-                hphi.getPsi(i), size, ihphi_host_view);
-
-            lapOper_->applyWithPot(
-                phi.getFuncWithGhosts(i), vtot, ihphi_host_view);
-
-            MemorySpace::Memory<ORBDTYPE, memory_space_type>::copy_view_to_dev(
-                ihphi_host_view, size, ihphi);
-            MemorySpace::Memory<ORBDTYPE, memory_space_type>::free_host_view(
-                ihphi_host_view);
+            apply_colors(pb::StencilRegion::Interior);
+
+            // MPI calls from master thread only
+#pragma omp master
+            gfv_phi->finishTradeBoundaries();
+#pragma omp barrier
+
+            apply_colors(pb::StencilRegion::Shell);
         }
+        else
+        {
+            apply_colors(pb::StencilRegion::All);
+        }
+
+        MemorySpace::Memory<ORBDTYPE, memory_space_type>::free_host_view(
+            host_view);
     }
 
     apply_Hloc_tm_.stop();
@@ -273,6 +329,10 @@ template const LocGridOrbitals& Hamiltonian<LocGridOrbitals>::applyLocal(
 template const ExtendedGridOrbitals&
 Hamiltonian<ExtendedGridOrbitals>::applyLocal(
     ExtendedGridOrbitals&, const bool);
+template void Hamiltonian<LocGridOrbitals>::applyLocal(
+    LocGridOrbitals&, LocGridOrbitals&);
+template void Hamiltonian<ExtendedGridOrbitals>::applyLocal(
+    ExtendedGridOrbitals&, ExtendedGridOrbitals&);
 template void Hamiltonian<LocGridOrbitals>::addHlocalij(LocGridOrbitals&,
     LocGridOrbitals&, ProjectedMatricesInterface* proj_matrices);
 template void Hamiltonian<ExtendedGridOrbitals>::addHlocalij(
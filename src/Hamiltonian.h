@@ -42,6 +42,8 @@ public:
     pb::Lap<ORBDTYPE>* lapOper() { return lapOper_; }
 
     const OrbitalsType& applyLocal(OrbitalsType& phi, const bool force = false);
+    // compute H_loc*phi into hphi, without using or updating cached H*phi
+    void applyLocal(OrbitalsType& phi, OrbitalsType& hphi);
 
     template <class MatrixType>
     void addHlocal2matrix(OrbitalsType& orbitals1, OrbitalsType& orbitals2,
@@ -23,8 +23,8 @@
 
 Timer PoissonInterface::poisson_tm_("Poisson::poisson");
 
-template <class T>
-void Hartree<T>::solve(
+template <class T, class TL>
+void Hartree<T, TL>::solve(
     const pb::GridFunc<RHODTYPE>& rho, const pb::GridFunc<RHODTYPE>& rhoc)
 {
     PoissonInterface::poisson_tm_.start();
@@ -116,3 +116,11 @@ template class Hartree<pb::Laph4M<POTDTYPE>>;
 // template class Hartree<pb::Laph4M<float> >;
 template class Hartree<pb::Laph4MP<POTDTYPE>>;
 // template class Hartree<pb::Laph4MP<float> >;
+
+// mixed precision
+template class Hartree<pb::Laph2<POTDTYPE>, pb::Laph2<float>>;
+template class Hartree<pb::Laph4<POTDTYPE>, pb::Laph4<float>>;
+template class Hartree<pb::Laph6<POTDTYPE>, pb::Laph6<float>>;
+template class Hartree<pb::Laph8<POTDTYPE>, pb::Laph8<float>>;
+template class Hartree<pb::Laph4M<POTDTYPE>, pb::Laph4M<float>>;
+template class Hartree<pb::Laph4MP<POTDTYPE>, pb::Laph4MP<float>>;
@@ -14,20 +14,42 @@
 #include "PoissonInterface.h"
 
 #include "SolverLap.h"
+#include "SolverLapMixedPrecision.h"
 
-template <class T>
+#include <type_traits>
+
+// T: FD operator used to compute residuals
+// TL: FD operator used in multigrid V-cycles (mixed precision if different)
+template <class T, class TL = T>
 class Hartree : public Poisson
 {
 private:
-    pb::SolverLap<T, POTDTYPE>* poisson_solver_;
+    pb::Solver<POTDTYPE>* poisson_solver_;
+
+    // member templates, so that only the variant used is instantiated
+    // by explicit instantiations of Hartree
+    template <class U = TL>
+    typename std::enable_if<std::is_same<T, U>::value>::type createSolver()
+    {
+        T oper(Poisson::grid_);
+        poisson_solver_ = new pb::SolverLap<T, POTDTYPE>(
+            oper, Poisson::bc_[0], Poisson::bc_[1], Poisson::bc_[2]);
+    }
+
+    template <class U = TL>
+    typename std::enable_if<!std::is_same<T, U>::value>::type createSolver()
+    {
+        T oper(Poisson::grid_);
+        TL oper_low(Poisson::grid_);
+        poisson_solver_ = new pb::SolverLapMixedPrecision<T, TL, POTDTYPE>(
+            oper, oper_low, Poisson::bc_[0], Poisson::bc_[1], Poisson::bc_[2]);
+    }
 
 public:
     // Constructor
     Hartree(const pb::Grid& grid, const short bc[3]) : Poisson(grid, bc)
     {
-        T oper(Poisson::grid_);
-        poisson_solver_
-            = new pb::SolverLap<T, POTDTYPE>(oper, bc[0], bc[1], bc[2]);
+        createSolver();
     };
 
     // Destructor
@@ -118,6 +118,9 @@ void Ion::init(const double crds[3], const double velocity[3], const bool lock)
 
 void Ion::setup()
 {
+    // do not modify projector shared with other ions (see Ions::setup())
+    if (kbproj_.use_count() > 1) kbproj_.reset(new KBprojectorSparse(species_));
+
     kbproj_->setup(position_);
 
     map_nl_ = kbproj_->overlapPE();
@@ -96,6 +96,20 @@ public:
     void init(const double crds[3], const double velocity[3], const bool lock);
     void setup();
 
+    // use projector already computed (for the same position)
+    // instead of calling setup()
+    void setKBprojector(const std::shared_ptr<KBprojector>& kbproj)
+    {
+        kbproj_ = kbproj;
+        map_nl_ = kbproj_->overlapPE();
+    }
+
+    // indices of first grid point of box where projectors are non-zero
+    void getKBprojStartIndex(short start_index[3]) const
+    {
+        kbproj_->getStartIndex(position_, start_index);
+    }
+
     std::shared_ptr<KBprojector> kbproj() { return kbproj_; }
     const std::shared_ptr<KBprojector> kbproj() const { return kbproj_; }
 
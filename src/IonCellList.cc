@@ -0,0 +1,135 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "IonCellList.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+IonCellList::IonCellList(const std::vector<double>& positions,
+    const double lattice[3], const short periodic[3], const double cutoff)
+{
+    assert(cutoff > 0.);
+    assert(positions.size() % 3 == 0);
+
+    const int npoints = (int)positions.size() / 3;
+
+    double extent[3];
+    for (short dir = 0; dir < 3; dir++)
+    {
+        assert(lattice[dir] > 0.);
+        lattice_[dir]  = lattice[dir];
+        periodic_[dir] = periodic[dir];
+
+        lower_[dir] = 0.;
+        extent[dir] = lattice[dir];
+        if (!periodic[dir] && npoints > 0)
+        {
+            // bounding box of points
+            double xmin = std::numeric_limits<double>::max();
+            double xmax = std::numeric_limits<double>::lowest();
+            for (int i = 0; i < npoints; i++)
+            {
+                xmin = std::min(xmin, positions[3 * i + dir]);
+                xmax = std::max(xmax, positions[3 * i + dir]);
+            }
+            lower_[dir] = xmin;
+            extent[dir] = xmax - xmin;
+        }
+        ncells_[dir] = std::max(1, (int)std::floor(extent[dir] / cutoff));
+    }
+
+    // limit number of (mostly empty) cells for very sparse systems
+    const long max_cells = std::max(27L, 8L * npoints);
+    while ((long)ncells_[0] * ncells_[1] * ncells_[2] > max_cells)
+    {
+        short dir = 0;
+        if (ncells_[1] > ncells_[dir]) dir = 1;
+        if (ncells_[2] > ncells_[dir]) dir = 2;
+        ncells_[dir] = (ncells_[dir] + 1) / 2;
+    }
+
+    // cells of size at least cutoff
+    for (short dir = 0; dir < 3; dir++)
+        cell_size_[dir] = periodic_[dir]
+                              ? lattice_[dir] / ncells_[dir]
+                              : std::max(cutoff, extent[dir] / ncells_[dir]);
+
+    head_.assign(ncells_[0] * ncells_[1] * ncells_[2], -1);
+    next_.assign(npoints, -1);
+    for (int i = 0; i < npoints; i++)
+    {
+        const int ix   = cellIndex(positions[3 * i], 0);
+        const int iy   = cellIndex(positions[3 * i + 1], 1);
+        const int iz   = cellIndex(positions[3 * i + 2], 2);
+        const int cell = (ix * ncells_[1] + iy) * ncells_[2] + iz;
+        next_[i]       = head_[cell];
+        head_[cell]    = i;
+    }
+}
+
+int IonCellList::cellIndex(const double x, const short dir) const
+{
+    if (periodic_[dir])
+    {
+        double xp = std::fmod(x, lattice_[dir]);
+        if (xp < 0.) xp += lattice_[dir];
+        return std::min(ncells_[dir] - 1, (int)(xp / cell_size_[dir]));
+    }
+    const int i = (int)std::floor((x - lower_[dir]) / cell_size_[dir]);
+    return std::max(0, std::min(ncells_[dir] - 1, i));
+}
+
+// cells in direction dir adjacent to center, each one listed once
+void IonCellList::getCells(
+    const int center, const short dir, std::vector<int>& cells) const
+{
+    cells.clear();
+    const int n = ncells_[dir];
+    if (periodic_[dir])
+    {
+        if (n < 3)
+        {
+            for (int i = 0; i < n; i++)
+                cells.push_back(i);
+        }
+        else
+        {
+            for (int i = -1; i <= 1; i++)
+                cells.push_back((center + i + n) % n);
+        }
+    }
+    else
+    {
+        for (int i = std::max(0, center - 1); i <= std::min(n - 1, center + 1);
+             i++)
+            cells.push_back(i);
+    }
+}
+
+void IonCellList::getNeighbors(
+    const double point[3], std::vector<int>& indexes) const
+{
+    indexes.clear();
+
+    std::vector<int> cells[3];
+    for (short dir = 0; dir < 3; dir++)
+        getCells(cellIndex(point[dir], dir), dir, cells[dir]);
+
+    for (auto ix : cells[0])
+        for (auto iy : cells[1])
+            for (auto iz : cells[2])
+            {
+                const int cell = (ix * ncells_[1] + iy) * ncells_[2] + iz;
+                for (int i = head_[cell]; i >= 0; i = next_[i])
+                    indexes.push_back(i);
+            }
+}
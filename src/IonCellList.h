@@ -0,0 +1,51 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_IONCELLLIST_H
+#define MGMOL_IONCELLLIST_H
+
+#include <vector>
+
+// Linked-cell list: points are binned into cells of size at least
+// "cutoff" in each direction, so that all the points within "cutoff"
+// of a given position (with minimum image convention in periodic
+// directions) are in the 3x3x3 cells around that position.
+// Used to evaluate short-range pair interactions in O(N).
+class IonCellList
+{
+    double lattice_[3];
+    short periodic_[3];
+
+    // lower corner of binned region in non-periodic directions
+    double lower_[3];
+    double cell_size_[3];
+    int ncells_[3];
+
+    // index of first point in each cell (-1 if empty)
+    std::vector<int> head_;
+
+    // index of next point in same cell (-1 if last)
+    std::vector<int> next_;
+
+    int cellIndex(const double x, const short dir) const;
+    void getCells(const int center, const short dir, std::vector<int>&) const;
+
+public:
+    // positions: x,y,z coordinates of each point
+    IonCellList(const std::vector<double>& positions, const double lattice[3],
+        const short periodic[3], const double cutoff);
+
+    // indexes of points possibly within cutoff of point
+    // (superset, distances need to be checked by caller)
+    void getNeighbors(const double point[3], std::vector<int>& indexes) const;
+
+    int ncells(const short dir) const { return ncells_[dir]; }
+};
+
+#endif
@@ -10,6 +10,7 @@
 #include "Ions.h"
 #include "Control.h"
 #include "HDFrestart.h"
+#include "IonCellList.h"
 #include "MGmol_MPI.h"
 #include "MGmol_blas1.h"
 #include "MPIdata.h"
@@ -22,6 +23,7 @@
 
 #include <mpi.h>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <iterator>
@@ -208,10 +210,7 @@ void Ions::setup()
     if (ct.verbose > 0)
         printWithTimeStamp("Ions::setup()... individual ions...", std::cout);
 
-    for (auto& ion : list_ions_)
-    {
-        ion->setup();
-    }
+    setupKBprojectors();
 
     setMapVL();
     setupListOverlappingIons();
@@ -226,6 +225,63 @@ void Ions::setup()
     ions_setup_tm.stop();
 }
 
+// setup projectors of all the ions in list_ions_,
+// reusing projectors computed in previous call for ions that did not move
+// by more than ct.projectorsReuseTol() and did not change grid offset
+void Ions::setupKBprojectors()
+{
+    Control& ct           = *(Control::instance());
+    const double tol      = ct.projectorsReuseTol();
+    const bool reuse_proj = (tol >= 0.);
+
+    std::map<unsigned int, KBprojectorCacheEntry> new_cache;
+    for (auto& ion : list_ions_)
+    {
+        if (!reuse_proj)
+        {
+            ion->setup();
+            continue;
+        }
+
+        KBprojectorCacheEntry entry;
+        ion->getPosition(&entry.position[0]);
+        ion->getKBprojStartIndex(entry.start_index);
+
+        bool found = false;
+        auto it    = kbproj_cache_.find(ion->index());
+        if (it != kbproj_cache_.end())
+        {
+            const KBprojectorCacheEntry& old_entry(it->second);
+            double d2 = 0.;
+            for (short dir = 0; dir < 3; dir++)
+            {
+                const double d = entry.position[dir] - old_entry.position[dir];
+                d2 += d * d;
+            }
+            found = (std::sqrt(d2) <= tol);
+            for (short dir = 0; dir < 3; dir++)
+                if (entry.start_index[dir] != old_entry.start_index[dir])
+                    found = false;
+        }
+
+        if (found)
+        {
+            ion->setKBprojector(it->second.kbproj);
+            // keep position projector was computed for
+            entry = it->second;
+        }
+        else
+        {
+            ion->setup();
+            entry.kbproj = ion->kbproj();
+        }
+        new_cache[ion->index()] = entry;
+    }
+
+    // keep only projectors of ions in current list
+    kbproj_cache_.swap(new_cache);
+}
+
 Ions::~Ions()
 {
     std::vector<Ion*>::iterator ion = list_ions_.begin();
@@ -387,14 +443,38 @@ void Ions::setupContraintsData(std::vector<Ion*>& ions_for_constraints)
     }
 }
 
+// cutoff radius for erfc(r/sqrt(rc1^2+rc2^2)) terms: erfc(6.) ~ 2.e-17
+double Ions::computeIonIonCutoff() const
+{
+    double rcmax = 0.;
+    for (auto ion : interacting_ions_)
+        rcmax = std::max(rcmax, ion->getRC());
+
+    return 6. * M_SQRT2 * rcmax;
+}
+
 void Ions::iiforce(const short bc[3])
 {
+    // nothing to do on tasks without ions nearby
+    if (local_ions_.empty() || interacting_ions_.empty()) return;
+
     const int nlions = local_ions_.size();
     std::vector<double> forces(3 * nlions, 0.);
 
+    // bin interacting ions into cells of size cutoff, so that only
+    // neighboring cells need to be visited for each local ion
+    const double cutoff = computeIonIonCutoff();
+    std::vector<double> positions;
+    positions.reserve(3 * interacting_ions_.size());
+    for (auto ion : interacting_ions_)
+        for (short i = 0; i < 3; i++)
+            positions.push_back(ion->position(i));
+    IonCellList cells(positions, lattice_, bc, cutoff);
+
+    std::vector<int> neighbors;
+
     std::vector<Ion*>::const_iterator ion1 = local_ions_.begin();
     int ion1_index                         = 0;
-    ;
     while (ion1 != local_ions_.end())
     {
         const double z1 = (*ion1)->getZion();
@@ -402,21 +482,26 @@ void Ions::iiforce(const short bc[3])
 
         const double rc1 = (*ion1)->getRC();
 
-        std::vector<Ion*>::const_iterator ion2 = interacting_ions_.begin();
-        while (ion2 != interacting_ions_.end())
+        double position1[3];
+        (*ion1)->getPosition(&position1[0]);
+        cells.getNeighbors(position1, neighbors);
+
+        for (auto index2 : neighbors)
         {
-            if (*ion1 != *ion2)
+            const Ion* ion2 = interacting_ions_[index2];
+            if (*ion1 != ion2)
             {
                 // Minimum image convention for r
                 double dr[3];
-                const double r12 = (*ion1)->minimage(**ion2, lattice_, bc, dr);
+                const double r12 = (*ion1)->minimage(*ion2, lattice_, bc, dr);
+                if (r12 >= cutoff) continue;
 
                 const double invr = 1. / r12;
 
-                const double z2 = (*ion2)->getZion();
+                const double z2 = ion2->getZion();
                 assert(z2 >= 0.);
 
-                const double rc2 = (*ion2)->getRC();
+                const double rc2 = ion2->getRC();
 
                 const double t        = rc1 * rc1 + rc2 * rc2;
                 const double invt     = 1. / t;
@@ -431,8 +516,6 @@ void Ions::iiforce(const short bc[3])
                 for (short i = 0; i < 3; i++)
                     forces[3 * ion1_index + i] += dr[i] * alpha;
             }
-
-            ion2++;
         }
         ion1_index++;
         ion1++;
@@ -467,9 +550,10 @@ double Ions::energySelf() const
     return energy; // Hartree
 }
 
-// right-looking approach avoids duplicate computation of energy on different
-// processors. This works since ion lists are in ascending order of unique ion
-// index
+// Energy of each pair of interacting ions is computed on the tasks
+// owning each of the two ions, and counted with a factor 1/2.
+// Only pairs closer than computeIonIonCutoff() are included, using a
+// cell list to find them in O(N).
 double Ions::energyDiff(const short bc[3]) const
 {
     double energy = 0.;
@@ -478,30 +562,38 @@ double Ions::energyDiff(const short bc[3]) const
     assert(lattice_[1] > 0.);
     assert(lattice_[2] > 0.);
 
-    std::vector<Ion*>::const_iterator ion1 = interacting_ions_.begin();
-    while (ion1 != interacting_ions_.end())
+    // no pair contribution on tasks without ions nearby
+    if (!interacting_ions_.empty())
     {
-        if ((*ion1)->here())
+        const double cutoff = computeIonIonCutoff();
+        std::vector<double> positions;
+        positions.reserve(3 * interacting_ions_.size());
+        for (auto ion : interacting_ions_)
+            for (short i = 0; i < 3; i++)
+                positions.push_back(ion->position(i));
+        IonCellList cells(positions, lattice_, bc, cutoff);
+
+        std::vector<int> neighbors;
+        for (auto ion1 : interacting_ions_)
         {
-            std::vector<Ion*>::const_iterator ion2 = interacting_ions_.begin();
-            ;
-            while (ion2 != ion1)
+            if (ion1->here())
             {
-                energy += (*ion1)->energyDiff(**ion2, lattice_, bc);
+                double position1[3];
+                ion1->getPosition(&position1[0]);
+                cells.getNeighbors(position1, neighbors);
 
-                ion2++;
-            }
-            // increment ion2 past ion1
-            ion2++;
-            while (ion2 != interacting_ions_.end())
-            {
-                energy += (*ion1)->energyDiff(**ion2, lattice_, bc);
+                for (auto index2 : neighbors)
+                {
+                    const Ion* ion2 = interacting_ions_[index2];
+                    if (ion2 == ion1) continue;
 
-                ion2++;
+                    const double r12 = ion1->minimage(*ion2, lattice_, bc);
+                    if (r12 < cutoff)
+                        energy += ion1->getSpecies().ediff(
+                            ion2->getSpecies(), r12);
+                }
             }
         }
-
-        ion1++;
     }
     assert(energy == energy);
 
@@ -2851,14 +2943,14 @@ bool Ions::inLocalIons(const double x, const double y, const double z)
 //    }
 //}
 
-int Ions::getNumIons(void)
+int Ions::getNumIons(void) const
 {
     if (num_ions_ < 0) computeNumIons();
 
     return num_ions_;
 }
 
-void Ions::computeNumIons(void)
+void Ions::computeNumIons(void) const
 {
     MGmol_MPI& mmpi(*(MGmol_MPI::instance()));
     num_ions_ = (int)local_ions_.size();
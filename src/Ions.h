@@ -61,6 +61,18 @@ class Ions
 
     bool has_locked_atoms_;
 
+    // projectors computed in last call to setup(), for each ion index,
+    // with the position and grid offset they were computed for
+    struct KBprojectorCacheEntry
+    {
+        double position[3];
+        short start_index[3];
+        std::shared_ptr<KBprojector> kbproj;
+    };
+    std::map<unsigned int, KBprojectorCacheEntry> kbproj_cache_;
+
+    void setupKBprojectors();
+
     void readRestartVelocities(HDFrestart& h5_file);
     void readRestartRandomStates(HDFrestart& h5_file);
     void readRestartPositions(HDFrestart& h5_file);
@@ -125,7 +137,10 @@ class Ions
     bool setup_;
 
     void gatherLockedData(std::vector<int>& locked_data, const int root) const;
-    void computeNumIons(void);
+    void computeNumIons(void) const;
+
+    // distance beyond which short-range ion-ion interactions are negligible
+    double computeIonIonCutoff() const;
     int readNatoms(const std::string& input_file, const bool cell_relative);
     int readNatoms(std::ifstream* tfile, const bool cell_relative);
     int readAtomsFromXYZ(const std::string& filename, const bool cell_relative);
@@ -215,7 +230,7 @@ public:
     void printForces(std::ostream& os, const int root = 0) const;
     void printForcesLocal(std::ostream& os, const int root = 0) const;
     void printForcesGlobal(std::ostream& os, const int root = 0) const;
-    int getNumIons(void);
+    int getNumIons(void) const;
     int getNumLocIons(void) const { return local_ions_.size(); }
     int getNumListIons(void) const { return list_ions_.size(); }
     std::vector<Ion*>& local_ions() { return local_ions_; }
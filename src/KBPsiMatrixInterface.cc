@@ -59,6 +59,57 @@ void KBPsiMatrixInterface::computeLocalElement(Ion& ion, const int istate,
     if (omp_get_thread_num() == 0) computeLocalElement_tm_.stop();
 }
 
+void KBPsiMatrixInterface::computeLocalElements(Ion& ion,
+    const vector<int>& istates, const int iloc,
+    const vector<const ORBDTYPE*>& psi, const bool flag)
+{
+    assert(istates.size() == psi.size());
+    assert(iloc >= 0);
+
+    if (istates.empty()) return;
+
+    vector<int> gids;
+    ion.getGidsNLprojs(gids);
+    if (gids.empty()) return;
+
+    std::shared_ptr<KBprojector> ion_kbproj(ion.kbproj());
+
+    if (!ion_kbproj->overlaps(iloc)) return;
+
+    if (omp_get_thread_num() == 0) computeLocalElement_tm_.start();
+
+    // <KB|psi> for all projectors of this ion and all states
+    vector<double> vals;
+    ion_kbproj->dotPsiBatch(iloc, psi, vals);
+
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    const double vel       = mygrid.vel();
+
+    const short nprojs = (short)gids.size();
+    assert(vals.size() == nprojs * psi.size());
+    for (unsigned int j = 0; j < istates.size(); j++)
+    {
+        const int istate = istates[j];
+        assert(istate != -1);
+        for (short i = 0; i < nprojs; i++)
+        {
+            const int gid    = gids[i];
+            const double val = vel * vals[i + nprojs * j];
+            if (flag)
+            {
+                addKBBPsi(gid, istate, val);
+            }
+            else
+            {
+                addKBPsi(gid, istate, val);
+            }
+        }
+    }
+
+    if (omp_get_thread_num() == 0) computeLocalElement_tm_.stop();
+}
+
 void KBPsiMatrixInterface::printTimers(ostream& os)
 {
     computeLocalElement_tm_.print(os);
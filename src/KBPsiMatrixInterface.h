@@ -14,6 +14,8 @@
 #include "VariableSizeMatrix.h"
 #include "tools.h"
 
+#include <vector>
+
 template <class T>
 class ProjectedMatrices;
 class ProjectedMatricesInterface;
@@ -50,6 +52,11 @@ public:
 
     void computeLocalElement(Ion& ion, const int istate, const int iloc,
         const ORBDTYPE* const psi, const bool flag);
+
+    // evaluate <KB|psi> for several states at once
+    void computeLocalElements(Ion& ion, const std::vector<int>& istates,
+        const int iloc, const std::vector<const ORBDTYPE*>& psi,
+        const bool flag);
 };
 
 #endif
@@ -177,25 +177,32 @@ void KBPsiMatrixSparse::computeKBpsi(Ions& ions, T& orbitals,
     // Loop over functions, subdomains and ions
     Mesh* mymesh      = Mesh::instance();
     const int subdivx = mymesh->subdivx();
+    std::vector<int> gids;
+    std::vector<const ORBDTYPE*> psi;
+    gids.reserve(nb_colors);
+    psi.reserve(nb_colors);
     for (int iloc = 0; iloc < subdivx; iloc++)
     {
-        // Threading here leads to results slightly dependent on number of
-        // threads (jlf, 07/15/2016)
-        // #pragma omp parallel for
+        // states with non-zero values in subdomain iloc
+        gids.clear();
+        psi.clear();
         for (int color = 0; color < nb_colors; color++)
         {
             const int gid = orbitals.getGlobalIndex(iloc, first_color + color);
-
-            // Loop over the ions
             if (gid != -1)
             {
-                for (auto ion : ions.overlappingNL_ions())
-                {
-                    computeLocalElement(
-                        *ion, gid, iloc, ppsi + color * ldsize, flag);
-                }
+                gids.push_back(gid);
+                psi.push_back(ppsi + color * ldsize);
             }
         }
+
+        // Loop over the ions, computing all the states at once
+        // Threading here leads to results slightly dependent on number of
+        // threads (jlf, 07/15/2016)
+        for (auto ion : ions.overlappingNL_ions())
+        {
+            computeLocalElements(*ion, gids, iloc, psi, flag);
+        }
     }
 
     if (flag)
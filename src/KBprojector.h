@@ -93,6 +93,11 @@ public:
 
     virtual double maxRadius() const = 0;
 
+    // indices of first grid point of box where projector centered
+    // at "center" is non-zero
+    virtual void getStartIndex(
+        const double center[3], short start_index[3]) const = 0;
+
     virtual bool overlapPE() const                                        = 0;
     virtual void registerPsi(const short iloc, const ORBDTYPE* const psi) = 0;
 
@@ -110,6 +115,16 @@ public:
     virtual void axpyKet(const short iloc, const std::vector<double>& alpha,
         float* const dst) const  = 0;
 
+    // batched versions of dotPsi and axpyKet for several functions psi:
+    // vals[i+nprojs*j] = <proj_i|psi[j]>
+    virtual void dotPsiBatch(const short iloc,
+        const std::vector<const ORBDTYPE*>& psi,
+        std::vector<double>& vals) const = 0;
+    // dst[j] += sum_i alpha[i+nprojs*j]*proj_i
+    virtual void axpyKetBatch(const short iloc,
+        const std::vector<double>& alpha,
+        const std::vector<ORBDTYPE*>& dst) const = 0;
+
     bool onlyOneProjector() const
     {
         return ((maxl_ == 1) && (llocal_ == 1) && (multiplicity_[0] == 1));
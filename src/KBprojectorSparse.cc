@@ -17,6 +17,7 @@ const double rthreshold = 1.e-5;
 
 std::vector<std::vector<ORBDTYPE>> KBprojectorSparse::work_nlindex_;
 std::vector<std::vector<KBPROJDTYPE>> KBprojectorSparse::work_proj_;
+std::vector<std::vector<ORBDTYPE>> KBprojectorSparse::work_panel_;
 
 KBprojectorSparse::KBprojectorSparse(const Species& sp) : KBprojector(sp)
 {
@@ -24,6 +25,7 @@ KBprojectorSparse::KBprojectorSparse(const Species& sp) : KBprojector(sp)
 
     if (work_nlindex_.size() == 0) work_nlindex_.resize(omp_get_max_threads());
     if (work_proj_.size() == 0) work_proj_.resize(omp_get_max_threads());
+    if (work_panel_.size() == 0) work_panel_.resize(omp_get_max_threads());
     // cout<<"constructor: work_nlindex_.size()="<<work_nlindex_.size()<<endl;
 
     is_in_domain_ = nullptr;
@@ -675,7 +677,8 @@ void KBprojectorSparse::setFProjector(const short iloc, const int icount)
     } // loop over multiplicity
 }
 
-void KBprojectorSparse::setKBProjStart()
+void KBprojectorSparse::getStartIndex(
+    const double center[3], short start_index[3]) const
 {
     assert(range_kbproj_ >= 0);
     assert(range_kbproj_ < 256);
@@ -691,7 +694,7 @@ void KBprojectorSparse::setKBProjStart()
         const double cell_origin = mygrid.origin(dir);
 
         // n1 = nb of nodes between the boundary and center
-        double n1 = (center_[dir] - cell_origin) / h_[dir];
+        double n1 = (center[dir] - cell_origin) / h_[dir];
         assert(fabs(n1) < 10000.);
 
         // get the integral part of n1 in ic
@@ -701,7 +704,21 @@ void KBprojectorSparse::setKBProjStart()
         if (f1 > 0.5) ic++;
         if (f1 < -0.5) ic--;
 
-        kb_proj_start_index_[dir] = ic - (range_kbproj_ >> 1);
+        start_index[dir] = ic - (range_kbproj_ >> 1);
+    }
+}
+
+void KBprojectorSparse::setKBProjStart()
+{
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+
+    getStartIndex(center_, kb_proj_start_index_);
+
+    for (short dir = 0; dir < 3; dir++)
+    {
+        const double cell_origin = mygrid.origin(dir);
+
         kb_proj_start_[dir] = cell_origin + h_[dir] * kb_proj_start_index_[dir];
         //(*MPIdata::sout)<<"nlproj_start_[i]="<<nlproj_start_[i]<<endl;
         //(*MPIdata::sout)<<"nlstart_[i]     ="<<nlstart_[i]<<endl;
@@ -1138,6 +1155,78 @@ double KBprojectorSparse::dotPsi(const short iloc, const short index) const
     return 0.;
 }
 
+// compute <proj|psi> for all the projectors and all the functions psi
+// with one matrix-matrix multiplication
+void KBprojectorSparse::dotPsiBatch(const short iloc,
+    const std::vector<const ORBDTYPE*>& psi, std::vector<double>& vals) const
+{
+    assert(iloc < subdivx_);
+
+    const int nprojs  = nProjectors();
+    const int ncols   = static_cast<int>(psi.size());
+    const int size_nl = size_nl_[iloc];
+
+    vals.resize(nprojs * ncols);
+    if (ncols == 0) return;
+    assert(size_nl > 0);
+
+    // gather values of psi on nodes where projectors are non-zero
+    const short thread = omp_get_thread_num();
+    assert(static_cast<unsigned int>(thread) < work_panel_.size());
+    std::vector<ORBDTYPE>& work(work_panel_[thread]);
+    if (static_cast<int>(work.size()) < size_nl * ncols)
+        work.resize(size_nl * ncols);
+
+    const int* const pidx = &nlindex_[iloc][0];
+    for (int j = 0; j < ncols; j++)
+    {
+        const ORBDTYPE* const src = psi[j];
+        ORBDTYPE* const wj        = &work[j * size_nl];
+        for (int idx = 0; idx < size_nl; idx++)
+            wj[idx] = src[pidx[idx]];
+    }
+
+    LinearAlgebraUtils<MemorySpace::Host>::MPgemm('t', 'n', nprojs, ncols,
+        size_nl, 1., &projectors_storage_[iloc][0], size_nl, &work[0], size_nl,
+        0., &vals[0], nprojs);
+}
+
+// add linear combinations of projectors to all the functions dst
+// with one matrix-matrix multiplication
+void KBprojectorSparse::axpyKetBatch(const short iloc,
+    const std::vector<double>& alpha, const std::vector<ORBDTYPE*>& dst) const
+{
+    assert(iloc < subdivx_);
+
+    const int nprojs  = nProjectors();
+    const int ncols   = static_cast<int>(dst.size());
+    const int size_nl = size_nl_[iloc];
+    assert(static_cast<int>(alpha.size()) == nprojs * ncols);
+
+    if (ncols == 0) return;
+    assert(size_nl > 0);
+
+    const short thread = omp_get_thread_num();
+    assert(static_cast<unsigned int>(thread) < work_panel_.size());
+    std::vector<ORBDTYPE>& work(work_panel_[thread]);
+    if (static_cast<int>(work.size()) < size_nl * ncols)
+        work.resize(size_nl * ncols);
+
+    LinearAlgebraUtils<MemorySpace::Host>::MPgemm('n', 'n', size_nl, ncols,
+        nprojs, 1., &projectors_storage_[iloc][0], size_nl, &alpha[0], nprojs,
+        0., &work[0], size_nl);
+
+    // scatter results on nodes where projectors are non-zero
+    const int* const pidx = &nlindex_[iloc][0];
+    for (int j = 0; j < ncols; j++)
+    {
+        ORBDTYPE* const dstj     = dst[j];
+        const ORBDTYPE* const wj = &work[j * size_nl];
+        for (int idx = 0; idx < size_nl; idx++)
+            dstj[pidx[idx]] += wj[idx];
+    }
+}
+
 double KBprojectorSparse::maxRadius() const
 {
     double radius = 0.;
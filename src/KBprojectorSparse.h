@@ -34,11 +34,16 @@ class KBprojectorSparse : public KBprojector
 
     static std::vector<std::vector<KBPROJDTYPE>> work_proj_;
 
+    // work arrays for batched operations (1 for each thread)
+    static std::vector<std::vector<ORBDTYPE>> work_panel_;
+
     // pointers to projectors for each iloc, l, p, m
     std::vector<std::vector<std::vector<std::vector<KBPROJDTYPE*>>>>
         ptr_projector_;
 
     // storage for each 'iloc' i sstored in a std::vector
+    // (all the projectors are contiguous, so that storage for one 'iloc'
+    // is a column-major panel of dimension size_nl_[iloc] x nProjectors())
     std::vector<std::vector<KBPROJDTYPE>> projectors_storage_;
 
     std::vector<int> size_nl_;
@@ -143,6 +148,9 @@ public:
 
     double maxRadius() const override;
 
+    void getStartIndex(
+        const double center[3], short start_index[3]) const override;
+
     bool overlapPE() const override;
     void registerPsi(const short iloc, const ORBDTYPE* const psi) override;
 
@@ -175,6 +183,11 @@ public:
         axpyKetT(iloc, alpha, dst);
     }
 
+    void dotPsiBatch(const short iloc, const std::vector<const ORBDTYPE*>& psi,
+        std::vector<double>& vals) const override;
+    void axpyKetBatch(const short iloc, const std::vector<double>& alpha,
+        const std::vector<ORBDTYPE*>& dst) const override;
+
     void getKBsigns(std::vector<short>& kbsigns) const override;
     void getKBcoeffs(std::vector<double>& coeffs) const override;
 };
@@ -19,6 +19,7 @@
 #include "MGmol_MPI.h"
 #include "mputils.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -34,16 +35,114 @@ const double sevensixth = 7. / 6.;
 double cbrt(double alpha) { return pow(alpha, 0.3333333333333333333333333); }
 #endif
 
+// number of grid points processed together by one thread
+const int xc_block_size = 256;
+
+namespace
+{
+// LDA xc energy and potential, Perdew-Zunger parametrization,
+// for exchange prefactor c and correlation parameters (A, B, b1, b2, G).
+// Branch-free so that it vectorizes: non-positive densities are
+// evaluated at a dummy density and their results set to 0,
+// and both rs<1 and rs>=1 expressions are computed before selecting one.
+#pragma omp declare simd
+inline void xc_pz(const double rh, const double c, const double A,
+    const double B, const double b1, const double b2, const double G,
+    POTDTYPE& ee, POTDTYPE& vv)
+{
+    // c1 is (3.D0/(4.D0*pi))**third
+    const double c1 = 0.6203504908994001;
+
+    // C and D by matching Ec and Vc at rs=1
+    const double D = G / (1.0 + b1 + b2) - B;
+    const double C
+        = -A - D - G * ((b1 / 2.0 + b2) / ((1.0 + b1 + b2) * (1.0 + b1 + b2)));
+
+    const bool active = (rh > 0.0);
+    const double rho  = active ? (double)rh : 1.;
+
+    const double ro13 = cbrt(rho);
+    const double rs   = c1 / ro13;
+
+    // Next line : exchange part in Hartree units
+    const double vx = c / rs;
+    const double ex = 0.75 * vx;
+
+    // Next lines : Ceperley & Alder correlation (Zunger & Perdew)
+    // rs < 1
+    const double logrs = log(rs);
+    const double ec1   = A * logrs + B + C * rs * logrs + D * rs;
+    const double vc1   = A * logrs + (B - A * onethird)
+                       + (twothird)*C * rs * logrs
+                       + ((2.0 * D - C) * onethird) * rs;
+    // rs >= 1
+    const double sqrtrs  = sqrt(rs);
+    const double den     = 1.0 + b1 * sqrtrs + b2 * rs;
+    const double inv_den = 1. / den;
+    const double ec2     = G * inv_den;
+    const double vc2
+        = ec2 * (1.0 + sevensixth * b1 * sqrtrs + fourthird * b2 * rs)
+          * inv_den;
+
+    const double ec = (rs < 1.0) ? ec1 : ec2;
+    const double vc = (rs < 1.0) ? vc1 : vc2;
+
+    ee = active ? (POTDTYPE)(ex + ec) : (POTDTYPE)0.;
+    vv = active ? (POTDTYPE)(vx + vc) : (POTDTYPE)0.;
+}
+
+// compute LDA xc energy and potential, unpolarized
+#pragma omp declare simd
+inline void xc_unpolarized(const double rh, POTDTYPE& ee, POTDTYPE& vv)
+{
+    // alpha = (4/(9*pi))**third = 0.521061761198
+    // c2 = -(3/(4*pi)) / alpha = -0.458165293283
+    // c3 = (4/3) * c2 = -0.610887057711
+    const double c3 = -0.610887057711;
+
+    // C from the PZ paper: const double C  =  0.0020;
+    // D from the PZ paper: const double D  = -0.0116;
+    xc_pz(rh, c3, 0.0311, -0.048, 1.0529, 0.3334, -0.1423, ee, vv);
+}
+
+// compute LDA polarized XC energy and potential
+#pragma omp declare simd
+inline void xc_polarized(const double rh, POTDTYPE& ee, POTDTYPE& vv)
+{
+    // c4 = 2**third * c3
+    const double c4 = -0.769669463118;
+
+    // C from PZ paper: const double C   =  0.0007;
+    // D from PZ paper: const double D   = -0.0048;
+    xc_pz(rh, c4, 0.01555, -0.0269, 1.3981, 0.2611, -0.0843, ee, vv);
+}
+}
+
 void LDAFunctional::computeXC(void)
 {
+    const int nblocks = (np_ + xc_block_size - 1) / xc_block_size;
+
     if (nspin_ == 1)
     {
         assert(prho_ != nullptr);
         assert(pexc_ != nullptr);
         assert(pvxc1_ != nullptr);
-        for (int ir = 0; ir < np_; ir++)
+
+#pragma omp parallel for schedule(static)
+        for (int ib = 0; ib < nblocks; ib++)
         {
-            xc_unpolarized(prho_[ir], pexc_[ir], pvxc1_[ir]);
+            const int i0 = ib * xc_block_size;
+            const int bs = std::min(xc_block_size, np_ - i0);
+
+            const RHODTYPE* __restrict__ rho = prho_ + i0;
+            POTDTYPE* __restrict__ exc       = pexc_ + i0;
+            POTDTYPE* __restrict__ vxc       = pvxc1_ + i0;
+
+#pragma omp simd
+            for (int ir = 0; ir < bs; ir++)
+            {
+                xc_unpolarized(rho[ir], exc[ir], vxc[ir]);
+            }
         }
     }
     else
@@ -56,42 +155,54 @@ void LDAFunctional::computeXC(void)
         assert(pvxc1_dn_ != nullptr);
         const double fz_prefac  = 1.0 / (cbrt(2.0) * 2.0 - 2.0);
         const double dfz_prefac = (fourthird)*fz_prefac;
-        for (int ir = 0; ir < np_; ir++)
+
+#pragma omp parallel for schedule(static)
+        for (int ib = 0; ib < nblocks; ib++)
         {
-            double excir = 0.0;
-            double v_up  = 0.0;
-            double v_dn  = 0.0;
+            const int i0 = ib * xc_block_size;
+            const int bs = std::min(xc_block_size, np_ - i0);
 
-            double roe_up = prho_up_[ir];
-            double roe_dn = prho_dn_[ir];
-            double roe    = roe_up + roe_dn;
+            const RHODTYPE* __restrict__ rho_up = prho_up_ + i0;
+            const RHODTYPE* __restrict__ rho_dn = prho_dn_ + i0;
+            POTDTYPE* __restrict__ exc          = pexc_ + i0;
+            POTDTYPE* __restrict__ vxc_up       = pvxc1_up_ + i0;
+            POTDTYPE* __restrict__ vxc_dn       = pvxc1_dn_ + i0;
 
-            if (roe > 0.0)
+#pragma omp simd
+            for (int ir = 0; ir < bs; ir++)
             {
-                double zeta = (roe_up - roe_dn) / roe;
+                const double roe_up = rho_up[ir];
+                const double roe_dn = rho_dn[ir];
+                const double roe    = roe_up + roe_dn;
 
-                double zp1    = 1.0 + zeta;
-                double zm1    = 1.0 - zeta;
-                double zp1_13 = cbrt(zp1);
-                double zm1_13 = cbrt(zm1);
-                double fz     = fz_prefac * (zp1_13 * zp1 + zm1_13 * zm1 - 2.0);
-                double dfz    = dfz_prefac * (zp1_13 - zm1_13);
+                // screen out non-positive densities
+                const bool active = (roe > 0.0);
+
+                const double zeta = active ? (roe_up - roe_dn) / roe : 0.;
+
+                const double zp1    = 1.0 + zeta;
+                const double zm1    = 1.0 - zeta;
+                const double zp1_13 = cbrt(zp1);
+                const double zm1_13 = cbrt(zm1);
+                const double fz
+                    = fz_prefac * (zp1_13 * zp1 + zm1_13 * zm1 - 2.0);
+                const double dfz = dfz_prefac * (zp1_13 - zm1_13);
 
                 POTDTYPE xc_u, xc_p, v_u, v_p;
                 xc_unpolarized(roe, xc_u, v_u);
                 xc_polarized(roe, xc_p, v_p);
 
-                double xc_pu = (double)xc_p - (double)xc_u;
-                excir        = (double)xc_u + fz * xc_pu;
+                const double xc_pu = (double)xc_p - (double)xc_u;
+                const double excir = (double)xc_u + fz * xc_pu;
 
-                double v = (double)v_u + fz * ((double)v_p - (double)v_u);
-                v_up     = v + xc_pu * (1.0 - zeta) * dfz;
-                v_dn     = v + xc_pu * (-1.0 - zeta) * dfz;
-            }
+                const double v = (double)v_u + fz * ((double)v_p - (double)v_u);
+                const double v_up = v + xc_pu * (1.0 - zeta) * dfz;
+                const double v_dn = v + xc_pu * (-1.0 - zeta) * dfz;
 
-            pvxc1_up_[ir] = (POTDTYPE)v_up;
-            pvxc1_dn_[ir] = (POTDTYPE)v_dn;
-            pexc_[ir]     = (POTDTYPE)excir;
+                vxc_up[ir] = active ? (POTDTYPE)v_up : (POTDTYPE)0.;
+                vxc_dn[ir] = active ? (POTDTYPE)v_dn : (POTDTYPE)0.;
+                exc[ir]    = active ? (POTDTYPE)excir : (POTDTYPE)0.;
+            }
         }
     }
 }
@@ -126,130 +237,3 @@ double LDAFunctional::computeRhoDotExc() const
     exc = (POTDTYPE)sum;
     return exc;
 }
-
-void LDAFunctional::xc_unpolarized(
-    const RHODTYPE rh, POTDTYPE& ee, POTDTYPE& vv)
-{
-    // compute LDA xc energy and potential, unpolarized
-    // const double third=1.0/3.0;
-    // c1 is (3.D0/(4.D0*pi))**third
-    const double c1 = 0.6203504908994001;
-    // alpha = (4/(9*pi))**third = 0.521061761198
-    // const double alpha = 0.521061761198;
-    // c2 = -(3/(4*pi)) / alpha = -0.458165293283
-    // const double c2 = -0.458165293283;
-    // c3 = (4/3) * c2 = -0.610887057711
-    const double c3 = -0.610887057711;
-
-    const double A  = 0.0311;
-    const double B  = -0.048;
-    const double b1 = 1.0529;
-    const double b2 = 0.3334;
-    const double G  = -0.1423;
-
-    // C from the PZ paper: const double C  =  0.0020;
-    // D from the PZ paper: const double D  = -0.0116;
-    // C and D by matching Ec and Vc at rs=1
-    const double D = G / (1.0 + b1 + b2) - B;
-    const double C
-        = -A - D - G * ((b1 / 2.0 + b2) / ((1.0 + b1 + b2) * (1.0 + b1 + b2)));
-
-    if (rh > 0.0)
-    {
-        const double ro13 = cbrt(rh);
-        const double rs   = c1 / ro13;
-
-        // Next line : exchange part in Hartree units
-        const double vx = c3 / rs;
-        const double ex = 0.75 * vx;
-
-        // Next lines : Ceperley & Alder correlation (Zunger & Perdew)
-        double ec = 0.0, vc = 0.0;
-        if (rs < 1.0)
-        {
-            const double logrs = log(rs);
-            ec                 = A * logrs + B + C * rs * logrs + D * rs;
-            vc = A * logrs + (B - A * onethird) + (twothird)*C * rs * logrs
-                 + ((2.0 * D - C) * onethird) * rs;
-        }
-        else
-        {
-            const double sqrtrs  = sqrt(rs);
-            const double den     = 1.0 + b1 * sqrtrs + b2 * rs;
-            const double inv_den = 1. / den;
-            ec                   = G * inv_den;
-            vc = ec * (1.0 + sevensixth * b1 * sqrtrs + fourthird * b2 * rs)
-                 * inv_den;
-        }
-        ee = (POTDTYPE)(ex + ec);
-        vv = (POTDTYPE)(vx + vc);
-    }
-    else
-    {
-        ee = 0.;
-        vv = 0.;
-    }
-}
-
-void LDAFunctional::xc_polarized(const RHODTYPE rh, POTDTYPE& ee, POTDTYPE& vv)
-{
-    // compute LDA polarized XC energy and potential
-
-    // const double third=1.0/3.0;
-    // c1 is (3.D0/(4.D0*pi))**third
-    const double c1 = 0.6203504908994001;
-    // alpha = (4/(9*pi))**third = 0.521061761198
-    // const double alpha = 0.521061761198;
-    // c2 = -(3/(4*pi)) / alpha = -0.458165293283
-    // const double c2 = -0.458165293283;
-    // c3 = (4/3) * c2 = -0.610887057711
-    // const double c3 = -0.610887057711;
-    // c4 = 2**third * c3
-    const double c4 = -0.769669463118;
-
-    const double A  = 0.01555;
-    const double B  = -0.0269;
-    const double b1 = 1.3981;
-    const double b2 = 0.2611;
-    const double G  = -0.0843;
-    // C from PZ paper: const double C   =  0.0007;
-    // D from PZ paper: const double D   = -0.0048;
-    // C and D by matching Ec and Vc at rs=1
-    const double D = G / (1.0 + b1 + b2) - B;
-    const double C
-        = -A - D - G * ((b1 / 2.0 + b2) / ((1.0 + b1 + b2) * (1.0 + b1 + b2)));
-
-    ee = 0.0;
-    vv = 0.0;
-
-    if (rh > 0.0)
-    {
-        double ro13 = cbrt(rh);
-        double rs   = c1 / ro13;
-
-        double ex = 0.0, vx = 0.0, ec = 0.0, vc = 0.0;
-
-        // Next line : exchange part in Hartree units
-        vx = c4 / rs;
-        ex = 0.75 * vx;
-
-        // Next lines : Ceperley & Alder correlation (Zunger & Perdew)
-        if (rs < 1.0)
-        {
-            double logrs = log(rs);
-            ec           = A * logrs + B + C * rs * logrs + D * rs;
-            vc = A * logrs + (B - A * onethird) + (twothird)*C * rs * logrs
-                 + ((2.0 * D - C) * onethird) * rs;
-        }
-        else
-        {
-            double sqrtrs = sqrt(rs);
-            double den    = 1.0 + b1 * sqrtrs + b2 * rs;
-            ec            = G / den;
-            vc = ec * (1.0 + sevensixth * b1 * sqrtrs + (fourthird)*b2 * rs)
-                 / den;
-        }
-        ee = (POTDTYPE)(ex + ec);
-        vv = (POTDTYPE)(vx + vc);
-    }
-}
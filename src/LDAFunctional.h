@@ -19,8 +19,6 @@
 
 class LDAFunctional : public XCFunctional
 {
-    void xc_unpolarized(RHODTYPE rh, POTDTYPE& ee, POTDTYPE& vv);
-    void xc_polarized(RHODTYPE rh, POTDTYPE& ee, POTDTYPE& vv);
     std::vector<POTDTYPE> exc_;
     std::vector<std::vector<POTDTYPE>> vxc_;
 
@@ -1514,6 +1514,14 @@ void LocGridOrbitals::getLocalOverlap(
 #ifdef USE_MP
         getLocalOverlap(*this, ss);
 #else
+        // use block-sparse product if some colors have no data in
+        // some subdomains
+        if (hasInactiveColors())
+        {
+            getLocalOverlap(*this, ss);
+            return;
+        }
+
         const ORBDTYPE* const psi = block_vector_.vect(0);
 
         for (short iloc = 0; iloc < subdivx_; iloc++)
@@ -1587,8 +1595,17 @@ void LocGridOrbitals::computeLocalProduct(const ORBDTYPE* const array,
 #else
     LocalMatrices<ORBDTYPE, MemorySpace::Host>& ssf(ss);
 #endif
+    // a holds the orbitals of this object only if !transpose
+    const bool sparse = (!transpose && ss.m() == chromatic_number_
+                         && ss.n() == chromatic_number_);
     for (short iloc = 0; iloc < subdivx_; iloc++)
     {
+        if (sparse
+            && computeLocalProductSparse(iloc,
+                   a_host_view + iloc * loc_numpt_, lda,
+                   b_host_view + iloc * loc_numpt_, ldb, 1., ssf))
+            continue;
+
         ssf.gemm(iloc, loc_numpt_, a_host_view + iloc * loc_numpt_, lda,
             b_host_view + iloc * loc_numpt_, ldb);
     }
@@ -1603,6 +1620,51 @@ void LocGridOrbitals::computeLocalProduct(const ORBDTYPE* const array,
     ss.scal(grid_.vel());
 }
 
+void LocGridOrbitals::getActiveColors(
+    const short iloc, std::vector<int>& colors) const
+{
+    assert(iloc < static_cast<int>(overlapping_gids_.size()));
+
+    colors.clear();
+    for (int color = 0; color < chromatic_number_; color++)
+        if (overlapping_gids_[iloc][color] != -1) colors.push_back(color);
+}
+
+bool LocGridOrbitals::hasInactiveColors() const
+{
+    if (overlapping_gids_.empty()) return false;
+
+    for (short iloc = 0; iloc < subdivx_; iloc++)
+        for (int color = 0; color < chromatic_number_; color++)
+            if (overlapping_gids_[iloc][color] == -1) return true;
+
+    return false;
+}
+
+// Compute c = alpha * a^T * b (chromatic_number_ x chromatic_number_)
+// for subdomain iloc, where a holds the orbitals of this object: the
+// columns of a for colors without data in that subdomain are zero, so only
+// the rows of c associated with active colors are computed, using all the
+// columns of b (b = H*phi, for instance, may extend beyond the mask).
+// Returns false (and does nothing) if all the colors are active.
+template <typename T>
+bool LocGridOrbitals::computeLocalProductSparse(const short iloc,
+    const ORBDTYPE* const a, const int lda, const ORBDTYPE* const b,
+    const int ldb, const double alpha,
+    LocalMatrices<T, MemorySpace::Host>& c) const
+{
+    if (overlapping_gids_.empty()) return false;
+
+    std::vector<int> colors;
+    getActiveColors(iloc, colors);
+
+    if (static_cast<int>(colors.size()) == chromatic_number_) return false;
+
+    c.gemmRows(iloc, loc_numpt_, colors, alpha, a, lda, b, ldb);
+
+    return true;
+}
+
 void LocGridOrbitals::computeDiagonalElementsDotProduct(
     const LocGridOrbitals& orbitals, std::vector<DISTMATDTYPE>& ss)
 {
@@ -2514,9 +2576,13 @@ void LocGridOrbitals::addDotWithNcol2Matrix(
 
     for (short iloc = 0; iloc < subdivx_; iloc++)
     {
+        if (computeLocalProductSparse(iloc,
+                block_vector_.vect(0) + iloc * loc_numpt_, lda_,
+                Apsi.getPsi(0, iloc), lda_, vel, ss))
+            continue;
+
         MATDTYPE* ssiloc = ss.getRawPtr(iloc);
 
-        // TODO
         MPgemmTN(chromatic_number_, chromatic_number_, loc_numpt_, vel,
             block_vector_.vect(0) + iloc * loc_numpt_, lda_,
             Apsi.getPsi(0, iloc), lda_, 0., ssiloc, chromatic_number_);
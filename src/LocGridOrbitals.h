@@ -135,6 +135,14 @@ private:
         LocalMatrices<MATDTYPE, MemorySpace::Host>&,
         const bool transpose = false);
 
+    // colors with data in subdomain iloc
+    void getActiveColors(const short iloc, std::vector<int>& colors) const;
+    bool hasInactiveColors() const;
+    template <typename T>
+    bool computeLocalProductSparse(const short iloc, const ORBDTYPE* const a,
+        const int lda, const ORBDTYPE* const b, const int ldb,
+        const double alpha, LocalMatrices<T, MemorySpace::Host>& c) const;
+
     void computeGlobalIndexes(std::shared_ptr<LocalizationRegions> lrs);
     void computeInvNorms2(std::vector<std::vector<double>>& inv_norms2) const;
     void computeDiagonalGram(VariableSizeMatrix<sparserow>& diagS) const;
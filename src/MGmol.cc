@@ -17,6 +17,7 @@
 #include "ABPG.h"
 #include "AOMMprojector.h"
 #include "AndersonMix.h"
+#include "AsyncFileWriter.h"
 #include "ConstraintSet.h"
 #include "Control.h"
 #include "DFTsolver.h"
@@ -54,6 +55,7 @@
 #include "Power.h"
 #include "PowerGen.h"
 #include "Preconditioning.h"
+#include "Profiler.h"
 #include "ProjectedMatricesMehrstellen.h"
 #include "ProjectedMatricesSparse.h"
 #include "ReplicatedMatrix.h"
@@ -66,6 +68,7 @@
 #include "SpreadsAndCenters.h"
 #include "SubMatrices.h"
 #include "SubspaceProjector.h"
+#include "Vcycle.h"
 #include "XCfunctionalFactory.h"
 #include "XConGrid.h"
 #include "manage_memory.h"
@@ -183,6 +186,7 @@ int MGmol<OrbitalsType>::initial()
     pb::Lap<ORBDTYPE>* lapop
         = ct.Mehrstellen() ? hamiltonian_->lapOper() : nullptr;
     g_kbpsi_.reset(new KBPsiMatrixSparse(lapop));
+    applyH_kbpsi_.reset(new KBPsiMatrixSparse(lapop));
 
     check_anisotropy();
 
@@ -420,6 +424,7 @@ int MGmol<OrbitalsType>::initial()
 
     if (ct.verbose > 0) printWithTimeStamp("Setup kbpsi...", os_);
     g_kbpsi_->setup(*ions_);
+    applyH_kbpsi_->setup(*ions_);
 
     if (ct.restart_info == 0)
     {
@@ -878,8 +883,11 @@ void MGmol<OrbitalsType>::printTimers()
     pb::printMGkernelTimers(os_);
     pb::printFDkernelTimers(os_);
     pb::FDoperInterface::printTimers(os_);
+    pb::VcycleControl::printTimers(os_);
     OrbitalsType::printTimers(os_);
     SinCosOps<OrbitalsType>::printTimers(os_);
+    ChebyshevFilterDMStrategy<OrbitalsType,
+        dist_matrix::DistMatrix<DISTMATDTYPE>>::printTimers(os_);
     GridMask::printTimers(os_);
 
     sgemm_tm.print(os_);
@@ -957,11 +965,14 @@ void MGmol<OrbitalsType>::printTimers()
     dump_tm_.print(os_);
     setup_tm_.print(os_);
     HDFrestart::printTimers(os_);
+    AsyncFileWriter::printTimers(os_);
 #ifdef HAVE_MAGMA
     PowerGen<ReplicatedMatrix, ReplicatedVector>::printTimers(os_);
     BlockVector<ORBDTYPE, MemorySpace::Device>::printTimers(os_);
     DavidsonSolver<ExtendedGridOrbitals, ReplicatedMatrix>::printTimers(os_);
     ChebyshevApproximation<ReplicatedMatrix>::printTimers(os_);
+    ChebyshevFilterDMStrategy<ExtendedGridOrbitals,
+        ReplicatedMatrix>::printTimers(os_);
 #endif
     PowerGen<dist_matrix::DistMatrix<double>,
         dist_matrix::DistVector<double>>::printTimers(os_);
@@ -973,6 +984,16 @@ void MGmol<OrbitalsType>::printTimers()
     OrbitalsPreconditioning<OrbitalsType>::printTimers(os_);
     MDfiles::printTimers(os_);
     ChebyshevApproximationInterface::printTimers(os_);
+
+    // hierarchical profiling data
+    if (Profiler::enabled())
+    {
+        const std::string prefix(ct.getFullFilename(ct.profile_output));
+        Profiler::instance().write(prefix, comm_);
+        if (onpe0)
+            os_ << "Profiling data written in " << prefix << ".json"
+                << std::endl;
+    }
 }
 
 template <class OrbitalsType>
@@ -1067,6 +1088,10 @@ void MGmol<OrbitalsType>::setup()
     if (ct.verbose > 0)
         printWithTimeStamp("MGmol<OrbitalsType>::setup()...", os_);
 
+    pb::GridFuncInterface::setPersistentComm(ct.persistentHaloComm());
+    pb::VcycleControl::setAgglomerationMinPoints(
+        ct.poisson_agglomeration_min_points);
+
     if (ct.verbose > 0) printWithTimeStamp("Setup VH...", os_);
     electrostat_ = std::shared_ptr<Electrostatic>(new Electrostatic(
         ct.getPoissonFDtype(), ct.bcPoisson, ct.screening_const));
@@ -1074,6 +1099,7 @@ void MGmol<OrbitalsType>::setup()
 
     rho_ = std::shared_ptr<Rho<OrbitalsType>>(new Rho<OrbitalsType>());
     rho_->setVerbosityLevel(ct.verbose);
+    rho_->setAccumulationType(ct.RhoAccumulation());
 
 #ifdef HAVE_MAGMA
     int ierr = initial<MemorySpace::Device>();
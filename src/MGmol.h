@@ -38,6 +38,7 @@ class MasksSet;
 
 template <class OrbitalsType>
 class IonicAlgorithm;
+class AsyncFileWriter;
 
 #include "AOMMprojector.h"
 #include "ClusterOrbitals.h"
@@ -92,6 +93,9 @@ private:
 
     std::shared_ptr<KBPsiMatrixSparse> g_kbpsi_;
 
+    // <KB|phi> for temporary orbitals phi in applyH()
+    std::shared_ptr<KBPsiMatrixSparse> applyH_kbpsi_;
+
     std::shared_ptr<SpreadsAndCenters<OrbitalsType>> spreadf_;
 
     std::shared_ptr<SpreadPenaltyInterface<OrbitalsType>> spread_penalty_;
@@ -100,6 +104,9 @@ private:
 
     std::shared_ptr<HDFrestart> h5f_file_;
 
+    // background writer for MD restart files
+    std::shared_ptr<AsyncFileWriter> restart_writer_;
+
     std::shared_ptr<OrbitalsPreconditioning<OrbitalsType>> orbitals_precond_;
 
     double total_energy_;
@@ -287,6 +294,8 @@ public:
     void getHpsiAndTheta(Ions& ions, OrbitalsType& phi, OrbitalsType& hphi,
         const KBPsiMatrixSparse* const kbpsi);
     void getHpsiAndTheta(Ions& ions, OrbitalsType& phi, OrbitalsType& hphi);
+    // hphi = H*phi, without updating projected matrices
+    void applyH(Ions& ions, OrbitalsType& phi, OrbitalsType& hphi);
     double computePrecondResidual(OrbitalsType& phi, OrbitalsType& hphi,
         OrbitalsType& res, Ions& ions, KBPsiMatrixSparse* kbpsi,
         const bool print_residual, const bool norm_res);
@@ -18,7 +18,9 @@ class Ions;
 class KBPsiMatrixSparse;
 
 void get_vnlpsi(const Ions& ions, const std::vector<std::vector<int>>&,
-    const int, const KBPsiMatrixSparse* const kbpsi, ORBDTYPE* const);
+    const KBPsiMatrixSparse* const kbpsi, ORBDTYPE* const);
+void add_vnlpsi(const Ions& ions, const std::vector<std::vector<int>>&,
+    const KBPsiMatrixSparse* const kbpsi, const std::vector<ORBDTYPE*>&);
 double getLAeigen(const double tol, const int maxit, Ions& ions);
 int read_config(int argc, char** argv,
     boost::program_options::variables_map& vm, std::string& input_file,
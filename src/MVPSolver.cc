@@ -357,7 +357,8 @@ int MVPSolver<OrbitalsType, MatrixType>::solve(OrbitalsType& orbitals)
             = dynamic_cast<ProjectedMatrices<MatrixType>*>(
                 orbitals.getProjMatrices());
         projmatrices->setDM(*work_, orbitals.getIterativeIndex());
-        projmatrices->setEigenvalues(proj_mat_work_->getEigenvalues());
+        projmatrices->setEigenvalues(proj_mat_work_->getEigenvalues(),
+            proj_mat_work_->getNumEigenvalues());
         projmatrices->assignH(proj_mat_work_->getH());
         projmatrices->setHB2H();
     }
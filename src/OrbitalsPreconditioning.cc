@@ -66,6 +66,9 @@ void OrbitalsPreconditioning<T>::setup(T& orbitals, const short mg_levels,
     else
         map2masks_ = nullptr;
 
+    pb::GridFuncVector<MGPRECONDTYPE, memory_space_type>::setOverlapComm(
+        ct.overlapHaloComm());
+
     precond_->setup(orbitals.getOverlappingGids());
 
     assert(orbitals.chromatic_number()
@@ -26,17 +26,6 @@ class PBEFunctional : public XCFunctional
         vxc2_updn_, vxc2_dnup_, vxc2_dndn_;
     std::vector<RHODTYPE> grad_rho_[3], grad_rho_up_[3], grad_rho_dn_[3];
 
-    void gcor2(double a, double a1, double b1, double b2, double b3, double b4,
-        double rtrs, double* gg, double* ggrs);
-
-    void excpbe(const RHODTYPE rho, const RHODTYPE grad, POTDTYPE* exc,
-        POTDTYPE* vxc1, POTDTYPE* vxc2);
-
-    void excpbe_sp(RHODTYPE rho_up, RHODTYPE rho_dn, RHODTYPE grad_up,
-        RHODTYPE grad_dn, RHODTYPE grad, POTDTYPE* exc_up, POTDTYPE* exc_dn,
-        POTDTYPE* vxc1_up, POTDTYPE* vxc1_dn, POTDTYPE* vxc2_upup,
-        POTDTYPE* vxc2_dndn, POTDTYPE* vxc2_updn, POTDTYPE* vxc2_dnup);
-
     RHODTYPE* pgrad_rho_[3];
     RHODTYPE* pgrad_rho_up_[3];
     RHODTYPE* pgrad_rho_dn_[3];
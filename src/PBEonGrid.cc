@@ -42,19 +42,16 @@ void PBEonGrid<T>::update()
     pb::GridFunc<RHODTYPE> gf_tmp(newGrid, ct.bcWF[0], ct.bcWF[1], ct.bcWF[2]);
     std::vector<RHODTYPE> tmp(np_);
 
-    std::vector<std::vector<double>> grad;
+    std::vector<std::vector<RHODTYPE>> grad;
     grad.resize(3);
     for (int i = 0; i < 3; i++)
         grad[i].resize(np_);
 
-    // compute grad rho
+    // compute grad rho, all directions in one pass
+    myoper_del[0]->grad_4th(gf_rho, grad[0].data(), grad[1].data(),
+        grad[2].data());
     for (int i = 0; i < 3; i++)
-    {
-        myoper_del[i]->apply(gf_rho, gf_tmp);
-        // convert gf_tmp back into double*
-        gf_tmp.init_vect(grad[i].data(), 'd');
         pbe_->setGradRho(i, grad[i].data());
-    }
 
     const int iterative_index = rho_.getIterativeIndex();
 
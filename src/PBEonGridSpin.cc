@@ -68,15 +68,14 @@ void PBEonGridSpin<T>::update()
     }
 
     pb::GridFunc<RHODTYPE> gf_tmp(newGrid, ct.bcWF[0], ct.bcWF[1], ct.bcWF[2]);
-    // compute grad rho, one direction at a time
+    // compute grad rho, all directions in one pass for each spin
+    for (short is = 0; is < 2; is++)
+    {
+        myoper_del[0]->grad_4th(*gf_rho[is], grad_rho[is][0].data(),
+            grad_rho[is][1].data(), grad_rho[is][2].data());
+    }
     for (short dir = 0; dir < 3; dir++)
     {
-        for (short is = 0; is < 2; is++)
-        {
-            myoper_del[dir]->apply(*gf_rho[is], gf_tmp);
-            // convert gf_tmp back into RHODTYPE*
-            gf_tmp.init_vect(grad_rho[is][dir].data(), 'd');
-        }
         pbe_->setGradRhoUp(dir, grad_rho[0][dir].data());
         pbe_->setGradRhoDn(dir, grad_rho[1][dir].data());
     }
@@ -29,6 +29,16 @@
 
 class PoissonSolverFactory
 {
+    // Hartree solver with FD operator OpType, in double or mixed precision
+    template <template <typename> class OpType>
+    static Poisson* createHartree(const pb::Grid& myGrid, const short bc[3])
+    {
+        Control& ct = *(Control::instance());
+        if (ct.mixedPrecisionPoisson())
+            return new Hartree<OpType<POTDTYPE>, OpType<float>>(myGrid, bc);
+        else
+            return new Hartree<OpType<POTDTYPE>>(myGrid, bc);
+    }
 
 public:
     /*!
@@ -62,28 +72,22 @@ public:
                 switch (lap_type)
                 {
                     case PoissonFDtype::h4M:
-                        poisson_solver
-                            = new Hartree<pb::Laph4M<POTDTYPE>>(myGrid, bc);
+                        poisson_solver = createHartree<pb::Laph4M>(myGrid, bc);
                         break;
                     case PoissonFDtype::h2:
-                        poisson_solver
-                            = new Hartree<pb::Laph2<POTDTYPE>>(myGrid, bc);
+                        poisson_solver = createHartree<pb::Laph2>(myGrid, bc);
                         break;
                     case PoissonFDtype::h4:
-                        poisson_solver
-                            = new Hartree<pb::Laph4<POTDTYPE>>(myGrid, bc);
+                        poisson_solver = createHartree<pb::Laph4>(myGrid, bc);
                         break;
                     case PoissonFDtype::h6:
-                        poisson_solver
-                            = new Hartree<pb::Laph6<POTDTYPE>>(myGrid, bc);
+                        poisson_solver = createHartree<pb::Laph6>(myGrid, bc);
                         break;
                     case PoissonFDtype::h8:
-                        poisson_solver
-                            = new Hartree<pb::Laph8<POTDTYPE>>(myGrid, bc);
+                        poisson_solver = createHartree<pb::Laph8>(myGrid, bc);
                         break;
                     case PoissonFDtype::h4MP:
-                        poisson_solver
-                            = new Hartree<pb::Laph4MP<POTDTYPE>>(myGrid, bc);
+                        poisson_solver = createHartree<pb::Laph4MP>(myGrid, bc);
                         break;
                     default:
                         (*MPIdata::sout)
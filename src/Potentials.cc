@@ -24,6 +24,7 @@
 #include "TriCubic.h"
 #include "mputils.h"
 
+#include <cmath>
 #include <fstream>
 using namespace std;
 
@@ -722,57 +723,129 @@ void Potentials::initializeSupersampledRadialDataOnMesh(
     */
 }
 
-void Potentials::initializeRadialDataOnMesh(
-    const Vector3D& position, const Species& sp)
+namespace
+{
+// Displacements between an atom and the grid points of the local subdomain
+// along one direction (using minimum image convention if periodic).
+// Points further than lrad are set to HUGE_VAL.
+void getDisplacements(const double position, const double lrad,
+    const double start, const double h, const int dim, const double lattice,
+    const short bc, std::vector<double>& displacements)
+{
+    displacements.resize(dim);
+    for (int i = 0; i < dim; i++)
+    {
+        double d = position - (start + i * h);
+        if (bc == 1) d = remainder(d, lattice);
+        displacements[i] = (std::abs(d) < lrad) ? d : HUGE_VAL;
+    }
+}
+
+// indexes of finite values in displacements
+void getIndexesInRange(
+    const std::vector<double>& displacements, std::vector<int>& indexes)
+{
+    indexes.clear();
+    for (unsigned int i = 0; i < displacements.size(); i++)
+        if (displacements[i] != HUGE_VAL) indexes.push_back(i);
+}
+}
+
+// Add radial data (compensating charges and potentials, local potential)
+// of ions to values on mesh.
+// For each ion, only the grid points within the bounding box of radius
+// lradius() are visited.
+// Threads work on disjoint planes of the mesh, so that contributions of
+// all the ions are accumulated in the same order for each grid point.
+void Potentials::initializeRadialDataOnMesh(const std::vector<Ion*>& ions)
 {
     Control& ct = *(Control::instance());
 
     Mesh* mymesh           = Mesh::instance();
     const pb::Grid& mygrid = mymesh->grid();
 
-    const int dim0 = mygrid.dim(0);
-    const int dim1 = mygrid.dim(1);
-    const int dim2 = mygrid.dim(2);
-
-    const double start0 = mygrid.start(0);
-    const double start1 = mygrid.start(1);
-    const double start2 = mygrid.start(2);
-
-    const double h0 = mygrid.hgrid(0);
-    const double h1 = mygrid.hgrid(1);
-    const double h2 = mygrid.hgrid(2);
-
-    Vector3D point(0., 0., 0.);
-
-    const double lrad = sp.lradius();
-
-    const RadialInter& lpot(sp.local_pot());
-    const Vector3D lattice(mygrid.ll(0), mygrid.ll(1), mygrid.ll(2));
-
-    int offset = 0;
-    for (int ix = 0; ix < dim0; ix++)
+    const int dim[3] = { static_cast<int>(mygrid.dim(0)),
+        static_cast<int>(mygrid.dim(1)), static_cast<int>(mygrid.dim(2)) };
+    const int nions = static_cast<int>(ions.size());
+
+    // displacements for each ion and direction
+    std::vector<std::vector<double>> displacements[3];
+    // indexes of points within range in directions 1 and 2
+    std::vector<std::vector<int>> indexes[2];
+    for (short dir = 0; dir < 3; dir++)
+        displacements[dir].resize(nions);
+    for (short dir = 0; dir < 2; dir++)
+        indexes[dir].resize(nions);
+
+#pragma omp parallel for
+    for (int ia = 0; ia < nions; ia++)
     {
-        point[0] = start0 + ix * h0;
-
-        for (int iy = 0; iy < dim1; iy++)
+        const Species& sp(ions[ia]->getSpecies());
+        const double lrad = sp.lradius();
+        for (short dir = 0; dir < 3; dir++)
         {
-            point[1] = start1 + iy * h1;
+            getDisplacements(ions[ia]->position(dir), lrad, mygrid.start(dir),
+                mygrid.hgrid(dir), dim[dir], mygrid.ll(dir), ct.bcPoisson[dir],
+                displacements[dir][ia]);
+            if (dir > 0)
+                getIndexesInRange(
+                    displacements[dir][ia], indexes[dir - 1][ia]);
+        }
+    }
 
-            for (int iz = 0; iz < dim2; iz++)
+    const int incx = dim[1] * dim[2];
+#pragma omp parallel
+    {
+        // radii and indexes of points within range along a line,
+        // and interpolated local potential
+        std::vector<double> radii(dim[2]);
+        std::vector<int> iz_in(dim[2]);
+        std::vector<double> vloc(dim[2]);
+
+#pragma omp for
+        for (int ix = 0; ix < dim[0]; ix++)
+        {
+            for (int ia = 0; ia < nions; ia++)
             {
-                point[2] = start2 + iz * h2;
+                const double x0 = displacements[0][ia][ix];
+                if (x0 == HUGE_VAL) continue;
 
-                const double r
-                    = position.minimage(point, lattice, ct.bcPoisson);
+                const Species& sp(ions[ia]->getSpecies());
+                const double lrad = sp.lradius();
+                const RadialInter& lpot(sp.local_pot());
 
-                if (r < lrad)
+                const std::vector<double>& dy(displacements[1][ia]);
+                const std::vector<double>& dz(displacements[2][ia]);
+                for (auto iy : indexes[0][ia])
                 {
-                    rho_comp_[offset] += sp.getRhoComp(r);
-                    v_comp_[offset] += sp.getVcomp(r);
-                    v_nuc_[offset] += lpot.cubint(r);
+                    const double x1  = dy[iy];
+                    const int offset = ix * incx + iy * dim[2];
+
+                    int n = 0;
+                    for (auto iz : indexes[1][ia])
+                    {
+                        const double x2 = dz[iz];
+                        const double r = std::sqrt(x0 * x0 + x1 * x1 + x2 * x2);
+                        if (r < lrad)
+                        {
+                            radii[n] = r;
+                            iz_in[n] = iz;
+                            n++;
+                        }
+                    }
+
+                    lpot.cubint(n, radii.data(), vloc.data());
+
+                    for (int i = 0; i < n; i++)
+                    {
+                        const double r = radii[i];
+                        const int k    = offset + iz_in[i];
+
+                        rho_comp_[k] += sp.getRhoComp(r);
+                        v_comp_[k] += sp.getVcomp(r);
+                        v_nuc_[k] += vloc[i];
+                    }
                 }
-
-                offset++;
             }
         }
     }
@@ -791,15 +864,16 @@ void Potentials::initialize(Ions& ions)
 
     char flag_filter = pot_type(0);
 
-    // Loop over ions
-    for (auto& ion : ions.overlappingVL_ions())
+    if (flag_filter == 's')
     {
-        const Species& sp(ion->getSpecies());
+        // Loop over ions
+        for (auto& ion : ions.overlappingVL_ions())
+        {
+            const Species& sp(ion->getSpecies());
 
-        Vector3D position(ion->position(0), ion->position(1), ion->position(2));
+            Vector3D position(
+                ion->position(0), ion->position(1), ion->position(2));
 
-        if (flag_filter == 's')
-        {
             const int sampleRate  = 3;
             const int numExtraPts = 40;
             const std::array<double, 3> coarGridSpace
@@ -808,10 +882,10 @@ void Potentials::initialize(Ions& ions)
 
             initializeSupersampledRadialDataOnMesh(position, sp);
         }
-        else
-        {
-            initializeRadialDataOnMesh(position, sp);
-        }
+    }
+    else
+    {
+        initializeRadialDataOnMesh(ions.overlappingVL_ions());
     }
 }
 
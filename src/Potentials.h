@@ -18,6 +18,7 @@
 #include <string>
 #include <vector>
 
+class Ion;
 class Ions;
 class Species;
 template <class T>
@@ -90,8 +91,7 @@ class Potentials
 
     void evalNormDeltaVtotRho(const std::vector<std::vector<RHODTYPE>>& rho);
 
-    void initializeRadialDataOnMesh(
-        const Vector3D& position, const Species& sp);
+    void initializeRadialDataOnMesh(const std::vector<Ion*>& ions);
     void initializeSupersampledRadialDataOnMesh(
         const Vector3D& position, const Species& sp);
 
@@ -27,6 +27,7 @@
 #include "SquareSubMatrix2DistMatrix.h"
 #include "fermi.h"
 
+#include <cmath>
 #include <fstream>
 #include <iomanip>
 
@@ -113,6 +114,7 @@ ProjectedMatrices<MatrixType>::ProjectedMatrices(
     }
 
     eigenvalues_.resize(dim_);
+    num_eigenvalues_ = dim_;
 
     matH_.reset(new MatrixType("H", ndim, ndim));
     matHB_.reset(new MatrixType("HB", ndim, ndim));
@@ -274,8 +276,8 @@ void ProjectedMatrices<MatrixType>::setDMto2InvS()
 }
 
 template <class MatrixType>
-void ProjectedMatrices<MatrixType>::solveGenEigenProblem(
-    MatrixType& z, char job)
+int ProjectedMatrices<MatrixType>::solveGenEigenProblem(
+    MatrixType& z, char job, const int nev)
 {
     sygv_tm_.start();
 
@@ -285,13 +287,22 @@ void ProjectedMatrices<MatrixType>::solveGenEigenProblem(
     gm_->sygst(mat);
 
     // solve a standard symmetric eigenvalue problem
-    mat.syev(job, 'l', eigenvalues_, z);
+    int neig = dim_;
+    if (nev > 0)
+    {
+        neig = mat.syev(job, 'l', nev, eigenvalues_, z);
+    }
+    else
+        mat.syev(job, 'l', eigenvalues_, z);
+    num_eigenvalues_ = neig;
 
     // Get the eigenvectors Z of the generalized eigenvalue problem
     // Solve Z=L**(-T)*U
     gm_->solveLST(z);
 
     sygv_tm_.stop();
+
+    return neig;
 }
 
 template <class MatrixType>
@@ -371,10 +382,14 @@ void ProjectedMatrices<MatrixType>::updateDMwithEigenstates(
 
     MatrixType zz("Z", dim_, dim_);
 
+    // only the occupied states and the empty states requested in input
+    // contribute to the DM
+    const int nev = static_cast<int>(std::ceil(nel_)) + ct.getNempty();
+
     // solves generalized eigenvalue problem
     // and return solution in zz and val
-    solveGenEigenProblem(zz);
-    computeChemicalPotentialAndOccupations();
+    const int neig = solveGenEigenProblem(zz, 'v', nev);
+    computeChemicalPotentialAndOccupations(width_, neig);
     if (mmpi.instancePE0() && ct.verbose > 1)
         std::cout << "Final mu_ = " << 0.5 * mu_ << " [Ha]" << std::endl;
 
@@ -862,7 +877,7 @@ void ProjectedMatrices<MatrixType>::printEigenvaluesEV(std::ostream& os) const
         os.setf(std::ios::right, std::ios::adjustfield);
         os.setf(std::ios::fixed, std::ios::floatfield);
         os << std::setprecision(3);
-        for (unsigned int i = 0; i < dim_; i++)
+        for (int i = 0; i < num_eigenvalues_; i++)
         {
             if ((i % 10) == 0) os << std::endl;
             os << std::setw(7) << RY2EV * eigenvalues_[i] << " ";
@@ -888,7 +903,7 @@ void ProjectedMatrices<MatrixType>::printEigenvaluesHa(std::ostream& os) const
         os.setf(std::ios::right, std::ios::adjustfield);
         os.setf(std::ios::fixed, std::ios::floatfield);
         os << std::setprecision(3);
-        for (unsigned int i = 0; i < dim_; i++)
+        for (int i = 0; i < num_eigenvalues_; i++)
         {
             if ((i % 10) == 0) os << std::endl;
             os << std::setw(7) << 0.5 * eigenvalues_[i] << " ";
@@ -917,10 +932,13 @@ void ProjectedMatrices<MatrixType>::computeChemicalPotentialAndOccupations(
             << "computeChemicalPotentialAndOccupations() with width=" << width
             << ", for " << nel_ << " electrons" << std::endl;
 
-    std::vector<DISTMATDTYPE> occ(dim_, 0.);
+    std::vector<DISTMATDTYPE> occ(energies.size(), 0.);
 
     mu_ = compute_chemical_potential_and_occupations(
         energies, width, nel_, max_numst, mmpi.instancePE0(), occ);
+
+    // states without computed eigenvalue are empty
+    occ.resize(dim_, 0.);
     // if( mmpi.instancePE0() )
     //    (*MPIdata::sout)<<"computeChemicalPotentialAndOccupations() with mu="
     //        <<mu<<std::endl;
@@ -1118,11 +1136,11 @@ ProjectedMatrices<MatrixType>::computeChemicalPotentialAndDMwithChebyshev(
     */
     //// end print
 
+    // Chebyshev polynomials of S^{-1}H and their traces are computed once.
+    // The number of electrons for a given mu_ is then evaluated from the
+    // Chebyshev coefficients and these traces only
     chebapp.buildChebyshevNodes(emin, emax, mat);
 
-    MatrixType tmp("TMP", dim_, dim_);
-    MatrixType dm("DM", dim_, dim_);
-
     if (mmpi.instancePE0() && ct.verbose > 0)
         std::cout << "emin = " << emin << " emax = " << emax << std::endl;
 
@@ -1132,12 +1150,8 @@ ProjectedMatrices<MatrixType>::computeChemicalPotentialAndDMwithChebyshev(
         mu_ = mu2;
         chebapp.computeChebyshevCoeffs();
 
-        // compute Chebyshev approximation
-        dm.gemm('N', 'N', 1., chebapp.computeChebyshevApproximation(),
-            gm_->getInverse(), 0.);
-        tmp.gemm('N', 'N', 1., dm, gm_->getMatrix(), 0.);
         // compute trace and check convergence
-        f2 = tmp.trace() - nel_;
+        f2 = chebapp.computeChebyshevApproximationTrace() - nel_;
 
         // no unoccupied states
         if (std::abs(f2) < charge_tol)
@@ -1151,12 +1165,8 @@ ProjectedMatrices<MatrixType>::computeChemicalPotentialAndDMwithChebyshev(
         mu_ = mu1;
         chebapp.computeChebyshevCoeffs();
 
-        // compute Chebyshev approximation
-        dm.gemm('N', 'N', 1., chebapp.computeChebyshevApproximation(),
-            gm_->getInverse(), 0.);
-        tmp.gemm('N', 'N', 1., dm, gm_->getMatrix(), 0.);
         // compute trace and check convergence
-        f1 = tmp.trace() - nel_;
+        f1 = chebapp.computeChebyshevApproximationTrace() - nel_;
 
         // no unoccupied states
         if (std::abs(f1) < charge_tol)
@@ -1202,10 +1212,8 @@ ProjectedMatrices<MatrixType>::computeChemicalPotentialAndDMwithChebyshev(
             mu_ = mu_old + dmu;
 
             chebapp.computeChebyshevCoeffs();
-            // compute Chebyshev approximation
-            tmp = chebapp.computeChebyshevApproximation();
             // compute trace and check convergence
-            f = tmp.trace() - nel_;
+            f = chebapp.computeChebyshevApproximationTrace() - nel_;
             if (f <= 0.)
             {
                 mu_old = mu_;
@@ -1234,7 +1242,25 @@ ProjectedMatrices<MatrixType>::computeChemicalPotentialAndDMwithChebyshev(
     mu1 = mu_ - 10. * width_;
     mu2 = mu_ + 10. * width_;
 
+    // single evaluation of the matrix polynomial, for final mu_
+    chebapp.computeChebyshevCoeffs();
+    MatrixType tmp(chebapp.computeChebyshevApproximation());
+
+    // trace evaluated from Chebyshev moments should match trace of matrix
+    if (ct.verbose > 0)
+    {
+        const double trace_moments
+            = chebapp.computeChebyshevApproximationTrace();
+        const double trace_matrix = tmp.trace();
+        if (mmpi.instancePE0())
+            std::cout << "Chebyshev trace from moments = " << trace_moments
+                      << ", trace of matrix = " << trace_matrix
+                      << ", difference = " << trace_moments - trace_matrix
+                      << std::endl;
+    }
+
     // set density matrix
+    MatrixType dm("DM", dim_, dim_);
     dm.gemm('N', 'N', 1., tmp, gm_->getInverse(), 0.);
     double orbital_occupation = mmpi.nspin() > 1 ? 1. : 2.;
     dm.scal(orbital_occupation);
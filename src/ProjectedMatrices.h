@@ -20,6 +20,7 @@
 
 #include "hdf5.h"
 #include "tools.h"
+#include <algorithm>
 #include <iostream>
 
 template <class MatrixType>
@@ -35,6 +36,10 @@ class ProjectedMatrices : public ProjectedMatricesInterface
 
     std::vector<double> eigenvalues_;
 
+    // number of valid entries in eigenvalues_ (less than dim_ when only
+    // part of the spectrum was computed)
+    int num_eigenvalues_;
+
     /*!
      * matrices to save old values and enable mixing or reset
      */
@@ -282,7 +287,10 @@ public:
     double getExpectation(const MatrixType& A);
     double getExpectationH() override;
 
-    void solveGenEigenProblem(MatrixType& zz, char job = 'v');
+    // solve generalized eigenvalue problem for (at least) the nev lowest
+    // eigenpairs (all if nev<=0), return the number of eigenpairs computed
+    int solveGenEigenProblem(
+        MatrixType& zz, char job = 'v', const int nev = -1);
     void computeOccupationsFromDM();
 
     virtual void rotateAll(
@@ -323,7 +331,11 @@ public:
     void computeChemicalPotentialAndOccupations(
         const double width, const int max_numst)
     {
-        computeChemicalPotentialAndOccupations(eigenvalues_, width, max_numst);
+        // only the eigenvalues actually computed are used
+        const std::vector<double> energies(
+            eigenvalues_.begin(), eigenvalues_.begin() + num_eigenvalues_);
+        computeChemicalPotentialAndOccupations(
+            energies, width, std::min(max_numst, num_eigenvalues_));
     }
 
     void saveDM() override
@@ -411,10 +423,16 @@ public:
     }
     void setEigenvalues(const std::vector<double>& eigenvalues)
     {
-        memcpy(eigenvalues_.data(), eigenvalues.data(),
-            eigenvalues.size() * sizeof(double));
+        setEigenvalues(eigenvalues, eigenvalues.size());
+    }
+    void setEigenvalues(const std::vector<double>& eigenvalues, const int neig)
+    {
+        assert(neig <= static_cast<int>(eigenvalues_.size()));
+        memcpy(eigenvalues_.data(), eigenvalues.data(), neig * sizeof(double));
+        num_eigenvalues_ = neig;
     }
     const std::vector<double>& getEigenvalues() const { return eigenvalues_; }
+    int getNumEigenvalues() const { return num_eigenvalues_; }
     void computeGenEigenInterval(std::vector<double>& interval,
         const int maxits, const double padding = 0.01);
     DensityMatrix<MatrixType>& getDM() { return *dm_; }
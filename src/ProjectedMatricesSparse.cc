@@ -15,6 +15,7 @@
 #include "Control.h"
 #include "HDFrestart.h"
 #include "MGmol_MPI.h"
+#include "SP2Sparse.h"
 #include "VariableSizeMatrix.h"
 #include "random.h"
 #include "tools.h"
@@ -238,6 +239,54 @@ void ProjectedMatricesSparse::updateTheta()
     update_theta_tm_.stop();
 }
 
+void ProjectedMatricesSparse::updateDM(const int iterative_index)
+{
+    Control& ct = *(Control::instance());
+
+    if (ct.DMEigensolver() == DMEigensolverType::SP2)
+        updateDMwithSP2(iterative_index);
+    else
+        ProjectedMatricesInterface::updateDM(iterative_index);
+}
+
+// compute DM by SP2 purification of theta, keeping all the matrices
+// sparse and distributed
+void ProjectedMatricesSparse::updateDMwithSP2(const int iterative_index)
+{
+    assert(invS_ != nullptr);
+
+    Control& ct     = *(Control::instance());
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+
+    if (mmpi.instancePE0() && ct.verbose > 1)
+        std::cout << "ProjectedMatricesSparse: Compute DM using SP2"
+                  << std::endl;
+
+    updateThetaAndHB();
+
+    std::vector<double> interval;
+    computeGenEigenInterval(interval, ct.dm_approx_power_maxits, 0.05);
+
+    std::vector<int> locfcns;
+    (*lrs_).getLocalSubdomainIndices(locfcns);
+
+    Mesh* mymesh             = Mesh::instance();
+    const pb::Grid& mygrid   = mymesh->grid();
+    const pb::PEenv& myPEenv = mymesh->peenv();
+    double domain[3]         = { mygrid.ll(0), mygrid.ll(1), mygrid.ll(2) };
+    DataDistribution distributor("SP2", (*lrs_).max_radii(), myPEenv, domain);
+
+    SP2Sparse sp2(ct.dm_tol, ct.dm_drop_tol, locvars_, locfcns, distributor);
+    sp2.initialize(*submatT_, interval[0], interval[1]);
+    sp2.solve(ct.getNelSpin(), (ct.verbose > 1));
+
+    const double occupation = mmpi.nspin() > 1 ? 1. : 2.;
+    VariableSizeMatrix<sparserow> dm("DM", lsize_);
+    sp2.getDM(*invS_, occupation, dm);
+
+    dm_->setMatrix(dm, iterative_index);
+}
+
 double ProjectedMatricesSparse::getExpectationH()
 {
     assert(invS_ != nullptr);
@@ -530,6 +579,7 @@ void ProjectedMatricesSparse::printTimers(std::ostream& os)
     init_gram_matrix_tm_.print(os);
     eigsum_tm_.print(os);
     consolidate_H_tm_.print(os);
+    SP2Sparse::printTimers(os);
 }
 
 void ProjectedMatricesSparse::updateLocalMat(
@@ -97,6 +97,8 @@ class ProjectedMatricesSparse : public ProjectedMatricesInterface
     void computeGenEigenInterval(std::vector<double>& interval,
         const int maxits, const double padding = 0.01);
 
+    void updateDMwithSP2(const int iterative_index);
+
     double eigenvalue0_;
 
 public:
@@ -109,6 +111,7 @@ public:
 
     void updateSubMatT() override;
     void updateTheta() override;
+    void updateDM(const int iterative_index) override;
     double getExpectationH() override;
     void consolidateH() override;
     void consolidateOrbitalsOverlapMat(VariableSizeMatrix<sparserow>& mat);
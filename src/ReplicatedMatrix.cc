@@ -400,6 +400,49 @@ void ReplicatedMatrix::syev(
     // for(auto& d : evals)std::cout<<d<<std::endl;
 }
 
+int ReplicatedMatrix::syev(char jobz, char uplo, const int nev,
+    std::vector<double>& evals, ReplicatedMatrix& z)
+{
+    assert(nev > 0);
+    if (nev >= dim_)
+    {
+        syev(jobz, uplo, evals, z);
+        return dim_;
+    }
+
+    magma_vec_t magma_jobz  = magma_vec_const(jobz);
+    magma_uplo_t magma_uplo = magma_uplo_const(uplo);
+
+    auto& magma_singleton = MagmaSingleton::get_magma_singleton();
+
+    // copy matrix into z
+    magmablas_dlacpy(MagmaFull, dim_, dim_, device_data_.get(), ld_,
+        z.device_data_.get(), z.ld_, magma_singleton.queue_);
+    magma_int_t nb = magma_get_ssytrd_nb(dim_);
+    magma_int_t lwork
+        = std::max(2 * dim_ + dim_ * nb, 1 + 6 * dim_ + 2 * dim_ * dim_);
+    int liwork = 3 + 5 * dim_;
+
+    int info;
+    magma_int_t neig = 0;
+    std::vector<double> wa(dim_ * dim_);
+    std::vector<double> work(lwork);
+    std::vector<int> iwork(liwork);
+
+    // eigenpairs 1 to nev (Fortran indexes)
+    magma_dsyevdx_gpu(magma_jobz, MagmaRangeI, magma_uplo, dim_,
+        z.device_data_.get(), z.ld_, 0., 0., 1, nev, &neig, evals.data(),
+        wa.data(), dim_, work.data(), lwork, iwork.data(), liwork, &info);
+    if (info != 0)
+        std::cerr << "magma_dsyevdx_gpu failed, info = " << info << std::endl;
+
+    // columns beyond neig still hold workspace data
+    magmablas_dlaset(MagmaFull, dim_, dim_ - neig, 0.0, 0.0,
+        z.device_data_.get() + neig * z.ld_, z.ld_, magma_singleton.queue_);
+
+    return neig;
+}
+
 void ReplicatedMatrix::sygst(int itype, char uplo, const ReplicatedMatrix& b)
 {
     magma_uplo_t magma_uplo = magma_uplo_const(uplo);
@@ -119,6 +119,10 @@ public:
         const ReplicatedMatrix& a, const ReplicatedMatrix& b,
         const double beta);
     void syev(char, char, std::vector<double>&, ReplicatedMatrix&);
+    // compute the nev lowest eigenpairs
+    // return the number of eigenpairs computed
+    int syev(
+        char, char, const int nev, std::vector<double>&, ReplicatedMatrix&);
     void sygst(int, char, const ReplicatedMatrix&);
 
     void setVal(const int i, const int j, const double val);
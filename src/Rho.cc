@@ -38,7 +38,8 @@ template <class OrbitalsType>
 Rho<OrbitalsType>::Rho()
     : orbitals_type_(OrthoType::UNDEFINED),
       iterative_index_(-10),
-      verbosity_level_(0) // default value
+      verbosity_level_(0), // default value
+      accumulation_type_(RhoAccumulationType::Blocked)
 {
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
     myspin_         = mmpi.myspin();
@@ -424,6 +425,7 @@ void Rho<OrbitalsType>::computeRhoSubdomainUsingBlas3(const int iloc_init,
             phi2, ld * ncols + nrows, phi2_alias);
         RHODTYPE* const lrho_alias = lrho;
 #endif
+#ifdef HAVE_OPENMP_OFFLOAD
         MGMOL_PARALLEL_FOR_COLLAPSE(2, lrho_alias, product_alias, phi2_alias)
         for (int j = 0; j < ncols; ++j)
         {
@@ -434,6 +436,14 @@ void Rho<OrbitalsType>::computeRhoSubdomainUsingBlas3(const int iloc_init,
                     += product_alias[j * nrows + i] * phi2_alias[j * ld + i];
             }
         }
+#else
+        if (accumulation_type_ == RhoAccumulationType::Blocked)
+            rhoProductKernelBlocked(
+                nrows, ncols, product_alias, phi2_alias, ld, lrho_alias);
+        else
+            rhoProductKernelAtomic(
+                nrows, ncols, product_alias, phi2_alias, ld, lrho_alias);
+#endif
 #if defined(HAVE_MAGMA) && defined(HAVE_OPENMP_OFFLOAD)
         // Move lrho back to the host
         MemorySpace::copy_to_host(lrho_alias, nrows, lrho);
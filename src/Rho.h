@@ -35,6 +35,9 @@ class Rho
 
     int verbosity_level_;
 
+    // threading strategy for O(N^2) part of computeRhoSubdomainUsingBlas3
+    RhoAccumulationType accumulation_type_;
+
     static Timer update_tm_;
     static Timer compute_tm_;
     static Timer compute_blas_tm_;
@@ -74,6 +77,10 @@ public:
     void setup(
         const OrthoType orbitals_type, const std::vector<std::vector<int>>&);
     void setVerbosityLevel(const int vlevel) { verbosity_level_ = vlevel; }
+    void setAccumulationType(const RhoAccumulationType type)
+    {
+        accumulation_type_ = type;
+    }
 
     void update(OrbitalsType& current_orbitals);
 
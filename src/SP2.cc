@@ -166,7 +166,10 @@ void SP2::initializeLocalMat(
     Xi_sq_    = new SquareLocalMatrices<MATDTYPE, MemorySpace::Host>(1, n);
 #endif
 
-    double factor = 1. / (emax - emin);
+    // Xi = (emax*I - theta)/(emax-emin) maps the spectrum into [0,1],
+    // with the lowest eigenvalues mapped to 1 so that SP2 converges to
+    // the projector onto the lowest states
+    double factor = 1. / (emin - emax);
 
     // initialize Xi
     Xi_->copy(submatM);
@@ -174,7 +177,7 @@ void SP2::initializeLocalMat(
 #ifdef HAVE_BML
     const int n1 = n + 1;
     // shift and scale Xi
-    // We shift by -emin since we know it, instead of by the maximum
+    // We shift by -emax since we know it, instead of by the maximum
     // eigenvalue in magnitude as in original paper by Niklasson
 #pragma omp parallel for
     for (int i = 0; i < n; i++)
@@ -184,7 +187,7 @@ void SP2::initializeLocalMat(
         *val -= emax;
     }
 #else
-    Xi_->shift(-emin);
+    Xi_->shift(-emax);
 #endif
 
     // scale
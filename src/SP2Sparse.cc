@@ -0,0 +1,198 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "SP2Sparse.h"
+#include "MGmol_MPI.h"
+#include "MPIdata.h"
+
+#include <cassert>
+#include <cmath>
+#include <iomanip>
+#include <utility>
+
+Timer SP2Sparse::solve_tm_("SP2Sparse::solve");
+Timer SP2Sparse::square_tm_("SP2Sparse::square");
+Timer SP2Sparse::getdm_tm_("SP2Sparse::getDM");
+
+SP2Sparse::SP2Sparse(const double tol, const double drop_tol,
+    const std::vector<int>& locvars, const std::vector<int>& locfcns,
+    DataDistribution& distributor)
+    : tol_(tol),
+      drop_tol_(drop_tol),
+      locvars_(locvars),
+      locfcns_(locfcns),
+      distributor_(distributor)
+{
+    assert(tol_ > 0.);
+    assert(drop_tol_ >= 0.);
+
+    const int lsize = (int)locvars_.size();
+    Xi_.reset(new VariableSizeMatrix<sparserow>("SP2_Xi", lsize));
+    Xi_sq_.reset(new VariableSizeMatrix<sparserow>("SP2_Xi_sq", lsize));
+
+    trace_[0] = 0.;
+    trace_[1] = 0.;
+}
+
+// Calculate A for current Xi_, Xi_sq_
+// based on formula in A.M.N. Niklasson, Chapter 16 of
+//"Linear scaling techniques in comput. chem. and phys."
+// R. Zalesny et al. (eds), 2011
+int SP2Sparse::calcA(const double nocc) const
+{
+    const double lhs = std::abs(trace_[1] - nocc);
+    const double rhs = std::abs(2. * trace_[0] - trace_[1] - nocc);
+
+    return lhs < rhs ? 1 : 0;
+}
+
+void SP2Sparse::square()
+{
+    square_tm_.start();
+
+    // Xi_ is only set for centered rows: get other rows from neighbors
+    distributor_.updateLocalRows(*Xi_);
+
+    Xi_sq_->setupSparseRows(locvars_);
+    Xi_->AmultB(*Xi_, *Xi_sq_, locfcns_, drop_tol_);
+
+    // traces over centered rows, summed over all tasks
+    trace_[0] = 0.;
+    trace_[1] = 0.;
+    for (auto gid : locfcns_)
+    {
+        trace_[0] += Xi_->get_value(gid, gid);
+        trace_[1] += Xi_sq_->get_value(gid, gid);
+    }
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+    mmpi.allreduce(&trace_[0], 2, MPI_SUM);
+
+    square_tm_.stop();
+}
+
+void SP2Sparse::initialize(const VariableSizeMatrix<sparserow>& theta,
+    const double emin, const double emax)
+{
+    assert(emax > emin);
+
+    const double factor = 1. / (emax - emin);
+
+    // Xi_ = (emax*I - theta)/(emax-emin) for centered rows
+    Xi_->setupSparseRows(locvars_);
+    std::vector<int> cols;
+    std::vector<double> vals;
+    for (auto gid : locfcns_)
+    {
+        const int* tindex = (int*)theta.getTableValue(gid);
+        const int* xindex = (int*)Xi_->getTableValue(gid);
+        assert(xindex != nullptr);
+
+        cols.clear();
+        vals.clear();
+        if (tindex != nullptr)
+        {
+            const sparserow& row = theta.getRow(*tindex);
+            for (int k = 0; k < row.nnz(); k++)
+            {
+                const double val = -factor * row.getEntryFromPosition(k);
+                if (std::fabs(val) < drop_tol_) continue;
+                cols.push_back(row.getColumnIndex(k));
+                vals.push_back(val);
+            }
+        }
+        Xi_->initializeLocalRow(
+            (int)cols.size(), *xindex, cols.data(), vals.data());
+        Xi_->updateLocalRowAdd(*xindex, gid, emax * factor);
+    }
+
+    square();
+}
+
+// Update Xi_ and Xi_sq_
+void SP2Sparse::iterate(const int A)
+{
+    if (!A)
+    {
+        // Xi_sq_ <- 2*Xi_ - Xi_sq_ (centered rows only)
+        for (auto gid : locfcns_)
+        {
+            const int lrindex = *(int*)Xi_->getTableValue(gid);
+            assert(Xi_sq_->getLocalVariableGlobalIndex(lrindex) == gid);
+
+            Xi_sq_->getRow(lrindex).scale(-1.);
+            const sparserow& row = Xi_->getRow(lrindex);
+            for (int k = 0; k < row.nnz(); k++)
+                Xi_sq_->updateLocalRowAdd(lrindex, row.getColumnIndex(k),
+                    2. * row.getEntryFromPosition(k));
+        }
+    }
+
+    // new Xi_ (centered rows set only)
+    std::swap(Xi_, Xi_sq_);
+
+    square();
+}
+
+void SP2Sparse::solve(const double nocc, const bool verbose)
+{
+    solve_tm_.start();
+
+    const int maxits = 100;
+
+    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+
+    int it         = 0;
+    bool converged = false;
+    while (!converged && it < maxits)
+    {
+        // Calculate if condition "A" is satisfied
+        const int A = calcA(nocc);
+
+        iterate(A);
+
+        if (verbose)
+        {
+            int nnz = Xi_sq_->nnzmat();
+            mmpi.allreduce(&nnz, 1, MPI_SUM);
+            if (onpe0)
+                std::cout << std::setprecision(10)
+                          << "SP2Sparse: Trace at step " << it << ": "
+                          << trace_[0] << ", nnz = " << nnz << std::endl;
+        }
+
+        if (std::fabs(trace_[0] - trace_[1]) < tol_) converged = true;
+        it++;
+    }
+
+    if (onpe0)
+    {
+        if (!converged)
+            std::cout << "WARNING: SP2Sparse did not converge in " << maxits
+                      << " iterations" << std::endl;
+        if (verbose)
+            std::cout << "SP2Sparse computed Trace = " << trace_[0]
+                      << std::endl;
+    }
+
+    solve_tm_.stop();
+}
+
+void SP2Sparse::getDM(ShortSightedInverse& invS, const double occupation,
+    VariableSizeMatrix<sparserow>& dm)
+{
+    getdm_tm_.start();
+
+    // Xi_ is a polynomial in inv(S)*H, so that
+    // inv(S)*Xi_^T = Xi_*inv(S), as computed by invSmultB
+    dm.setupSparseRows(locvars_);
+    invS.invSmultB(Xi_.get(), dm);
+    dm.scale(occupation);
+
+    distributor_.updateLocalRows(dm);
+
+    getdm_tm_.stop();
+}
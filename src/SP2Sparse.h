@@ -0,0 +1,89 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_SP2SPARSE_H
+#define MGMOL_SP2SPARSE_H
+
+#include "DataDistribution.h"
+#include "ShortSightedInverse.h"
+#include "Timer.h"
+#include "VariableSizeMatrix.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// SP2 purification (A.M.N. Niklasson, Phys. Rev. B 66, 155115 (2002))
+// for localized (short-sighted) matrices distributed by rows:
+// each MPI task updates the rows centered in its subdomain and gathers
+// rows from neighboring tasks before squaring the matrix.
+// Entries smaller than a drop tolerance are discarded in each matrix
+// product to control fill-in.
+class SP2Sparse
+{
+    // convergence tolerance on trace
+    const double tol_;
+
+    // threshold for entries of iterates
+    const double drop_tol_;
+
+    // gids of local rows (centered and neighboring functions)
+    const std::vector<int> locvars_;
+
+    // gids of functions centered in local subdomain
+    const std::vector<int> locfcns_;
+
+    DataDistribution& distributor_;
+
+    std::unique_ptr<VariableSizeMatrix<sparserow>> Xi_;
+    std::unique_ptr<VariableSizeMatrix<sparserow>> Xi_sq_;
+
+    // traces of Xi_ and Xi_sq_
+    double trace_[2];
+
+    static Timer solve_tm_;
+    static Timer square_tm_;
+    static Timer getdm_tm_;
+
+    // Calculate A for the current Xi_
+    int calcA(const double nocc) const;
+
+    // Update Xi_ and Xi_sq_
+    void iterate(const int A);
+
+    // gather neighboring rows of Xi_ and compute Xi_sq_ and traces
+    void square();
+
+public:
+    SP2Sparse(const double tol, const double drop_tol,
+        const std::vector<int>& locvars, const std::vector<int>& locfcns,
+        DataDistribution& distributor);
+
+    // Initialize Xi_ with theta=inv(S)*H shifted and scaled so that
+    // its spectrum [emin,emax] is mapped into [0,1],
+    // with the lowest eigenvalues mapped to 1
+    void initialize(const VariableSizeMatrix<sparserow>& theta,
+        const double emin, const double emax);
+
+    // Iterate until trace converges to number of occupied orbitals nocc
+    void solve(const double nocc, const bool verbose);
+
+    // dm = occupation * Xi_ * inv(S)
+    void getDM(ShortSightedInverse& invS, const double occupation,
+        VariableSizeMatrix<sparserow>& dm);
+
+    // purified matrix (values set for centered rows only)
+    const VariableSizeMatrix<sparserow>& getXi() const { return *Xi_; }
+
+    static void printTimers(std::ostream& os)
+    {
+        solve_tm_.print(os);
+        square_tm_.print(os);
+        getdm_tm_.print(os);
+    }
+};
+#endif
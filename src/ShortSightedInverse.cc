@@ -19,6 +19,7 @@
 
 #include <mpi.h>
 
+#include "CSRMatrix.h"
 #include "Control.h"
 #include "LinearSolverMatrix.h"
 #include "MGmol_MPI.h"
@@ -99,8 +100,9 @@ ShortSightedInverse::ShortSightedInverse(
     invS_  = new VariableSizeMatrix<sparserow>("invS", lsize_);
     matLS_ = new LinearSolverMatrix<lsdatatype>(0, 0);
 
-    issetup_        = true;
-    isInvSUpToDate_ = false;
+    issetup_              = true;
+    isInvSUpToDate_       = false;
+    isPackedInvSUpToDate_ = false;
 
     resnorm_ = 0.0;
     precon_  = nullptr;
@@ -339,7 +341,8 @@ void ShortSightedInverse::computeInvS(DataDistribution& distributor_invS)
 
     /* gather inverse data */
     gather(distributor_invS);
-    isInvSUpToDate_ = true;
+    isInvSUpToDate_       = true;
+    isPackedInvSUpToDate_ = false;
 
     compute_invS_tm_.stop();
 
@@ -450,11 +453,20 @@ double ShortSightedInverse::getTraceDotProductWithInvS(
     VariableSizeMatrix<sparserow>* mat)
 {
     /* compute trace */
+    // use packed copies of the rows needed (sorted columns),
+    // packing invS_ only once after each update
+    if (!isPackedInvSUpToDate_)
+    {
+        packedInvS_.assign(*invS_, locfcns_);
+        isPackedInvSUpToDate_ = true;
+    }
+    const CSRMatrix pmat(*mat, locfcns_);
+
     double trace = 0.0;
     for (std::vector<int>::iterator itr = locfcns_.begin();
          itr != locfcns_.end(); ++itr)
     {
-        trace += (*invS_).AmultSymB_ij(mat, *itr, *itr);
+        trace += packedInvS_.AmultSymB_ij(pmat, *itr, *itr);
     }
 
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
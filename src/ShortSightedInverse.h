@@ -18,6 +18,7 @@
 
 #include <mpi.h>
 
+#include "CSRMatrix.h"
 #include "ClusterOrbitals.h"
 #include "DataDistribution.h"
 #include "LinearSolver.h"
@@ -60,6 +61,8 @@ class ShortSightedInverse
     VariableSizeMatrix<sparserowtab>* gramMat_; // Matrix for data distribution
     VariableSizeMatrix<sparserow>*
         invS_; // Matrix for storing gram matrix inverse
+    CSRMatrix packedInvS_; // packed locally centered rows of invS_
+    bool isPackedInvSUpToDate_;
     LinearSolverMatrix<lsdatatype>*
         matLS_; // Linear solver matrix for linear solver
     PreconILU<pcdatatype>* precon_; // preconditioner for linear system solve
@@ -114,12 +117,14 @@ public:
     int getGramMatrixOrbitalsIndex() { return gm_orbitals_index_; }
     // matrix multiplication S**(-1) * B
     // flag== true => compute entries for specific nonzero pattern only
+    // entries smaller than tol are dropped
     void invSmultB(VariableSizeMatrix<SparseRow>* B,
-        VariableSizeMatrix<SparseRow>& C, bool flag = true)
+        VariableSizeMatrix<SparseRow>& C, bool flag = true,
+        const double tol = 0.)
     {
         assert(B != NULL);
 
-        (*invS_).AmultSymBLocal(B, C, locfcns_, *gramMat_, flag);
+        (*invS_).AmultSymBLocal(B, C, locfcns_, *gramMat_, flag, tol);
 
         return;
     }
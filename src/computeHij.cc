@@ -315,10 +315,10 @@ void MGmol<OrbitalsType>::computeHnlPhiAndAdd2HPhi(Ions& ions,
             pb::GridFuncVector<ORBDTYPE, MemorySpace::Host> gfv(
                 mygrid, ct.bcWF[0], ct.bcWF[1], ct.bcWF[2], gid);
             std::vector<ORBDTYPE> work(numpt * ncolors);
+            get_vnlpsi(ions, gid, kbpsi, work.data());
             for (short icolor = 0; icolor < ncolors; icolor++)
             {
-                get_vnlpsi(ions, gid, icolor, kbpsi, work.data());
-                gfv.assign(icolor, work.data());
+                gfv.assign(icolor, work.data() + numpt * icolor);
             }
 
             gfv.rhs_4th_Mehr1(work.data());
@@ -346,29 +346,26 @@ void MGmol<OrbitalsType>::computeHnlPhiAndAdd2HPhi(Ions& ions,
         }
         else // no Mehrstellen
         {
+            // add Hnl*phi directly to H*phi (through host views)
+            std::vector<ORBDTYPE*> hpsi_host_views(ncolors);
+            for (short icolor = 0; icolor < ncolors; icolor++)
             {
-                ORBDTYPE* hnl = new ORBDTYPE[numpt];
-                for (short icolor = 0; icolor < ncolors; icolor++)
-                {
-                    get_vnlpsi(ions, gid, icolor, kbpsi, hnl);
-
-                    ORBDTYPE* hpsi           = hphi.getPsi(icolor);
-                    ORBDTYPE* hpsi_host_view = MemorySpace::Memory<ORBDTYPE,
-                        memory_space_type>::allocate_host_view(numpt);
-                    MemorySpace::Memory<ORBDTYPE,
-                        memory_space_type>::copy_view_to_host(hpsi, numpt,
-                        hpsi_host_view);
-
-                    LinearAlgebraUtils<MemorySpace::Host>::MPaxpy(
-                        numpt, 1., hnl, hpsi_host_view);
-
-                    MemorySpace::Memory<ORBDTYPE,
-                        memory_space_type>::copy_view_to_dev(hpsi_host_view,
-                        numpt, hpsi);
-                    MemorySpace::Memory<ORBDTYPE,
-                        memory_space_type>::free_host_view(hpsi_host_view);
-                }
-                delete[] hnl;
+                hpsi_host_views[icolor] = MemorySpace::Memory<ORBDTYPE,
+                    memory_space_type>::allocate_host_view(numpt);
+                MemorySpace::Memory<ORBDTYPE, memory_space_type>::
+                    copy_view_to_host(
+                        hphi.getPsi(icolor), numpt, hpsi_host_views[icolor]);
+            }
+
+            add_vnlpsi(ions, gid, kbpsi, hpsi_host_views);
+
+            for (short icolor = 0; icolor < ncolors; icolor++)
+            {
+                MemorySpace::Memory<ORBDTYPE, memory_space_type>::
+                    copy_view_to_dev(
+                        hpsi_host_views[icolor], numpt, hphi.getPsi(icolor));
+                MemorySpace::Memory<ORBDTYPE,
+                    memory_space_type>::free_host_view(hpsi_host_views[icolor]);
             }
         }
     }
@@ -454,6 +451,27 @@ void MGmol<OrbitalsType>::getHpsiAndTheta(Ions& ions, OrbitalsType& phi,
     get_Hpsi_and_Hij_tm_.stop();
 }
 
+template <class OrbitalsType>
+void MGmol<OrbitalsType>::applyH(
+    Ions& ions, OrbitalsType& phi, OrbitalsType& hphi)
+{
+    get_Hpsi_and_Hij_tm_.start();
+
+    const int phi_it_index = phi.getIterativeIndex();
+
+    // phi is generally a temporary: do not use, nor overwrite, cached H*phi
+    hamiltonian_->applyLocal(phi, hphi);
+
+    // phi may share its iterative index with a previous argument
+    applyH_kbpsi_->setOutdated();
+    applyH_kbpsi_->computeAll(ions, phi);
+
+    computeHnlPhiAndAdd2HPhi(ions, phi, hphi, applyH_kbpsi_.get());
+    hphi.setIterativeIndex(phi_it_index);
+
+    get_Hpsi_and_Hij_tm_.stop();
+}
+
 template class MGmol<LocGridOrbitals>;
 template class MGmol<ExtendedGridOrbitals>;
 
@@ -21,66 +21,84 @@ using namespace std;
 Timer get_kbpsi_tm("get_kbpsi");
 Timer vnlpsi_tm("vnlpsi");
 
-void get_vnlpsi(const Ions& ions, const vector<vector<int>>& subdomain_gids,
-    const int color, const KBPsiMatrixSparse* const kbpsi, ORBDTYPE* const vpsi)
+// Add Vnl*psi to vpsi[color] for all the colors at once, using one
+// matrix-matrix multiplication per ion and subdomain
+void add_vnlpsi(const Ions& ions, const vector<vector<int>>& subdomain_gids,
+    const KBPsiMatrixSparse* const kbpsi, const vector<ORBDTYPE*>& vpsi)
 {
     vnlpsi_tm.start();
 
-    Mesh* mymesh           = Mesh::instance();
-    const pb::Grid& mygrid = mymesh->grid();
-    const int subdivx      = mymesh->subdivx();
-
-    memset(vpsi, 0, mygrid.size() * sizeof(ORBDTYPE));
+    Mesh* mymesh      = Mesh::instance();
+    const int subdivx = mymesh->subdivx();
+    const int ncolors = subdomain_gids[0].size();
+    assert(static_cast<int>(vpsi.size()) == ncolors);
 
     const vector<Ion*>& local_ions(ions.overlappingNL_ions());
 
+    vector<int> states;
+    vector<ORBDTYPE*> dst;
+    vector<int> ion_gids;
+    vector<short> signs;
+    vector<double> kbcoeffs;
+    vector<double> coeffs;
     for (int iloc = 0; iloc < subdivx; iloc++)
-        if (subdomain_gids[iloc][color] != -1)
+    {
+        // states with non-zero values in subdomain iloc
+        states.clear();
+        dst.clear();
+        for (int color = 0; color < ncolors; color++)
         {
             const int st = subdomain_gids[iloc][color];
-
-            // Loop over all the ions if nl proj. overlaps with sub-domain
-            vector<Ion*>::const_iterator ion = local_ions.begin();
-            while (ion != local_ions.end())
+            if (st != -1)
             {
-                vector<int> ion_gids;
-                (*ion)->getGidsNLprojs(ion_gids);
+                states.push_back(st);
+                dst.push_back(vpsi[color]);
+            }
+        }
+        if (states.empty()) continue;
+
+        // Loop over all the ions if nl proj. overlaps with sub-domain
+        for (auto ion : local_ions)
+        {
+            const std::shared_ptr<KBprojector> ion_kbproj(ion->kbproj());
+            if (!ion_kbproj->overlaps(iloc)) continue;
 
-                vector<short> signs;
-                (*ion)->getKBsigns(signs);
+            ion->getGidsNLprojs(ion_gids);
+            ion->getKBsigns(signs);
+            ion->getKBcoeffs(kbcoeffs);
 
-                vector<double> kbcoeffs;
-                (*ion)->getKBcoeffs(kbcoeffs);
+            const short nprojs = (short)ion_gids.size();
+            coeffs.resize(nprojs * states.size());
+            for (unsigned int j = 0; j < states.size(); j++)
+                for (short i = 0; i < nprojs; i++)
+                {
+                    coeffs[i + nprojs * j]
+                        = kbpsi->getValIonState(ion_gids[i], states[j])
+                          * kbcoeffs[i] * signs[i];
+                }
+            ion_kbproj->axpyKetBatch(iloc, coeffs, dst);
 
-                const std::shared_ptr<KBprojector> ion_kbproj((*ion)->kbproj());
+        } // end loop over ions
 
-                if (ion_kbproj->onlyOneProjector())
-                {
-                    assert(ion_gids.size() == 1);
-                    const int gid = ion_gids[0];
+    } // end loop over iloc
 
-                    const double coeff = kbpsi->getValIonState(gid, st)
-                                         * kbcoeffs[0] * signs[0];
-                    ion_kbproj->axpySKet(iloc, coeff, vpsi);
-                }
-                else
-                {
-                    vector<double> coeff;
-                    const short nprojs = (short)ion_gids.size();
-                    for (short i = 0; i < nprojs; i++)
-                    {
-                        const int gid = ion_gids[i];
-                        coeff.push_back(kbpsi->getValIonState(gid, st)
-                                        * kbcoeffs[i] * signs[i]);
-                    }
-                    ion_kbproj->axpyKet(iloc, coeff, vpsi);
-                }
+    vnlpsi_tm.stop();
+}
 
-                ion++;
+// Compute Vnl*psi for all the colors, stored contiguously in vpsi
+void get_vnlpsi(const Ions& ions, const vector<vector<int>>& subdomain_gids,
+    const KBPsiMatrixSparse* const kbpsi, ORBDTYPE* const vpsi)
+{
+    Mesh* mymesh           = Mesh::instance();
+    const pb::Grid& mygrid = mymesh->grid();
+    const int numpt        = mygrid.size();
+    const int ncolors      = subdomain_gids[0].size();
 
-            } // end loop over ions
+    memset(vpsi, 0, ncolors * numpt * sizeof(ORBDTYPE));
 
-        } // end loop over iloc
+    vector<ORBDTYPE*> dst(ncolors);
+    for (int color = 0; color < ncolors; color++)
+        dst[color] = vpsi + color * numpt;
 
-    vnlpsi_tm.stop();
+    add_vnlpsi(ions, subdomain_gids, kbpsi, dst);
 }
@@ -12,6 +12,8 @@
 #include "magma_singleton.h"
 #include "mputils.h"
 
+#include <cstring>
+
 template <typename DataType, typename MemorySpaceType>
 LocalMatrices<DataType, MemorySpaceType>::LocalMatrices(
     const short nmat, const int m, const int n)
@@ -337,6 +339,46 @@ void LocalMatrices<DataType, MemorySpaceType>::gemm(const int iloc,
         't', 'n', m_, n_, ma, 1., a, lda, b, ldb, 0., c, m_);
 }
 
+template <typename DataType, typename MemorySpaceType>
+template <typename T2>
+void LocalMatrices<DataType, MemorySpaceType>::gemmRows(const int iloc,
+    const int ma, const std::vector<int>& rows, const double alpha,
+    const T2* const a, const int lda, const T2* const b, const int ldb)
+{
+    assert(iloc < nmat_);
+    assert(ma <= lda);
+    assert((int)rows.size() <= m_);
+
+    DataType* const c = ptr_matrices_[iloc];
+    assert(c != nullptr);
+
+    MemorySpace::assert_is_host_ptr(a);
+    MemorySpace::assert_is_host_ptr(b);
+    MemorySpace::assert_is_host_ptr(c);
+
+    memset(c, 0, m_ * n_ * sizeof(DataType));
+
+    const int nrows = static_cast<int>(rows.size());
+    if (nrows == 0) return;
+
+    // pack the nonzero columns of a into a contiguous panel
+    std::vector<T2> apanel(nrows * ma);
+    for (int i = 0; i < nrows; i++)
+    {
+        assert(rows[i] < m_);
+        memcpy(apanel.data() + i * ma, a + rows[i] * lda, ma * sizeof(T2));
+    }
+
+    // multiply by all the columns of b
+    std::vector<DataType> cpanel(nrows * n_);
+    LinearAlgebraUtils<MemorySpace::Host>::MPgemm('t', 'n', nrows, n_, ma,
+        alpha, apanel.data(), ma, b, ldb, 0., cpanel.data(), nrows);
+
+    for (int j = 0; j < n_; j++)
+        for (int i = 0; i < nrows; i++)
+            c[j * m_ + rows[i]] = cpanel[j * nrows + i];
+}
+
 // matrix multiplication
 // this = alpha*op(A)*op(B)+beta*this
 template <typename DataType, typename MemorySpaceType>
@@ -493,6 +535,19 @@ template void LocalMatrices<double, MemorySpace::Host>::copy(
 template void LocalMatrices<double, MemorySpace::Host>::copy(
     const LocalMatrices<double, MemorySpace::Host>& mat);
 
+template void LocalMatrices<double, MemorySpace::Host>::gemmRows(const int,
+    const int, const std::vector<int>&, const double, const double* const,
+    const int, const double* const, const int);
+template void LocalMatrices<double, MemorySpace::Host>::gemmRows(const int,
+    const int, const std::vector<int>&, const double, const float* const,
+    const int, const float* const, const int);
+template void LocalMatrices<float, MemorySpace::Host>::gemmRows(const int,
+    const int, const std::vector<int>&, const double, const double* const,
+    const int, const double* const, const int);
+template void LocalMatrices<float, MemorySpace::Host>::gemmRows(const int,
+    const int, const std::vector<int>&, const double, const float* const,
+    const int, const float* const, const int);
+
 #ifdef HAVE_MAGMA
 template class LocalMatrices<double, MemorySpace::Device>;
 #endif
@@ -115,6 +115,12 @@ public:
     void gemm(const char transa, const char transb, const double alpha,
         const LocalMatrices& matA, const LocalMatrices& matB,
         const double beta);
+    // alpha*a^T*b restricted to rows "rows" of matrix iloc (other rows set
+    // to zero), for a with nonzero columns "rows" only
+    template <typename T2>
+    void gemmRows(const int iloc, const int ma, const std::vector<int>& rows,
+        const double alpha, const T2* const a, const int lda,
+        const T2* const b, const int ldb);
     void reset()
     {
         memset(storage_.get(), 0, storage_size_ * sizeof(DataType));
@@ -29,6 +29,7 @@
 #include "MGmol.h"
 #include "MGmol_MPI.h"
 #include "MPIdata.h"
+#include "Profiler.h"
 #include "mgmol_run.h"
 
 #include <cassert>
@@ -89,6 +90,8 @@ int main(int argc, char** argv)
     int ret = ct.checkOptions();
     if (ret < 0) return ret;
 
+    if (!ct.profile_output.empty()) Profiler::instance().enable();
+
     mmpi.bcastGlobal(input_filename);
     mmpi.bcastGlobal(lrs_filename);
 
@@ -7,6 +7,7 @@
 // This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
 // Please also read this link https://github.com/llnl/mgmol/LICENSE
 
+#include "AsyncFileWriter.h"
 #include "ConstraintSet.h"
 #include "Control.h"
 #include "DFTsolver.h"
@@ -28,6 +29,7 @@
 #include "OrbitalsExtrapolationFactory.h"
 #include "OrbitalsPreconditioning.h"
 #include "Potentials.h"
+#include "Profiler.h"
 #include "ProjectedMatricesMehrstellen.h"
 #include "ProjectedMatricesSparse.h"
 #include "Rho.h"
@@ -243,7 +245,8 @@ int MGmol<OrbitalsType>::dumpMDrestartFile(OrbitalsType** orbitals, Ions& ions,
     s << count;
     filename += s.str();
 
-    HDFrestart h5file(filename, myPEenv, gdim, ct.out_restart_file_type);
+    HDFrestart h5file(filename, myPEenv, gdim, ct.out_restart_file_type,
+        restart_writer_.get());
 
     OrbitalsType previous_orbitals("ForDumping", **orbitals, false);
     if (!orbitals_extrapol_->getRestartData(previous_orbitals))
@@ -315,6 +318,11 @@ void MGmol<OrbitalsType>::md(OrbitalsType** orbitals, Ions& ions)
     orbitals_extrapol_.reset(OrbitalsExtrapolationFactory<OrbitalsType>::create(
         ct.WFExtrapolation()));
 
+    // restart files are built in memory and written to disk in background
+    // while MD proceeds
+    if (ct.out_restart_async && ct.out_restart_info > 0)
+        restart_writer_.reset(new AsyncFileWriter(DUMP_MAX_NUM_TRY));
+
     MD_IonicStepper* stepper = new MD_IonicStepper(
         ct.dt, atmove, tau0, taup, taum, fion, pmass, rand_states);
     stepper->setThermostat(ct.thermostat_type, ct.tkel, ct.thtime, ct.thwidth,
@@ -418,6 +426,7 @@ void MGmol<OrbitalsType>::md(OrbitalsType** orbitals, Ions& ions)
             break;
         }
 
+        ProfilerStep profiler_step("MD step", mdstep);
         md_iterations_tm.start();
 
         double eks              = 0.;
@@ -582,8 +591,12 @@ void MGmol<OrbitalsType>::md(OrbitalsType** orbitals, Ions& ions)
         {
             orbitals_extrapol_->clearOldOrbitals();
             lrs_->clearOldCenters();
+            electrostat_->clearOldVh();
         }
 
+        // initial guess for next Hartree solve
+        if (ct.dt > 0. && ct.extrapolateVH()) electrostat_->extrapolateVh();
+
         preWFextrapolation();
 
         if (ct.dt > 0.
@@ -651,8 +664,23 @@ void MGmol<OrbitalsType>::md(OrbitalsType** orbitals, Ions& ions)
             count++;
         }
 
+        if (restart_writer_)
+        {
+            // wait for last restart file to be written
+            dump_tm_.start();
+            ierr = restart_writer_->wait();
+            dump_tm_.stop();
+
+            MGmol_MPI& mmpi = *(MGmol_MPI::instance());
+            mmpi.allreduce(&ierr, 1, MPI_MIN);
+            if (onpe0 && ierr < 0)
+                (*MPIdata::serr) << "md: failed to write last restart file"
+                                 << std::endl;
+        }
+
         printWithTimeStamp("dumped last restart file...", std::cout);
     }
+    restart_writer_.reset();
 
     delete stepper;
     orbitals_extrapol_.reset();
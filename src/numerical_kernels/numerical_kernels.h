@@ -19,3 +19,17 @@ template <typename T1, typename T2, typename T3>
 void nonOrthoRhoKernelDiagonalBlock(const short i0, const short ib,
     const int x0, const int xb, const T3* const mat, const int ld,
     const std::vector<const T1*>& psi, T2* const rho);
+
+// rho[i] += sum_j product[j*nrows+i]*phi[j*ld+i]
+// threads split columns and update rho with atomics
+template <typename T1, typename T2>
+void rhoProductKernelAtomic(const int nrows, const int ncols,
+    const T1* const product, const T1* const phi, const int ld,
+    T2* const rho);
+
+// rho[i] += sum_j product[j*nrows+i]*phi[j*ld+i]
+// threads own disjoint blocks of rows: race-free, no atomics
+template <typename T1, typename T2>
+void rhoProductKernelBlocked(const int nrows, const int ncols,
+    const T1* const product, const T1* const phi, const int ld,
+    T2* const rho);
@@ -11,6 +11,8 @@
 #include "Timer.h"
 #include "numerical_kernels.h"
 
+#include <algorithm>
+
 //#define WTIMERS
 
 #ifdef WTIMERS
@@ -18,6 +20,10 @@ Timer nonOrthoRhoKernel_tm("nonOrthoRhoKernel");
 Timer nonOrthoRhoKernelDiagonalBlock_tm("nonOrthoRhoKernelDiagonalBlock");
 #endif
 
+// number of grid points per block in rhoProductKernelBlocked:
+// 2 columns of a block of this size fit in L1 cache
+static const int rho_block_size = 512;
+
 // Numerical kernel:
 // Triple loop over pairs of functions and space
 template <typename T1, typename T2, typename T3>
@@ -101,6 +107,53 @@ void nonOrthoRhoKernelDiagonalBlock(const short i0, const short ib,
 #endif
 }
 
+template <typename T1, typename T2>
+void rhoProductKernelAtomic(const int nrows, const int ncols,
+    const T1* const product, const T1* const phi, const int ld,
+    T2* const rho)
+{
+#pragma omp parallel for collapse(2)
+    for (int j = 0; j < ncols; ++j)
+    {
+        for (int i = 0; i < nrows; ++i)
+        {
+#pragma omp atomic update
+            rho[i] += product[j * nrows + i] * phi[j * ld + i];
+        }
+    }
+}
+
+template <typename T1, typename T2>
+void rhoProductKernelBlocked(const int nrows, const int ncols,
+    const T1* const product, const T1* const phi, const int ld,
+    T2* const rho)
+{
+    const int nblocks = (nrows + rho_block_size - 1) / rho_block_size;
+
+    // each block of rows is owned by one thread, which
+    // loops over all the columns for that block
+#pragma omp parallel for schedule(static)
+    for (int ib = 0; ib < nblocks; ++ib)
+    {
+        const int i0 = ib * rho_block_size;
+        const int bs = std::min(rho_block_size, nrows - i0);
+
+        T2* __restrict__ prho = rho + i0;
+
+        for (int j = 0; j < ncols; ++j)
+        {
+            const T1* __restrict__ pprod = product + j * nrows + i0;
+            const T1* __restrict__ pphi  = phi + j * ld + i0;
+
+#pragma omp simd
+            for (int i = 0; i < bs; ++i)
+            {
+                prho[i] += pprod[i] * pphi[i];
+            }
+        }
+    }
+}
+
 template void nonOrthoRhoKernel(const short i0, const short ib, const short j0,
     const short jb, const int x0, const int xb, const MATDTYPE* const mat,
     const int ld, const std::vector<const ORBDTYPE*>& psi, const double factor,
@@ -109,3 +162,10 @@ template void nonOrthoRhoKernel(const short i0, const short ib, const short j0,
 template void nonOrthoRhoKernelDiagonalBlock(const short i0, const short ib,
     const int x0, const int xb, const MATDTYPE* const mat, const int ld,
     const std::vector<const ORBDTYPE*>& psi, RHODTYPE* const rho);
+
+template void rhoProductKernelAtomic(const int nrows, const int ncols,
+    const ORBDTYPE* const product, const ORBDTYPE* const phi, const int ld,
+    RHODTYPE* const rho);
+template void rhoProductKernelBlocked(const int nrows, const int ncols,
+    const ORBDTYPE* const product, const ORBDTYPE* const phi, const int ld,
+    RHODTYPE* const rho);
@@ -1,17 +1,32 @@
 #include "FDkernels.h"
 #include "Timer.h"
 
+#include <algorithm>
+#include <vector>
+
 static Timer del2_2nd_tm("del2_2nd");
 static Timer del2_4th_tm("del2_4th");
 static Timer del2_4th_Mehr_tm("del2_4th_Mehr");
 static Timer rhs_4th_Mehr1_tm("rhs_4th_Mehr1");
+static Timer del2_wpot_tm("del2_withPot");
+static Timer del2_4th_Mehr_wpot_tm("del2_4th_Mehr_withPot");
+static Timer del2_region_tm("del2_region");
 
 const double inv12 = 1. / 12.;
 
+// number of z-pencils along y in the tiles swept by the fused kernels
+const int fd_tile_y = 16;
+
 namespace pb
 {
 
-void printFDkernelTimers(std::ostream& os) { del2_2nd_tm.print(os); }
+void printFDkernelTimers(std::ostream& os)
+{
+    del2_2nd_tm.print(os);
+    del2_wpot_tm.print(os);
+    del2_4th_Mehr_wpot_tm.print(os);
+    del2_region_tm.print(os);
+}
 
 // evaluate 2nd order FD Laplacian on uniform mesh defined by Grid
 // object
@@ -295,10 +310,10 @@ void FDkernelDel2_6th(const Grid& grid, ScalarType* v, ScalarType* u,
 
     const int gpt = grid.ghost_pt();
 
-    int iix = gpt * incx;
-
     for (size_t ifunc = 0; ifunc < nfunc; ifunc++)
     {
+        int iix = gpt * incx;
+
         for (int ix = 0; ix < dim0; ix++)
         {
             int iiy = iix + gpt * incy + ifunc * ngpts;
@@ -388,10 +403,11 @@ void FDkernelDel2_8th(const Grid& grid, ScalarType* v, ScalarType* u,
     const size_t ngpts = grid.sizeg();
 
     const int gpt = grid.ghost_pt();
-    int iix       = gpt * incx;
 
     for (size_t ifunc = 0; ifunc < nfunc; ifunc++)
     {
+        int iix = gpt * incx;
+
         for (int ix = 0; ix < dim0; ix++)
         {
             int iiy = iix + gpt * incy + ifunc * ngpts;
@@ -583,6 +599,424 @@ void FDkernelRHS_4th_Mehr1(const Grid& grid, ScalarType* v, ScalarType* rhs,
     rhs_4th_Mehr1_tm.stop();
 }
 
+namespace
+{
+// box [lo,hi) of mesh points, in local indexes without ghosts
+struct StencilBox
+{
+    int lo[3];
+    int hi[3];
+};
+
+// list of boxes covering a region of the local subdomain,
+// for a stencil extending over radius points in each direction
+std::vector<StencilBox> stencilBoxes(
+    const Grid& grid, const int radius, const StencilRegion region)
+{
+    const int dim[3] = { static_cast<int>(grid.dim(0)),
+        static_cast<int>(grid.dim(1)), static_cast<int>(grid.dim(2)) };
+
+    std::vector<StencilBox> boxes;
+
+    const bool empty_interior = (dim[0] <= 2 * radius)
+                                || (dim[1] <= 2 * radius)
+                                || (dim[2] <= 2 * radius);
+
+    if (region == StencilRegion::All
+        || (region == StencilRegion::Shell && empty_interior))
+    {
+        boxes.push_back({ { 0, 0, 0 }, { dim[0], dim[1], dim[2] } });
+        return boxes;
+    }
+    if (empty_interior) return boxes;
+
+    const int r = radius;
+    if (region == StencilRegion::Interior)
+    {
+        boxes.push_back(
+            { { r, r, r }, { dim[0] - r, dim[1] - r, dim[2] - r } });
+        return boxes;
+    }
+
+    // shell: two slabs in each direction, without overlap
+    boxes.push_back({ { 0, 0, 0 }, { r, dim[1], dim[2] } });
+    boxes.push_back({ { dim[0] - r, 0, 0 }, { dim[0], dim[1], dim[2] } });
+    boxes.push_back({ { r, 0, 0 }, { dim[0] - r, r, dim[2] } });
+    boxes.push_back({ { r, dim[1] - r, 0 }, { dim[0] - r, dim[1], dim[2] } });
+    boxes.push_back({ { r, r, 0 }, { dim[0] - r, dim[1] - r, r } });
+    boxes.push_back(
+        { { r, r, dim[2] - r }, { dim[0] - r, dim[1] - r, dim[2] } });
+
+    return boxes;
+}
+
+// coefficients of star shaped FD Laplacians with R points on each side
+// (cx[k-1], cy[k-1], cz[k-1] for distance k), and c0 for center point
+void setStarCoefficients(const Grid& grid, const int R, double& c0,
+    double* const cx, double* const cy, double* const cz)
+{
+    const double w2[1] = { -1. };
+    const double w4[2] = { -16. / 12., 1. / 12. };
+    const double w6[3] = { -270. / 180., 27. / 180., -2. / 180. };
+    const double w8[4]
+        = { -8064. / 5040., 1008. / 5040., -128. / 5040., 9. / 5040. };
+    const double* const weights[4] = { w2, w4, w6, w8 };
+    assert(R > 0 && R < 5);
+    const double* const w = weights[R - 1];
+
+    double* coeffs[3] = { cx, cy, cz };
+    c0                = 0.;
+    for (short d = 0; d < 3; d++)
+    {
+        const double inv_h2 = 1. / (grid.hgrid(d) * grid.hgrid(d));
+        for (int k = 0; k < R; k++)
+        {
+            coeffs[d][k] = w[k] * inv_h2;
+            c0 -= 2. * coeffs[d][k];
+        }
+    }
+}
+
+// evaluate b = -Lap*v (+ pot*v if WithPot) on the points of one box,
+// for a star shaped FD Laplacian with R points on each side.
+// v has ghost values, pot is defined on the mesh without ghosts,
+// b has b_ghosts ghost values.
+// z-pencils are swept in tiles along y so that the x-planes of a tile
+// are still in cache when the stencil reaches them again from the next x
+template <int R, bool WithPot, typename ScalarType>
+void FDkernelStarStencil(const Grid& grid, const double c0,
+    const double* const cx, const double* const cy, const double* const cz,
+    const ScalarType* const v, const double* const pot, ScalarType* const b,
+    const short b_ghosts, const size_t nfunc, const StencilBox& box)
+{
+    assert(grid.ghost_pt() >= R);
+
+    const int dim1     = grid.dim(1);
+    const int dim2     = grid.dim(2);
+    const int incx     = grid.inc(0);
+    const int incy     = grid.inc(1);
+    const int gpt      = grid.ghost_pt();
+    const size_t ngpts = grid.sizeg();
+
+    const int incy_b     = dim2 + 2 * b_ghosts;
+    const int incx_b     = incy_b * (dim1 + 2 * b_ghosts);
+    const size_t ngpts_b = incx_b * (grid.dim(0) + 2 * b_ghosts);
+
+    const int ntiles = (box.hi[1] - box.lo[1] + fd_tile_y - 1) / fd_tile_y;
+
+#pragma omp parallel for collapse(2)
+    for (size_t ifunc = 0; ifunc < nfunc; ifunc++)
+    {
+        for (int itile = 0; itile < ntiles; itile++)
+        {
+            const int iy0 = box.lo[1] + itile * fd_tile_y;
+            const int iy1 = std::min(iy0 + fd_tile_y, box.hi[1]);
+
+            const ScalarType* const vf = v + ifunc * ngpts;
+            ScalarType* const bf       = b + ifunc * ngpts_b;
+
+            for (int ix = box.lo[0]; ix < box.hi[0]; ix++)
+            {
+                for (int iy = iy0; iy < iy1; iy++)
+                {
+                    const int iiz = (ix + gpt) * incx + (iy + gpt) * incy + gpt
+                                    + box.lo[2];
+                    const int ibz = (ix + b_ghosts) * incx_b
+                                    + (iy + b_ghosts) * incy_b + b_ghosts
+                                    + box.lo[2];
+                    const int ipz = (ix * dim1 + iy) * dim2 + box.lo[2];
+
+                    const ScalarType* __restrict__ v0 = vf + iiz;
+                    const double* __restrict__ p0
+                        = WithPot ? pot + ipz : nullptr;
+                    ScalarType* __restrict__ u0 = bf + ibz;
+
+                    const int nz = box.hi[2] - box.lo[2];
+#pragma omp simd
+                    for (int iz = 0; iz < nz; iz++)
+                    {
+                        double val = c0 * (double)v0[iz];
+                        if (WithPot) val += p0[iz] * (double)v0[iz];
+                        for (int k = 1; k <= R; k++)
+                        {
+                            val += cx[k - 1]
+                                       * ((double)v0[iz - k * incx]
+                                           + (double)v0[iz + k * incx])
+                                   + cy[k - 1]
+                                         * ((double)v0[iz - k * incy]
+                                             + (double)v0[iz + k * incy])
+                                   + cz[k - 1]
+                                         * ((double)v0[iz - k]
+                                             + (double)v0[iz + k]);
+                        }
+                        u0[iz] = (ScalarType)val;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <int R, bool WithPot, typename ScalarType>
+void FDkernelStarStencil(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const short b_ghosts,
+    const size_t nfunc, const StencilRegion region)
+{
+    double c0;
+    double cx[R], cy[R], cz[R];
+    setStarCoefficients(grid, R, c0, cx, cy, cz);
+
+    for (const auto& box : stencilBoxes(grid, R, region))
+        FDkernelStarStencil<R, WithPot>(
+            grid, c0, cx, cy, cz, v, pot, b, b_ghosts, nfunc, box);
+}
+
+// evaluate b = -Lap_Mehr*v (+ RHS_Mehr1*(pot*v) if WithPot) on the
+// points of one box, without forming pot*v in a temporary array.
+// v and pot have ghost values (pot is a single function with the same
+// layout as each function in v), b has b_ghosts ghost values
+template <bool WithPot, typename ScalarType>
+void FDkernelMehrStencil(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const short b_ghosts,
+    const size_t nfunc, const StencilBox& box)
+{
+    assert(grid.ghost_pt() > 0);
+
+    double inv_h2[3] = { 1. / (grid.hgrid(0) * grid.hgrid(0)),
+        1. / (grid.hgrid(1) * grid.hgrid(1)),
+        1. / (grid.hgrid(2) * grid.hgrid(2)) };
+
+    const double c0mehr4  = 16. * inv12 * (inv_h2[0] + inv_h2[1] + inv_h2[2]);
+    const double cxmehr4  = -10. * inv12 * inv_h2[0] + 0.125 * c0mehr4;
+    const double cymehr4  = -10. * inv12 * inv_h2[1] + 0.125 * c0mehr4;
+    const double czmehr4  = -10. * inv12 * inv_h2[2] + 0.125 * c0mehr4;
+    const double cxymehr4 = -inv12 * (inv_h2[0] + inv_h2[1]);
+    const double cyzmehr4 = -inv12 * (inv_h2[2] + inv_h2[1]);
+    const double cxzmehr4 = -inv12 * (inv_h2[0] + inv_h2[2]);
+
+    // RHS_Mehr1 coefficients
+    const double r0 = 0.5;
+    const double r1 = inv12;
+
+    const int dim1     = grid.dim(1);
+    const int dim2     = grid.dim(2);
+    const int incx     = grid.inc(0);
+    const int incy     = grid.inc(1);
+    const int gpt      = grid.ghost_pt();
+    const size_t ngpts = grid.sizeg();
+
+    const int incy_b     = dim2 + 2 * b_ghosts;
+    const int incx_b     = incy_b * (dim1 + 2 * b_ghosts);
+    const size_t ngpts_b = incx_b * (grid.dim(0) + 2 * b_ghosts);
+
+    const int ntiles = (box.hi[1] - box.lo[1] + fd_tile_y - 1) / fd_tile_y;
+
+#pragma omp parallel for collapse(2)
+    for (size_t ifunc = 0; ifunc < nfunc; ifunc++)
+    {
+        for (int itile = 0; itile < ntiles; itile++)
+        {
+            const int iy0 = box.lo[1] + itile * fd_tile_y;
+            const int iy1 = std::min(iy0 + fd_tile_y, box.hi[1]);
+
+            const ScalarType* const vf = v + ifunc * ngpts;
+            ScalarType* const bf       = b + ifunc * ngpts_b;
+
+            for (int ix = box.lo[0]; ix < box.hi[0]; ix++)
+            {
+                for (int iy = iy0; iy < iy1; iy++)
+                {
+                    const int iiz = (ix + gpt) * incx + (iy + gpt) * incy + gpt
+                                    + box.lo[2];
+                    const int ibz = (ix + b_ghosts) * incx_b
+                                    + (iy + b_ghosts) * incy_b + b_ghosts
+                                    + box.lo[2];
+
+                    const ScalarType* __restrict__ v0    = vf + iiz;
+                    const ScalarType* __restrict__ vmx   = v0 - incx;
+                    const ScalarType* __restrict__ vpx   = v0 + incx;
+                    const ScalarType* __restrict__ vmy   = v0 - incy;
+                    const ScalarType* __restrict__ vpy   = v0 + incy;
+                    const ScalarType* __restrict__ vmxmy = vmx - incy;
+                    const ScalarType* __restrict__ vpxmy = vpx - incy;
+                    const ScalarType* __restrict__ vmxpy = vmx + incy;
+                    const ScalarType* __restrict__ vpxpy = vpx + incy;
+
+                    // potential has same layout as v (unused if !WithPot)
+                    const double* __restrict__ p0  = pot + iiz;
+                    const double* __restrict__ pmx = p0 - incx;
+                    const double* __restrict__ ppx = p0 + incx;
+                    const double* __restrict__ pmy = p0 - incy;
+                    const double* __restrict__ ppy = p0 + incy;
+
+                    ScalarType* __restrict__ u0 = bf + ibz;
+
+                    const int nz = box.hi[2] - box.lo[2];
+#pragma omp simd
+                    for (int iz = 0; iz < nz; iz++)
+                    {
+                        double val
+                            = c0mehr4 * (double)v0[iz]
+                              + czmehr4 * ((double)v0[iz - 1] + v0[iz + 1])
+                              + cymehr4 * ((double)vmy[iz] + vpy[iz])
+                              + cxmehr4 * ((double)vmx[iz] + vpx[iz])
+                              + cxzmehr4
+                                    * ((double)vmx[iz - 1] + vmx[iz + 1]
+                                        + vpx[iz - 1] + vpx[iz + 1])
+                              + cyzmehr4
+                                    * ((double)vmy[iz - 1] + vmy[iz + 1]
+                                        + vpy[iz - 1] + vpy[iz + 1])
+                              + cxymehr4
+                                    * ((double)vmxmy[iz] + vpxmy[iz]
+                                        + vmxpy[iz] + vpxpy[iz]);
+
+                        if (WithPot)
+                            val += r0 * p0[iz] * v0[iz]
+                                   + r1
+                                         * (pmx[iz] * vmx[iz]
+                                             + ppx[iz] * vpx[iz]
+                                             + pmy[iz] * vmy[iz]
+                                             + ppy[iz] * vpy[iz]
+                                             + p0[iz - 1] * v0[iz - 1]
+                                             + p0[iz + 1] * v0[iz + 1]);
+
+                        u0[iz] = (ScalarType)val;
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <bool WithPot, typename ScalarType>
+void FDkernelMehrStencil(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const short b_ghosts,
+    const size_t nfunc, const StencilRegion region)
+{
+    for (const auto& box : stencilBoxes(grid, 1, region))
+        FDkernelMehrStencil<WithPot>(grid, v, pot, b, b_ghosts, nfunc, box);
+}
+}
+
+template <typename ScalarType>
+void FDkernelDel2_2nd_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region)
+{
+    MemorySpace::assert_is_host_ptr(b);
+    MemorySpace::assert_is_host_ptr(v);
+
+    del2_wpot_tm.start();
+
+    FDkernelStarStencil<1, true>(grid, v, pot, b, 0, nfunc, region);
+
+    del2_wpot_tm.stop();
+}
+
+template <typename ScalarType>
+void FDkernelDel2_4th_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region)
+{
+    MemorySpace::assert_is_host_ptr(b);
+    MemorySpace::assert_is_host_ptr(v);
+
+    del2_wpot_tm.start();
+
+    FDkernelStarStencil<2, true>(grid, v, pot, b, 0, nfunc, region);
+
+    del2_wpot_tm.stop();
+}
+
+template <typename ScalarType>
+void FDkernelDel2_6th_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region)
+{
+    MemorySpace::assert_is_host_ptr(b);
+    MemorySpace::assert_is_host_ptr(v);
+
+    del2_wpot_tm.start();
+
+    FDkernelStarStencil<3, true>(grid, v, pot, b, 0, nfunc, region);
+
+    del2_wpot_tm.stop();
+}
+
+template <typename ScalarType>
+void FDkernelDel2_8th_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region)
+{
+    MemorySpace::assert_is_host_ptr(b);
+    MemorySpace::assert_is_host_ptr(v);
+
+    del2_wpot_tm.start();
+
+    FDkernelStarStencil<4, true>(grid, v, pot, b, 0, nfunc, region);
+
+    del2_wpot_tm.stop();
+}
+
+template <typename ScalarType>
+void FDkernelDel2_4th_Mehr_withPot(const Grid& grid,
+    const ScalarType* const v, const double* const pot, ScalarType* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region)
+{
+    MemorySpace::assert_is_host_ptr(b);
+    MemorySpace::assert_is_host_ptr(v);
+
+    del2_4th_Mehr_wpot_tm.start();
+
+    FDkernelMehrStencil<true>(grid, v, pot, b, 0, nfunc, region);
+
+    del2_4th_Mehr_wpot_tm.stop();
+}
+
+// Laplacians restricted to a region of the subdomain,
+// b with same layout as v (with ghosts)
+template <typename ScalarType>
+void FDkernelDel2(const short lap_type, const Grid& grid,
+    const ScalarType* const v, ScalarType* const b, const size_t nfunc,
+    const StencilRegion region, MemorySpace::Host)
+{
+    MemorySpace::assert_is_host_ptr(b);
+    MemorySpace::assert_is_host_ptr(v);
+
+    del2_region_tm.start();
+
+    const short gpt = grid.ghost_pt();
+    switch (lap_type)
+    {
+        case 0:
+            FDkernelMehrStencil<false>(
+                grid, v, nullptr, b, gpt, nfunc, region);
+            break;
+        case 1:
+            FDkernelStarStencil<1, false>(
+                grid, v, nullptr, b, gpt, nfunc, region);
+            break;
+        case 2:
+            FDkernelStarStencil<2, false>(
+                grid, v, nullptr, b, gpt, nfunc, region);
+            break;
+        case 3:
+            FDkernelStarStencil<3, false>(
+                grid, v, nullptr, b, gpt, nfunc, region);
+            break;
+        case 4:
+            FDkernelStarStencil<4, false>(
+                grid, v, nullptr, b, gpt, nfunc, region);
+            break;
+        default:
+            std::cerr << "FDkernelDel2: invalid Laplacian type " << lap_type
+                      << std::endl;
+            abort();
+    }
+
+    del2_region_tm.stop();
+}
+
 template void FDkernelDel2_2nd<double>(const Grid& grid, double* v, double* b,
     const size_t nfunc, MemorySpace::Host);
 template void FDkernelDel2_2nd<float>(const Grid& grid, float* v, float* b,
@@ -613,6 +1047,48 @@ template void FDkernelRHS_4th_Mehr1<double>(const Grid& grid, double* v,
 template void FDkernelRHS_4th_Mehr1<float>(const Grid& grid, float* v, float* b,
     const short nghosts, const size_t nfunc, MemorySpace::Host);
 
+template void FDkernelDel2_2nd_withPot<double>(const Grid& grid,
+    const double* const v, const double* const pot, double* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+template void FDkernelDel2_2nd_withPot<float>(const Grid& grid,
+    const float* const v, const double* const pot, float* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+
+template void FDkernelDel2_4th_withPot<double>(const Grid& grid,
+    const double* const v, const double* const pot, double* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+template void FDkernelDel2_4th_withPot<float>(const Grid& grid,
+    const float* const v, const double* const pot, float* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+
+template void FDkernelDel2_6th_withPot<double>(const Grid& grid,
+    const double* const v, const double* const pot, double* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+template void FDkernelDel2_6th_withPot<float>(const Grid& grid,
+    const float* const v, const double* const pot, float* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+
+template void FDkernelDel2_8th_withPot<double>(const Grid& grid,
+    const double* const v, const double* const pot, double* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+template void FDkernelDel2_8th_withPot<float>(const Grid& grid,
+    const float* const v, const double* const pot, float* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+
+template void FDkernelDel2_4th_Mehr_withPot<double>(const Grid& grid,
+    const double* const v, const double* const pot, double* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+template void FDkernelDel2_4th_Mehr_withPot<float>(const Grid& grid,
+    const float* const v, const double* const pot, float* const b,
+    const size_t nfunc, MemorySpace::Host, const StencilRegion region);
+
+template void FDkernelDel2<double>(const short lap_type, const Grid& grid,
+    const double* const v, double* const b, const size_t nfunc,
+    const StencilRegion region, MemorySpace::Host);
+template void FDkernelDel2<float>(const short lap_type, const Grid& grid,
+    const float* const v, float* const b, const size_t nfunc,
+    const StencilRegion region, MemorySpace::Host);
+
 #ifdef HAVE_MAGMA
 template void FDkernelDel2_2nd<double>(const Grid& grid, double* v, double* b,
     const size_t nfunc, MemorySpace::Device);
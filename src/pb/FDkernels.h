@@ -11,6 +11,17 @@ namespace pb
 
 void printFDkernelTimers(std::ostream& os);
 
+// part of the local subdomain a stencil is applied to:
+// Interior points, whose stencil does not reach any ghost value,
+// Shell, the complementary points along the subdomain boundary,
+// or All points
+enum class StencilRegion
+{
+    All,
+    Interior,
+    Shell
+};
+
 template <typename ScalarType>
 void FDkernelDel2_2nd(const Grid& grid, ScalarType* v, ScalarType* b,
     const size_t nfunc, MemorySpace::Host);
@@ -35,6 +46,43 @@ template <typename ScalarType>
 void FDkernelRHS_4th_Mehr1(const Grid& grid, ScalarType* v, ScalarType* b,
     const short rhs_ghosts, const size_t nfunc, MemorySpace::Host);
 
+// fused kernels b = -Lap*v + pot*v (pot and b without ghosts)
+template <typename ScalarType>
+void FDkernelDel2_2nd_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region = StencilRegion::All);
+
+template <typename ScalarType>
+void FDkernelDel2_4th_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region = StencilRegion::All);
+
+template <typename ScalarType>
+void FDkernelDel2_6th_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region = StencilRegion::All);
+
+template <typename ScalarType>
+void FDkernelDel2_8th_withPot(const Grid& grid, const ScalarType* const v,
+    const double* const pot, ScalarType* const b, const size_t nfunc,
+    MemorySpace::Host, const StencilRegion region = StencilRegion::All);
+
+// fused kernel b = -Lap_Mehr*v + RHS_Mehr1*(pot*v)
+// (pot with ghosts, b without ghosts)
+template <typename ScalarType>
+void FDkernelDel2_4th_Mehr_withPot(const Grid& grid,
+    const ScalarType* const v, const double* const pot, ScalarType* const b,
+    const size_t nfunc, MemorySpace::Host,
+    const StencilRegion region = StencilRegion::All);
+
+// FD Laplacian of type lap_type (0: Mehrstellen, 1: 2nd order,
+// 2: 4th order, 3: 6th order, 4: 8th order) on one region
+// of the subdomain (b with ghosts)
+template <typename ScalarType>
+void FDkernelDel2(const short lap_type, const Grid& grid,
+    const ScalarType* const v, ScalarType* const b, const size_t nfunc,
+    const StencilRegion region, MemorySpace::Host);
+
 #ifdef HAVE_MAGMA
 template <typename ScalarType>
 void FDkernelDel2_2nd(const Grid& grid, ScalarType* v, ScalarType* b,
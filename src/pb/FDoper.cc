@@ -176,6 +176,71 @@ void FDoper<T>::del1_4th(
 
     B.set_updated_boundaries(0);
 }
+template <class T>
+void FDoper<T>::grad_4th(
+    GridFunc<T>& A, T* const gx, T* const gy, T* const gz) const
+{
+    assert(grid_.ghost_pt() > 1);
+    assert(grid_.ghost_pt() == A.grid().ghost_pt());
+
+    if (!A.updated_boundaries()) A.trade_boundaries();
+
+    const double ex1 = (8. / 12.) * inv_h(0);
+    const double ex2 = inv12 * inv_h(0);
+    const double ey1 = (8. / 12.) * inv_h(1);
+    const double ey2 = inv12 * inv_h(1);
+    const double ez1 = (8. / 12.) * inv_h(2);
+    const double ez2 = inv12 * inv_h(2);
+
+    const int incx  = A.grid().inc(0);
+    const int incy  = A.grid().inc(1);
+    const int incx2 = 2 * incx;
+    const int incy2 = 2 * incy;
+
+    const int dim0 = A.grid().dim(0);
+    const int dim1 = A.grid().dim(1);
+    const int dim2 = A.grid().dim(2);
+
+    const T* const v = A.uu();
+    const int gpt    = grid_.ghost_pt();
+
+#pragma omp parallel for collapse(2)
+    for (int ix = 0; ix < dim0; ix++)
+    {
+        for (int iy = 0; iy < dim1; iy++)
+        {
+            const int iiz = (ix + gpt) * incx + (iy + gpt) * incy + gpt;
+            const int ipz = (ix * dim1 + iy) * dim2;
+
+            const T* __restrict__ v0 = v + iiz;
+            T* __restrict__ ux       = gx + ipz;
+            T* __restrict__ uy       = gy + ipz;
+            T* __restrict__ uz       = gz + ipz;
+
+#pragma omp simd
+            for (int iz = 0; iz < dim2; iz++)
+            {
+                ux[iz] = (T)(ex1
+                                 * ((double)v0[iz + incx]
+                                     - (double)v0[iz - incx])
+                             + ex2
+                                   * ((double)v0[iz - incx2]
+                                       - (double)v0[iz + incx2]));
+                uy[iz] = (T)(ey1
+                                 * ((double)v0[iz + incy]
+                                     - (double)v0[iz - incy])
+                             + ey2
+                                   * ((double)v0[iz - incy2]
+                                       - (double)v0[iz + incy2]));
+                uz[iz] = (T)(ez1 * ((double)v0[iz + 1] - (double)v0[iz - 1])
+                             + ez2
+                                   * ((double)v0[iz - 2]
+                                       - (double)v0[iz + 2]));
+            }
+        }
+    }
+}
+
 template <class T>
 void FDoper<T>::del1_6th(
     GridFunc<T>& A, GridFunc<T>& B, const short direction) const
@@ -318,84 +383,82 @@ void FDoper<T>::del2_4th(GridFunc<T>& A, GridFunc<T>& B) const
     B.set_updated_boundaries(0);
 }
 
+// ghost values are exchanged here only if the whole subdomain
+// is requested: for Interior/Shell, the caller overlaps the
+// exchange with the Interior computation
 template <class T>
-void FDoper<T>::del2_4th_withPot(
-    GridFunc<T>& A, const double* const pot, T* B) const
+static void prepareGhosts(GridFunc<T>& A, const StencilRegion region)
+{
+    if (region == StencilRegion::All)
+    {
+        if (!A.updated_boundaries()) A.trade_boundaries();
+    }
+    else if (region == StencilRegion::Shell)
+    {
+        assert(A.updated_boundaries());
+    }
+}
+
+template <class T>
+void FDoper<T>::del2_4th_withPot(GridFunc<T>& A, const double* const pot,
+    T* B, const StencilRegion region) const
 {
     assert(grid_.ghost_pt() > 1);
 
-    if (!A.updated_boundaries()) A.trade_boundaries();
+    prepareGhosts(A, region);
 
     del2_4th_wpot_tm_.start();
 
-    const double cc0 = inv12 * inv_h2_[0];
-    const double c1x = -16. * cc0;
-    const double c2x = 1. * cc0;
+    FDkernelDel2_4th_withPot(
+        A.grid(), A.uu(), pot, B, 1, MemorySpace::Host(), region);
 
-    const double cc1 = inv12 * inv_h2_[1];
-    const double c1y = -16. * cc1;
-    const double c2y = 1. * cc1;
-
-    const double cc2 = inv12 * inv_h2_[2];
-    const double c1z = -16. * cc2;
-    const double c2z = 1. * cc2;
-
-    const double c0 = -2. * (c1x + c2x + c1y + c2y + c1z + c2z);
-
-    const int gpt = grid_.ghost_pt();
-
-    const int incx2 = 2 * A.grid().inc(0);
-    const int incy2 = 2 * A.grid().inc(1);
-
-    int iix = gpt * incx_;
-    int ipx = 0;
-
-    const int dim0 = A.dim(0);
-    const int dim1 = A.dim(1);
-    const int dim2 = A.dim(2);
-
-    for (int ix = 0; ix < dim0; ix++)
-    {
-        int iiy = iix + gpt * incy_;
+    del2_4th_wpot_tm_.stop();
+}
 
-        for (int iy = 0; iy < dim1; iy++)
-        {
-            int iiz = iiy + gpt;
+template <class T>
+void FDoper<T>::del2_2nd_withPot(GridFunc<T>& A, const double* const pot,
+    T* B, const StencilRegion region) const
+{
+    prepareGhosts(A, region);
 
-            const T* __restrict__ v0   = A.uu(iiz);
-            const T* __restrict__ vmx  = A.uu(iiz - incx_);
-            const T* __restrict__ vpx  = A.uu(iiz + incx_);
-            const T* __restrict__ vmx2 = A.uu(iiz - incx2);
-            const T* __restrict__ vpx2 = A.uu(iiz + incx2);
-            const T* __restrict__ vmy  = A.uu(iiz - incy_);
-            const T* __restrict__ vpy  = A.uu(iiz + incy_);
-            const T* __restrict__ vmy2 = A.uu(iiz - incy2);
-            const T* __restrict__ vpy2 = A.uu(iiz + incy2);
+    FDkernelDel2_2nd_withPot(
+        A.grid(), A.uu(), pot, B, 1, MemorySpace::Host(), region);
+}
 
-            T* __restrict__ u = &B[ipx];
+template <class T>
+void FDoper<T>::del2_6th_withPot(GridFunc<T>& A, const double* const pot,
+    T* B, const StencilRegion region) const
+{
+    assert(grid_.ghost_pt() > 2);
 
-            for (int iz = 0; iz < dim2; iz++)
-            {
-                u[iz] = ((c0 + pot[ipx]) * (double)v0[iz]
+    prepareGhosts(A, region);
 
-                         + c1x * ((double)vmx[iz] + (double)vpx[iz])
-                         + c1y * ((double)vmy[iz] + (double)vpy[iz])
-                         + c1z * ((double)v0[iz - 1] + (double)v0[iz + 1])
+    FDkernelDel2_6th_withPot(
+        A.grid(), A.uu(), pot, B, 1, MemorySpace::Host(), region);
+}
 
-                         + c2x * ((double)vmx2[iz] + (double)vpx2[iz])
-                         + c2y * ((double)vmy2[iz] + (double)vpy2[iz])
-                         + c2z * ((double)v0[iz - 2] + (double)v0[iz + 2]));
+template <class T>
+void FDoper<T>::del2_8th_withPot(GridFunc<T>& A, const double* const pot,
+    T* B, const StencilRegion region) const
+{
+    assert(grid_.ghost_pt() > 3);
 
-                ipx++;
-            }
+    prepareGhosts(A, region);
 
-            iiy += incy_;
-        }
+    FDkernelDel2_8th_withPot(
+        A.grid(), A.uu(), pot, B, 1, MemorySpace::Host(), region);
+}
 
-        iix += incx_;
-    }
+template <class T>
+void FDoper<T>::del2_4th_Mehr_withPot(GridFunc<T>& A,
+    const GridFunc<double>& pot, T* B, const StencilRegion region) const
+{
+    prepareGhosts(A, region);
+    assert(pot.updated_boundaries());
+    assert(pot.grid().sizeg() == A.grid().sizeg());
 
-    del2_4th_wpot_tm_.stop();
+    FDkernelDel2_4th_Mehr_withPot(
+        A.grid(), A.uu(), pot.uu(), B, 1, MemorySpace::Host(), region);
 }
 
 template <class T>
@@ -10,6 +10,7 @@
 #ifndef PB_FDOPER_H
 #define PB_FDOPER_H
 
+#include "FDkernels.h"
 #include "FDoperInterface.h"
 
 #include "Grid.h"
@@ -35,16 +36,25 @@ protected:
 
     void del1_4th(GridFunc<T>&, GridFunc<T>&, const short) const;
     void del2_4th(GridFunc<T>&, GridFunc<T>&) const;
-    void del2_4th_withPot(GridFunc<T>&, const double* const pot, T*) const;
+    void del2_4th_withPot(GridFunc<T>&, const double* const pot, T*,
+        const StencilRegion region = StencilRegion::All) const;
     void del1_2nd(GridFunc<T>&, GridFunc<T>&, const short) const;
     void del2_2nd(GridFunc<T>&, GridFunc<T>&) const;
+    void del2_2nd_withPot(GridFunc<T>&, const double* const pot, T*,
+        const StencilRegion region = StencilRegion::All) const;
     void del1_6th(GridFunc<T>&, GridFunc<T>&, const short) const;
     void del2_6th(GridFunc<T>&, GridFunc<T>&) const;
+    void del2_6th_withPot(GridFunc<T>&, const double* const pot, T*,
+        const StencilRegion region = StencilRegion::All) const;
     void del1_8th(GridFunc<T>&, GridFunc<T>&, const short) const;
     void del2_8th(GridFunc<T>&, GridFunc<T>&) const;
+    void del2_8th_withPot(GridFunc<T>&, const double* const pot, T*,
+        const StencilRegion region = StencilRegion::All) const;
 
     // Mehrstellenverfahren operators
     void del2_4th_Mehr(GridFunc<T>&, GridFunc<T>&) const;
+    void del2_4th_Mehr_withPot(GridFunc<T>&, const GridFunc<double>& pot, T*,
+        const StencilRegion region = StencilRegion::All) const;
     void rhs_4th_Mehr1(GridFunc<T>&, GridFunc<T>&) const;
     void rhs_4th_Mehr1(GridFunc<T>&, T* const) const;
     void rhs_4th_Mehr2(GridFunc<T>&, GridFunc<T>&) const;
@@ -63,6 +73,10 @@ public:
 
     void smooth(GridFunc<T>&, GridFunc<T>&, const double);
 
+    // 4th order gradient of A computed in one pass over the grid,
+    // results stored in arrays without ghosts
+    void grad_4th(GridFunc<T>& A, T* const gx, T* const gy, T* const gz) const;
+
     virtual void transform(GridFunc<T>&) const {};
     virtual void inv_transform(GridFunc<T>&) const {};
     virtual void rhs(GridFunc<T>& A, GridFunc<T>& B) const
@@ -39,6 +39,9 @@ Timer GridFuncInterface::finishExchangeNorthSouth_tm_(
 Timer GridFuncInterface::finishExchangeUpDown_tm_("GridFunc::finishExUpDown");
 Timer GridFuncInterface::finishExchangeEastWest_tm_(
     "GridFunc::finishExEastWest");
+Timer GridFuncInterface::comm_setup_tm_("GridFunc::comm_setup");
+
+bool GridFuncInterface::persistent_comm_ = false;
 
 template <typename T>
 std::vector<T> GridFunc<T>::buf1_;
@@ -48,6 +51,8 @@ template <typename T>
 std::vector<T> GridFunc<T>::buf3_;
 template <typename T>
 std::vector<T> GridFunc<T>::buf4_;
+template <typename T>
+PersistentRequests GridFunc<T>::buf_requests_(comm_setup_tm_);
 
 template <typename T>
 T GridFunc<T>::ran0()
@@ -348,6 +353,17 @@ void GridFunc<T>::setValues(const GridFunc<T>& src)
     setValues(src.grid_.sizeg(), src.uu());
 }
 
+template <typename T>
+template <typename T2>
+void GridFunc<T>::setValues(const GridFunc<T2>& src)
+{
+    assert(src.grid().sizeg() == grid_.sizeg());
+
+    MPcpy(uu_, src.uu(), grid_.sizeg());
+
+    updated_boundaries_ = src.updated_boundaries();
+}
+
 template <typename T>
 GridFunc<T>& GridFunc<T>::operator=(const GridFunc<T>& func)
 {
@@ -531,6 +547,18 @@ void GridFunc<T>::axpy(const double alpha, const GridFunc<T>& vv)
     updated_boundaries_ = (vv.updated_boundaries() && updated_boundaries_);
 }
 
+template <typename T>
+template <typename T2>
+void GridFunc<T>::axpy(const double alpha, const GridFunc<T2>& vv)
+{
+    assert(vv.grid().sizeg() == grid_.sizeg());
+
+    int n = grid_.sizeg();
+    LinearAlgebraUtils<MemorySpace::Host>::MPaxpy(n, alpha, vv.uu(), uu_);
+
+    updated_boundaries_ = (vv.updated_boundaries() && updated_boundaries_);
+}
+
 template <typename T>
 void GridFunc<T>::prod(const GridFunc<T>& A, const GridFunc<T>& B)
 {
@@ -1077,8 +1105,6 @@ void GridFunc<T>::allGather(T* global_func) const
 
     all_gather_tm_.start();
 
-    MGmol_MPI& mmpi = *(MGmol_MPI::instance());
-
     const int gincx = grid_.gdim(1) * grid_.gdim(2);
     const int gincy = grid_.gdim(2);
 
@@ -1116,7 +1142,7 @@ void GridFunc<T>::allGather(T* global_func) const
     const int gsize    = sizeg * ntasks;
     const size_t sdim2 = ldim[2] * sizeof(T);
     T* buffer          = new T[gsize];
-    mmpi.allGather(uu_, sizeg, buffer, gsize);
+    mype_env().allGather(uu_, sizeg, buffer);
 
     for (int i = 0; i < ntasks; i++)
         for (int ii = 0; ii < ldim[0]; ii++)
@@ -1311,6 +1337,94 @@ void GridFunc<T>::scatterFrom(const GridFunc<T>& src)
     scatter_tm_.stop();
 }
 
+// copy between local blocks of values of tasks merged by
+// PEenv::agglomerate() (ordered by position in group) and the values
+// on the agglomerated subdomain
+template <typename T>
+static void copyAgglomeratedBlocks(const PEenv& mype_env, const int ldim[3],
+    T* blocks, T* values, const bool to_values)
+{
+    const int f[3] = { mype_env.agglomeration_factor(0),
+        mype_env.agglomeration_factor(1), mype_env.agglomeration_factor(2) };
+    const int nblock = ldim[0] * ldim[1] * ldim[2];
+    const int incx   = f[1] * ldim[1] * f[2] * ldim[2];
+    const int incy   = f[2] * ldim[2];
+
+    for (int mx = 0; mx < f[0]; mx++)
+        for (int my = 0; my < f[1]; my++)
+            for (int mz = 0; mz < f[2]; mz++)
+            {
+                const int member = (mx * f[1] + my) * f[2] + mz;
+                T* const block   = blocks + member * nblock;
+                T* const start = values + mx * ldim[0] * incx
+                                 + my * ldim[1] * incy + mz * ldim[2];
+                for (int ix = 0; ix < ldim[0]; ix++)
+                    for (int iy = 0; iy < ldim[1]; iy++)
+                    {
+                        T* const pblock
+                            = block + (ix * ldim[1] + iy) * ldim[2];
+                        T* const pval = start + ix * incx + iy * incy;
+                        if (to_values)
+                            memcpy(pval, pblock, ldim[2] * sizeof(T));
+                        else
+                            memcpy(pblock, pval, ldim[2] * sizeof(T));
+                    }
+            }
+}
+
+// Must be called from all the PEs simultaneously!
+template <typename T>
+void GridFunc<T>::gatherAgglomerated(GridFunc<T>* dst) const
+{
+    const int ldim[3] = { dim(0), dim(1), dim(2) };
+    const int size    = grid_.size();
+
+    std::vector<T> local(size);
+    getValues<T, MemorySpace::Host>(local.data());
+
+    if (dst == nullptr)
+    {
+        mype_env().gatherAgglomeration(local.data(), size, nullptr);
+        return;
+    }
+
+    assert(dst->grid().size() % size == 0);
+    std::vector<T> blocks(dst->grid().size());
+    mype_env().gatherAgglomeration(local.data(), size, blocks.data());
+
+    std::vector<T> values(dst->grid().size());
+    copyAgglomeratedBlocks(
+        mype_env(), ldim, blocks.data(), values.data(), true);
+    dst->assign(values.data(), 'd');
+}
+
+// Must be called from all the PEs simultaneously!
+template <typename T>
+void GridFunc<T>::scatterAgglomerated(const GridFunc<T>* src)
+{
+    const int ldim[3] = { dim(0), dim(1), dim(2) };
+    const int size    = grid_.size();
+
+    std::vector<T> local(size);
+    if (src == nullptr)
+    {
+        mype_env().scatterAgglomeration(nullptr, size, local.data());
+    }
+    else
+    {
+        assert(src->grid().size() % size == 0);
+        std::vector<T> values(src->grid().size());
+        src->template getValues<T, MemorySpace::Host>(values.data());
+
+        std::vector<T> blocks(src->grid().size());
+        copyAgglomeratedBlocks(
+            mype_env(), ldim, blocks.data(), values.data(), false);
+        mype_env().scatterAgglomeration(blocks.data(), size, local.data());
+    }
+
+    assign(local.data(), 'd');
+}
+
 // Initialize a global array from a GridFunc<T> object shifted by half
 // the global grid size
 template <typename T>
@@ -1871,8 +1985,10 @@ void GridFunc<T>::initiateExchangeNorthSouth()
         const int shift = ghost_pt();
 
         const size_t sizeb = shift * dim_[2] * dim_[0];
-        if (north_) mype_env().Irecv(&buf4_[0], sizeb, NORTH, &ns_mpireq_[3]);
-        if (south_) mype_env().Irecv(&buf3_[0], sizeb, SOUTH, &ns_mpireq_[1]);
+        if (north_)
+            irecv(&buf4_[0], sizeb, NORTH, &ns_mpireq_[3], buf_requests_);
+        if (south_)
+            irecv(&buf3_[0], sizeb, SOUTH, &ns_mpireq_[1], buf_requests_);
 
         const int imax     = (dim_[0] + shift) * incx_;
         const int imin     = shift * incx_;
@@ -1890,7 +2006,7 @@ void GridFunc<T>::initiateExchangeNorthSouth()
                     memcpy(buf2_ptr, &uus[i + j], sdimz);
                     buf2_ptr += dim_[2];
                 }
-            mype_env().Isend(&buf2_[0], sizeb, SOUTH, &ns_mpireq_[2]);
+            isend(&buf2_[0], sizeb, SOUTH, &ns_mpireq_[2], buf_requests_);
         }
 
         if (north_)
@@ -1903,7 +2019,7 @@ void GridFunc<T>::initiateExchangeNorthSouth()
                     memcpy(buf1_ptr, &uus[i + j], sdimz);
                     buf1_ptr += dim_[2];
                 }
-            mype_env().Isend(&buf1_[0], sizeb, NORTH, &ns_mpireq_[0]);
+            isend(&buf1_[0], sizeb, NORTH, &ns_mpireq_[0], buf_requests_);
         }
     }
 }
@@ -1988,12 +2104,12 @@ void GridFunc<T>::initiateExchangeUpDown()
         if (down_)
         {
             // icount++;
-            mype_env().Irecv(&buf3_[0], sizeb, DOWN, &ud_mpireq_[1]);
+            irecv(&buf3_[0], sizeb, DOWN, &ud_mpireq_[1], buf_requests_);
         }
         if (up_)
         {
             // icount++;
-            mype_env().Irecv(&buf4_[0], sizeb, UP, &ud_mpireq_[3]);
+            irecv(&buf4_[0], sizeb, UP, &ud_mpireq_[3], buf_requests_);
         }
 
         const T* const uus = &uu_[shift + incy_ * iinit];
@@ -2007,7 +2123,7 @@ void GridFunc<T>::initiateExchangeUpDown()
                 buf1_ptr += dimxy;
             }
             // icount++;
-            mype_env().Isend(&buf1_[0], sizeb, UP, &ud_mpireq_[0]);
+            isend(&buf1_[0], sizeb, UP, &ud_mpireq_[0], buf_requests_);
         }
         if (down_)
         {
@@ -2018,7 +2134,7 @@ void GridFunc<T>::initiateExchangeUpDown()
                 buf2_ptr += dimxy;
             }
             // icount++;
-            mype_env().Isend(&buf2_[0], sizeb, DOWN, &ud_mpireq_[2]);
+            isend(&buf2_[0], sizeb, DOWN, &ud_mpireq_[2], buf_requests_);
         }
     }
 }
@@ -2098,10 +2214,10 @@ void GridFunc<T>::initiateExchangeEastWest()
 
         /* Non-blocking MPI */
         if (east_)
-            mype_env().Irecv(&uu_[xmax + size], size, EAST, &ew_mpireq_[3]);
-        if (west_) mype_env().Irecv(uu_, size, WEST, &ew_mpireq_[2]);
-        if (west_) mype_env().Isend(&uu_[size], size, WEST, &ew_mpireq_[1]);
-        if (east_) mype_env().Isend(&uu_[xmax], size, EAST, &ew_mpireq_[0]);
+            irecv(&uu_[xmax + size], size, EAST, &ew_mpireq_[3], ew_requests_);
+        if (west_) irecv(uu_, size, WEST, &ew_mpireq_[2], ew_requests_);
+        if (west_) isend(&uu_[size], size, WEST, &ew_mpireq_[1], ew_requests_);
+        if (east_) isend(&uu_[xmax], size, EAST, &ew_mpireq_[0], ew_requests_);
     }
 }
 
@@ -3497,6 +3613,9 @@ void GridFunc<T>::resizeBuffers()
 
         if (size_max > (int)buf1_.size())
         {
+            // requests refer to old buffers
+            buf_requests_.clear();
+
             buf1_.resize(size_max);
             buf2_.resize(size_max);
             buf3_.resize(size_max);
@@ -3522,6 +3641,11 @@ template void GridFunc<double>::assign(const float* const, const char dis);
 template void GridFunc<float>::assign(const double* const, const char dis);
 template void GridFunc<float>::assign(const float* const, const char dis);
 
+template void GridFunc<double>::setValues(const GridFunc<float>&);
+template void GridFunc<float>::setValues(const GridFunc<double>&);
+
+template void GridFunc<double>::axpy(const double, const GridFunc<float>&);
+
 #ifdef HAVE_MAGMA
 template void GridFunc<double>::getValues<double, MemorySpace::Device>(
     double*) const;
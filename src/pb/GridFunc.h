@@ -12,6 +12,7 @@
 
 #include "Grid.h"
 #include "GridFuncInterface.h"
+#include "PersistentRequests.h"
 #include "Timer.h"
 
 #include <complex>
@@ -44,6 +45,10 @@ class GridFunc : public GridFuncInterface
     MPI_Request ud_mpireq_[4];
     MPI_Request ew_mpireq_[4];
 
+    // persistent requests for exchanges in x direction,
+    // which use uu_ directly as send/receive buffers
+    PersistentRequests ew_requests_{ comm_setup_tm_ };
+
     bool north_;
     bool south_;
     bool up_;
@@ -75,6 +80,25 @@ class GridFunc : public GridFuncInterface
 
     void resizeBuffers();
 
+    // post non-blocking send/receive with neighbor in direction dir,
+    // using persistent requests if persistent_comm_ is set
+    void isend(T* buf, const int sizeb, const short dir, MPI_Request* req,
+        PersistentRequests& requests) const
+    {
+        if (persistent_comm_)
+            requests.startSend(mype_env(), buf, sizeb, dir, req);
+        else
+            mype_env().Isend(buf, sizeb, dir, req);
+    }
+    void irecv(T* buf, const int sizeb, const short dir, MPI_Request* req,
+        PersistentRequests& requests) const
+    {
+        if (persistent_comm_)
+            requests.startRecv(mype_env(), buf, sizeb, dir, req);
+        else
+            mype_env().Irecv(buf, sizeb, dir, req);
+    }
+
 protected:
     const Grid& grid_;
 
@@ -95,6 +119,9 @@ protected:
     static std::vector<T> buf3_;
     static std::vector<T> buf4_;
 
+    // persistent requests for exchanges using buf1_,...,buf4_
+    static PersistentRequests buf_requests_;
+
     void setValues(const int n, const T* src, const int pos = 0);
 
 public:
@@ -115,11 +142,21 @@ public:
     void setValues(const GridFunc<T>& src);
     void setValues(const T val);
 
+    // copy values (including ghosts) of a GridFunc in other precision
+    template <typename T2>
+    void setValues(const GridFunc<T2>& src);
+
     int inc(const short dir) const { return grid_.inc(dir); }
 
     void assign(const GridFunc<T>& src, const char dis);
     void scatterFrom(const GridFunc<T>& src);
 
+    // transfers between this and a GridFunc defined on the agglomerated
+    // Grid (see PEenv::agglomerate()).
+    // dst/src is nullptr on tasks not part of the agglomerated PEenv
+    void gatherAgglomerated(GridFunc<T>* dst) const;
+    void scatterAgglomerated(const GridFunc<T>* src);
+
     double fmax();
 
     template <typename T2, typename MemorySpaceType>
@@ -193,6 +230,8 @@ public:
     GridFunc<T>& operator/=(const GridFunc<T>& B);
 
     void axpy(const double alpha, const GridFunc<T>& vv);
+    template <typename T2>
+    void axpy(const double alpha, const GridFunc<T2>& vv);
     void scal(const double alpha);
     void prod(const GridFunc<T>& A, const GridFunc<T>& B);
     void diff(const GridFunc<T>& A, const GridFunc<T>& B);
@@ -28,16 +28,24 @@ protected:
     static Timer finishExchangeNorthSouth_tm_;
     static Timer finishExchangeUpDown_tm_;
     static Timer finishExchangeEastWest_tm_;
+    static Timer comm_setup_tm_;
+
+    // use persistent MPI requests for ghost values exchanges
+    static bool persistent_comm_;
 
 public:
     virtual ~GridFuncInterface() {}
 
+    static void setPersistentComm(const bool flag) { persistent_comm_ = flag; }
+    static bool persistentComm() { return persistent_comm_; }
+
     static void printTimers(std::ostream& os)
     {
         trade_bc_tm_.print(os);
         finishExchangeNorthSouth_tm_.print(os);
         finishExchangeUpDown_tm_.print(os);
         finishExchangeEastWest_tm_.print(os);
+        comm_setup_tm_.print(os);
         extend3D_tm_.print(os);
         restrict3D_tm_.print(os);
         prod_tm_.print(os);
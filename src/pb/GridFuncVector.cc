@@ -210,6 +210,9 @@ void GridFuncVector<ScalarType, MemorySpaceType>::allocate_buffers(
         size_max += nfunc * nsubdivx_; // to pack gids
         size_max += 1; // to pack number of functions (data) in buffer
 
+        // requests refer to old buffers
+        persistent_requests_.clear();
+
         comm_buf1_.resize(3);
         comm_buf2_.resize(3);
         comm_buf3_.resize(3);
@@ -242,11 +245,9 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateNorthSouthComm(
     const size_t sizebuffer = 1 + nfunc_max_global_ * south_north_size_;
     const size_t sdimz      = dimz_ * sizeof(ScalarType);
     if (north_)
-        grid_.mype_env().Irecv(
-            &comm_buf4[0], sizebuffer, NORTH, &req_north_south_[3]);
+        irecv(&comm_buf4[0], sizebuffer, NORTH, &req_north_south_[3]);
     if (south_)
-        grid_.mype_env().Irecv(
-            &comm_buf3[0], sizebuffer, SOUTH, &req_north_south_[1]);
+        irecv(&comm_buf3[0], sizebuffer, SOUTH, &req_north_south_[1]);
 
     const int imin = nghosts_ * incx_;
     const int iinc = incx_ * dimx_ / nsubdivx_;
@@ -280,8 +281,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateNorthSouthComm(
             }
         }
 
-        grid_.mype_env().Isend(&comm_buf2[0], 1 + ncolors * south_north_size_,
-            SOUTH, &req_north_south_[2]);
+        isend(&comm_buf2[0], 1 + ncolors * south_north_size_, SOUTH,
+            &req_north_south_[2]);
     }
 
     if (north_)
@@ -309,8 +310,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateNorthSouthComm(
             }
         }
 
-        grid_.mype_env().Isend(&comm_buf1[0], 1 + ncolors * south_north_size_,
-            NORTH, &req_north_south_[0]);
+        isend(&comm_buf1[0], 1 + ncolors * south_north_size_, NORTH,
+            &req_north_south_[0]);
     }
 }
 template <typename ScalarType, typename MemorySpaceType>
@@ -328,11 +329,9 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateNorthSouthComm(
 
     const size_t sizebuffer = 1 + nfunc_max_global_ * south_north_size_;
     if (north_)
-        grid_.mype_env().Irecv(
-            &comm_buf4[0], sizebuffer, NORTH, &req_north_south_[3]);
+        irecv(&comm_buf4[0], sizebuffer, NORTH, &req_north_south_[3]);
     if (south_)
-        grid_.mype_env().Irecv(
-            &comm_buf3[0], sizebuffer, SOUTH, &req_north_south_[1]);
+        irecv(&comm_buf3[0], sizebuffer, SOUTH, &req_north_south_[1]);
 
     const int imin = nghosts_ * incx_;
     const int iinc = incx_ * dimx_ / nsubdivx_;
@@ -387,8 +386,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateNorthSouthComm(
 
         MemorySpace::copy_to_host(buf2_alias, sizebuffer - 1, buf2_ptr);
 
-        grid_.mype_env().Isend(&comm_buf2[0], 1 + ncolors * south_north_size_,
-            SOUTH, &req_north_south_[2]);
+        isend(&comm_buf2[0], 1 + ncolors * south_north_size_, SOUTH,
+            &req_north_south_[2]);
     }
 
     if (north_)
@@ -428,8 +427,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateNorthSouthComm(
 
         MemorySpace::copy_to_host(buf1_alias, sizebuffer - 1, buf1_ptr);
 
-        grid_.mype_env().Isend(&comm_buf1[0], 1 + ncolors * south_north_size_,
-            NORTH, &req_north_south_[0]);
+        isend(&comm_buf1[0], 1 + ncolors * south_north_size_, NORTH,
+            &req_north_south_[0]);
     }
 }
 
@@ -762,12 +761,11 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateUpDownComm(
 
     if (down_)
     {
-        grid_.mype_env().Irecv(
-            &comm_buf3[0], sizebuffer, DOWN, &req_up_down_[1]);
+        irecv(&comm_buf3[0], sizebuffer, DOWN, &req_up_down_[1]);
     }
     if (up_)
     {
-        grid_.mype_env().Irecv(&comm_buf4[0], sizebuffer, UP, &req_up_down_[3]);
+        irecv(&comm_buf4[0], sizebuffer, UP, &req_up_down_[3]);
     }
 
     if (up_)
@@ -794,8 +792,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateUpDownComm(
             }
         }
 
-        grid_.mype_env().Isend(
-            &comm_buf1[0], 1 + ncolors * up_down_size_, UP, &req_up_down_[0]);
+        isend(&comm_buf1[0], 1 + ncolors * up_down_size_, UP, &req_up_down_[0]);
     }
     if (down_)
     {
@@ -821,8 +818,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateUpDownComm(
             }
         }
 
-        grid_.mype_env().Isend(
-            &comm_buf2[0], 1 + ncolors * up_down_size_, DOWN, &req_up_down_[2]);
+        isend(&comm_buf2[0], 1 + ncolors * up_down_size_, DOWN,
+            &req_up_down_[2]);
     }
 }
 template <typename ScalarType, typename MemorySpaceType>
@@ -844,12 +841,11 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateUpDownComm(
 
     if (down_)
     {
-        grid_.mype_env().Irecv(
-            &comm_buf3[0], sizebuffer, DOWN, &req_up_down_[1]);
+        irecv(&comm_buf3[0], sizebuffer, DOWN, &req_up_down_[1]);
     }
     if (up_)
     {
-        grid_.mype_env().Irecv(&comm_buf4[0], sizebuffer, UP, &req_up_down_[3]);
+        irecv(&comm_buf4[0], sizebuffer, UP, &req_up_down_[3]);
     }
 
     auto nghosts           = nghosts_;
@@ -893,8 +889,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateUpDownComm(
 
         MemorySpace::copy_to_host(buf1_alias, sizebuffer - 1, buf1_ptr);
 
-        grid_.mype_env().Isend(
-            &comm_buf1[0], 1 + ncolors * up_down_size_, UP, &req_up_down_[0]);
+        isend(&comm_buf1[0], 1 + ncolors * up_down_size_, UP, &req_up_down_[0]);
     }
     if (down_)
     {
@@ -929,8 +924,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateUpDownComm(
 
         MemorySpace::copy_to_host(buf2_alias, sizebuffer - 1, buf2_ptr);
 
-        grid_.mype_env().Isend(
-            &comm_buf2[0], 1 + ncolors * up_down_size_, DOWN, &req_up_down_[2]);
+        isend(&comm_buf2[0], 1 + ncolors * up_down_size_, DOWN,
+            &req_up_down_[2]);
     }
 }
 template <typename ScalarType, typename MemorySpaceType>
@@ -1208,11 +1203,9 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateEastWestComm(
 
     /* Non-blocking MPI */
     if (east_)
-        grid_.mype_env().Irecv(
-            &comm_buf3[0], sizebuffer, EAST, &req_east_west_[3]);
+        irecv(&comm_buf3[0], sizebuffer, EAST, &req_east_west_[3]);
     if (west_)
-        grid_.mype_env().Irecv(
-            &comm_buf4[0], sizebuffer, WEST, &req_east_west_[2]);
+        irecv(&comm_buf4[0], sizebuffer, WEST, &req_east_west_[2]);
 
     if (west_)
     {
@@ -1231,8 +1224,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateEastWestComm(
             buf1_ptr += east_west_size_;
         }
 
-        grid_.mype_env().Isend(
-            &comm_buf1[0], sizebuffer, WEST, &req_east_west_[1]);
+        isend(&comm_buf1[0], sizebuffer, WEST, &req_east_west_[1]);
     }
     if (east_)
     {
@@ -1250,8 +1242,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateEastWestComm(
             memcpy(buf2_ptr, pu, east_west_size_data);
             buf2_ptr += east_west_size_;
         }
-        grid_.mype_env().Isend(
-            &comm_buf2[0], sizebuffer, EAST, &req_east_west_[0]);
+        isend(&comm_buf2[0], sizebuffer, EAST, &req_east_west_[0]);
     }
 }
 template <typename ScalarType, typename MemorySpaceType>
@@ -1272,11 +1263,9 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateEastWestComm(
 
     /* Non-blocking MPI */
     if (east_)
-        grid_.mype_env().Irecv(
-            &comm_buf3[0], sizebuffer, EAST, &req_east_west_[3]);
+        irecv(&comm_buf3[0], sizebuffer, EAST, &req_east_west_[3]);
     if (west_)
-        grid_.mype_env().Irecv(
-            &comm_buf4[0], sizebuffer, WEST, &req_east_west_[2]);
+        irecv(&comm_buf4[0], sizebuffer, WEST, &req_east_west_[2]);
 
     auto size_per_function = grid_.sizeg();
     auto east_west_size    = east_west_size_;
@@ -1312,8 +1301,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateEastWestComm(
 
         MemorySpace::copy_to_host(buf1_alias, sizebuffer - 1, buf1_ptr);
 
-        grid_.mype_env().Isend(
-            &comm_buf1[0], sizebuffer, WEST, &req_east_west_[1]);
+        isend(&comm_buf1[0], sizebuffer, WEST, &req_east_west_[1]);
     }
     if (east_)
     {
@@ -1343,8 +1331,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::initiateEastWestComm(
 
         MemorySpace::copy_to_host(buf2_alias, sizebuffer - 1, buf2_ptr);
 
-        grid_.mype_env().Isend(
-            &comm_buf2[0], sizebuffer, EAST, &req_east_west_[0]);
+        isend(&comm_buf2[0], sizebuffer, EAST, &req_east_west_[0]);
     }
 }
 template <typename ScalarType, typename MemorySpaceType>
@@ -1545,6 +1532,19 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries()
 {
     if (updated_boundaries_) return;
 
+    initiateTradeBoundaries();
+    finishTradeBoundaries();
+}
+
+// post messages for ghost values exchange. For a skinny stencil, all
+// directions are posted at once, otherwise only north/south, the others
+// depending on the values received in that direction
+template <typename ScalarType, typename MemorySpaceType>
+void GridFuncVector<ScalarType, MemorySpaceType>::initiateTradeBoundaries()
+{
+    assert(!updated_boundaries_);
+    assert(!trade_in_progress_);
+
     assert(dimx_ >= nghosts_);
     assert(dimy_ >= nghosts_);
     assert(dimz_ >= nghosts_);
@@ -1569,45 +1569,55 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries()
     {
         initiateNorthSouthComm(0, nfunc_);
     }
-    if (!skinny_stencil_)
-    {
-        wait_north_south();
-        finishNorthSouthComm();
-    }
 
-    if (grid_.mype_env().n_mpi_task(2) > 1)
-    {
-        initiateUpDownComm(0, nfunc_);
-    }
-    if (!skinny_stencil_)
+    if (skinny_stencil_)
     {
-        wait_up_down();
-        finishUpDownComm();
+        if (grid_.mype_env().n_mpi_task(2) > 1)
+        {
+            initiateUpDownComm(0, nfunc_);
+        }
+        if (grid_.mype_env().n_mpi_task(0) > 1)
+        {
+            initiateEastWestComm(0, nfunc_);
+        }
     }
 
-    if (grid_.mype_env().n_mpi_task(0) > 1)
-    {
-        initiateEastWestComm(0, nfunc_);
-    }
+    trade_in_progress_ = true;
+
+    trade_bc_tm_.stop();
+}
+
+template <typename ScalarType, typename MemorySpaceType>
+void GridFuncVector<ScalarType, MemorySpaceType>::finishTradeBoundaries()
+{
+    assert(trade_in_progress_);
+
+    trade_bc_tm_.start();
+
+    wait_north_south();
+    finishNorthSouthComm();
 
     if (!skinny_stencil_)
     {
-        wait_east_west();
-        finishEastWestComm();
+        if (grid_.mype_env().n_mpi_task(2) > 1)
+        {
+            initiateUpDownComm(0, nfunc_);
+        }
     }
+    wait_up_down();
+    finishUpDownComm();
 
-    if (skinny_stencil_)
+    if (!skinny_stencil_)
     {
-        wait_north_south();
-        finishNorthSouthComm();
-
-        wait_up_down();
-        finishUpDownComm();
-
-        wait_east_west();
-        finishEastWestComm();
+        if (grid_.mype_env().n_mpi_task(0) > 1)
+        {
+            initiateEastWestComm(0, nfunc_);
+        }
     }
+    wait_east_west();
+    finishEastWestComm();
 
+    trade_in_progress_  = false;
     updated_boundaries_ = true;
 
     for (int k = 0; k < nfunc_; k++)
@@ -1620,6 +1630,27 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries()
     copyDtoH(nfunc_ * grid_.sizeg());
 #endif
 }
+
+template <typename ScalarType, typename MemorySpaceType>
+void GridFuncVector<ScalarType, MemorySpaceType>::applyLapOverlapComm(
+    const int type, GridFuncVector<ScalarType, MemorySpaceType>& rhs)
+{
+    assert(!updated_boundaries_);
+
+    initiateTradeBoundaries();
+
+    // interior points do not need ghost values
+    FDkernelDel2(type, grid_, data(), rhs.data(), nfunc_,
+        StencilRegion::Interior, MemorySpace::Host());
+
+    finishTradeBoundaries();
+
+    FDkernelDel2(type, grid_, data(), rhs.data(), nfunc_, StencilRegion::Shell,
+        MemorySpace::Host());
+
+    rhs.set_updated_boundaries(0);
+}
+
 template <typename ScalarType, typename MemorySpaceType>
 void GridFuncVector<ScalarType, MemorySpaceType>::restrict3D(
     GridFuncVector& ucoarse)
@@ -1789,11 +1820,9 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
 
         const size_t sizebuffer = 1 + ncolors * south_north_size_;
         if (north_)
-            grid_.mype_env().Irecv(
-                &comm_buf4[0], sizebuffer, NORTH, &req_north_south_[3]);
+            irecv(&comm_buf4[0], sizebuffer, NORTH, &req_north_south_[3]);
         if (south_)
-            grid_.mype_env().Irecv(
-                &comm_buf3[0], sizebuffer, SOUTH, &req_north_south_[1]);
+            irecv(&comm_buf3[0], sizebuffer, SOUTH, &req_north_south_[1]);
 
         const int imin = nghosts_ * incx_;
         const int iinc = incx_ * dimx_ / nsubdivx_;
@@ -1828,8 +1857,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
                         }
                 }
             }
-            grid_.mype_env().Isend(&comm_buf2[0],
-                1 + ncolors * south_north_size_, SOUTH, &req_north_south_[2]);
+            isend(&comm_buf2[0], 1 + ncolors * south_north_size_, SOUTH,
+                &req_north_south_[2]);
         }
 
         if (north_)
@@ -1858,8 +1887,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
                         }
                 }
             }
-            grid_.mype_env().Isend(&comm_buf1[0],
-                1 + ncolors * south_north_size_, NORTH, &req_north_south_[0]);
+            isend(&comm_buf1[0], 1 + ncolors * south_north_size_, NORTH,
+                &req_north_south_[0]);
         }
 
         wait_north_south();
@@ -2019,13 +2048,11 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
         if (down_)
         {
             assert(sizebuffer <= static_cast<int>(comm_buf3.size()));
-            grid_.mype_env().Irecv(
-                &comm_buf3[0], sizebuffer, DOWN, &req_up_down_[1]);
+            irecv(&comm_buf3[0], sizebuffer, DOWN, &req_up_down_[1]);
         }
         if (up_)
         {
-            grid_.mype_env().Irecv(
-                &comm_buf4[0], sizebuffer, UP, &req_up_down_[3]);
+            irecv(&comm_buf4[0], sizebuffer, UP, &req_up_down_[3]);
         }
 
         if (up_)
@@ -2054,8 +2081,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
                     }
                 }
             }
-            grid_.mype_env().Isend(&comm_buf1[0], 1 + ncolors * up_down_size_,
-                UP, &req_up_down_[0]);
+            isend(&comm_buf1[0], 1 + ncolors * up_down_size_, UP,
+                &req_up_down_[0]);
         }
         if (down_)
         {
@@ -2082,8 +2109,8 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
                     }
                 }
             }
-            grid_.mype_env().Isend(&comm_buf2[0], 1 + ncolors * up_down_size_,
-                DOWN, &req_up_down_[2]);
+            isend(&comm_buf2[0], 1 + ncolors * up_down_size_, DOWN,
+                &req_up_down_[2]);
         }
 
         wait_up_down();
@@ -2215,11 +2242,9 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
 
         /* Non-blocking MPI */
         if (east_)
-            grid_.mype_env().Irecv(
-                &comm_buf3[0], sizebuffer, EAST, &req_east_west_[3]);
+            irecv(&comm_buf3[0], sizebuffer, EAST, &req_east_west_[3]);
         if (west_)
-            grid_.mype_env().Irecv(
-                &comm_buf4[0], sizebuffer, WEST, &req_east_west_[2]);
+            irecv(&comm_buf4[0], sizebuffer, WEST, &req_east_west_[2]);
 
         if (west_)
         {
@@ -2251,8 +2276,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
                 }
                 buf1_ptr += east_west_size_;
             }
-            grid_.mype_env().Isend(
-                &comm_buf1[0], sizebuffer, WEST, &req_east_west_[1]);
+            isend(&comm_buf1[0], sizebuffer, WEST, &req_east_west_[1]);
         }
         if (east_)
         {
@@ -2283,8 +2307,7 @@ void GridFuncVector<ScalarType, MemorySpaceType>::trade_boundaries_colors(
                 }
                 buf2_ptr += east_west_size_;
             }
-            grid_.mype_env().Isend(
-                &comm_buf2[0], sizebuffer, EAST, &req_east_west_[0]);
+            isend(&comm_buf2[0], sizebuffer, EAST, &req_east_west_[0]);
         }
 
         wait_east_west();
@@ -2370,6 +2393,14 @@ template <typename ScalarType, typename MemorySpaceType>
 void GridFuncVector<ScalarType, MemorySpaceType>::applyLap(
     const int type, GridFuncVector<ScalarType, MemorySpaceType>& rhs)
 {
+    // kernels restricted to a region are implemented on host only
+    if (overlap_comm_ && !updated_boundaries_
+        && std::is_same<MemorySpaceType, MemorySpace::Host>::value)
+    {
+        applyLapOverlapComm(type, rhs);
+        return;
+    }
+
     switch (type)
     {
         // Laph4M
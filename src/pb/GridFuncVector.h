@@ -38,9 +38,14 @@ class GridFuncVector
     static Timer wait_north_south_tm_;
     static Timer wait_up_down_tm_;
     static Timer wait_east_west_tm_;
+    static Timer comm_setup_tm_;
 
     static Map2Masks* map2masks_;
 
+    // overlap ghost values exchange with stencil application
+    // on interior points
+    static bool overlap_comm_;
+
     // block of memory for all GridFunc
     std::unique_ptr<ScalarType> memory_;
 
@@ -72,6 +77,10 @@ class GridFuncVector
     bool south_;
 
     bool updated_boundaries_;
+
+    // true between initiateTradeBoundaries() and finishTradeBoundaries()
+    bool trade_in_progress_;
+
     int bc_[3];
     short nghosts_;
 
@@ -103,6 +112,31 @@ class GridFuncVector
     MPI_Request req_north_south_[4];
     MPI_Request req_up_down_[4];
 
+    // persistent requests for exchanges using comm_buf*_, for each
+    // number of colors exchanged
+    PersistentRequests persistent_requests_{ comm_setup_tm_ };
+
+    // post non-blocking send/receive with neighbor in direction dir,
+    // using persistent requests if GridFuncInterface::persistentComm()
+    void isend(ScalarType* buf, const int sizeb, const short dir,
+        MPI_Request* req)
+    {
+        if (GridFuncInterface::persistentComm())
+            persistent_requests_.startSend(
+                grid_.mype_env(), buf, sizeb, dir, req);
+        else
+            grid_.mype_env().Isend(buf, sizeb, dir, req);
+    }
+    void irecv(ScalarType* buf, const int sizeb, const short dir,
+        MPI_Request* req)
+    {
+        if (GridFuncInterface::persistentComm())
+            persistent_requests_.startRecv(
+                grid_.mype_env(), buf, sizeb, dir, req);
+        else
+            grid_.mype_env().Irecv(buf, sizeb, dir, req);
+    }
+
     void wait_north_south();
     void wait_east_west();
     void wait_up_down();
@@ -173,6 +207,9 @@ class GridFuncVector
 
     void allocate(const int n);
 
+    void applyLapOverlapComm(
+        const int type, GridFuncVector<ScalarType, MemorySpaceType>& rhs);
+
 public:
     GridFuncVector(const Grid& my_grid, const int px, const int py,
         const int pz, const std::vector<std::vector<int>>& gid,
@@ -195,6 +232,7 @@ public:
         bc_[2] = pz;
 
         updated_boundaries_ = false; // boundaries not initialized
+        trade_in_progress_  = false;
 
         allocate(gid[0].size());
 
@@ -215,6 +253,9 @@ public:
 
     static void setMasks(Map2Masks* map2masks) { map2masks_ = map2masks; }
 
+    static void setOverlapComm(const bool flag) { overlap_comm_ = flag; }
+    static bool overlapComm() { return overlap_comm_; }
+
     const Grid& grid() const { return grid_; }
 
     ScalarType* data() { return memory_.get(); }
@@ -445,6 +486,11 @@ public:
     void trade_boundaries();
     void trade_boundaries_colors(const short, const short);
 
+    // split trade_boundaries() in two parts, so that computations
+    // not needing ghost values can be done in between
+    void initiateTradeBoundaries();
+    void finishTradeBoundaries();
+
     size_t size() const { return nfunc_; }
 
     // pointwise products this=A*B for each vector in this
@@ -460,6 +506,7 @@ public:
         updated_boundaries_ = true;
     }
     void set_updated_boundaries(const bool flag) { updated_boundaries_ = flag; }
+    bool updated_boundaries() const { return updated_boundaries_; }
     GridFuncVector<ScalarType, MemorySpaceType>& operator-=(
         const GridFuncVector<ScalarType, MemorySpaceType>& func);
     void axpy(const double alpha,
@@ -489,6 +536,7 @@ public:
         finishExchangeNorthSouth_tm_.print(os);
         finishExchangeUpDown_tm_.print(os);
         finishExchangeEastWest_tm_.print(os);
+        comm_setup_tm_.print(os);
     }
 };
 
@@ -519,9 +567,14 @@ Timer GridFuncVector<ScalarType, MemorySpaceType>::wait_up_down_tm_(
 template <typename ScalarType, typename MemorySpaceType>
 Timer GridFuncVector<ScalarType, MemorySpaceType>::wait_east_west_tm_(
     "GridFuncVector::waitEW");
+template <typename ScalarType, typename MemorySpaceType>
+Timer GridFuncVector<ScalarType, MemorySpaceType>::comm_setup_tm_(
+    "GridFuncVector::comm_setup");
 
 template <typename ScalarType, typename MemorySpaceType>
 Map2Masks* GridFuncVector<ScalarType, MemorySpaceType>::map2masks_(nullptr);
+template <typename ScalarType, typename MemorySpaceType>
+bool GridFuncVector<ScalarType, MemorySpaceType>::overlap_comm_(false);
 } // namespace pb
 
 #endif
@@ -32,7 +32,17 @@ public:
 
     // A->B
     void apply(GridFunc<T>& A, GridFunc<T>& B) override = 0;
-    virtual void applyWithPot(GridFunc<T>&, const double* const, T*)
+    // B = -Lap*A + pot*A, on one region of the subdomain
+    virtual void applyWithPot(GridFunc<T>&, const double* const, T*,
+        const StencilRegion = StencilRegion::All)
+    {
+        std::cerr << "ERROR: Lap::applyWithPot() not implemented" << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 0);
+    }
+    // B = -Lap*A + RHS*(pot*A), with pot given with ghost values,
+    // as needed by compact (Mehrstellen) discretizations
+    virtual void applyWithPot(GridFunc<T>&, const GridFunc<double>&, T*,
+        const StencilRegion = StencilRegion::All)
     {
         std::cerr << "ERROR: Lap::applyWithPot() not implemented" << std::endl;
         MPI_Abort(MPI_COMM_WORLD, 0);
@@ -92,9 +92,11 @@ public:
         B.set_updated_boundaries(0);
         B.set_bc(A.bc(0), A.bc(1), A.bc(2));
     }
-    void applyWithPot(GridFunc<T>& A, const double* pot, T* B) override
+    using Lap<T>::applyWithPot;
+    void applyWithPot(GridFunc<T>& A, const double* pot, T* B,
+        const StencilRegion region = StencilRegion::All) override
     {
-        this->del2_4th_withPot(A, pot, B);
+        this->del2_4th_withPot(A, pot, B, region);
     }
     void apply(Grid& Agrid, T* A, T* B, const size_t nfunc)
     {
@@ -64,6 +64,13 @@ public:
         FDoper<T>::del2_4th_Mehr(A, B);
         B.set_bc(A.bc(0), A.bc(1), A.bc(2));
     }
+    using Lap<T>::applyWithPot;
+    // B = -Lap_Mehr*A + RHS_Mehr1*(pot*A)
+    void applyWithPot(GridFunc<T>& A, const GridFunc<double>& pot, T* B,
+        const StencilRegion region = StencilRegion::All) override
+    {
+        this->del2_4th_Mehr_withPot(A, pot, B, region);
+    }
 
     void rhs(GridFunc<T>& A, GridFunc<T>& B) const override
     {
@@ -95,6 +95,12 @@ public:
         FDoper<T>::del2_6th(A, B);
         B.set_bc(A.bc(0), A.bc(1), A.bc(2));
     }
+    using Lap<T>::applyWithPot;
+    void applyWithPot(GridFunc<T>& A, const double* pot, T* B,
+        const StencilRegion region = StencilRegion::All) override
+    {
+        this->del2_6th_withPot(A, pot, B, region);
+    }
 
     void jacobi(GridFunc<T>&, const GridFunc<T>&, GridFunc<T>&) override;
 
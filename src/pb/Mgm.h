@@ -111,6 +111,86 @@ bool Mgm(T1& A, T2& vh, const GridFunc<T3>& rho, const short cogr,
     return converged;
 }
 
+// Mixed precision version of Mgm (iterative refinement):
+// residuals are evaluated and corrections accumulated in the precision T3
+// of vh with operator A, while V-cycles computing corrections use
+// operator AL in (lower) precision T4
+template <typename T4, class T1, class T1L, typename T3>
+bool MgmMixedPrecision(T1& A, T1L& AL, GridFunc<T3>& vh,
+    const GridFunc<T3>& rho, const short cogr, const short max_sweeps,
+    const double tol, const short nu1, const short nu2,
+    const bool gather_coarse_level, double& final_residual,
+    double& final_relative_residual, double& residual_reduction,
+    short& nb_sweeps)
+{
+    A.inv_transform(vh);
+
+    const short bcx = vh.bc(0);
+    const short bcy = vh.bc(1);
+    const short bcz = vh.bc(2);
+
+    const Grid& finegrid = vh.grid();
+
+    // Compute r.h.s. from rho
+    GridFunc<T3> res(rho);
+    A.transform(res);
+    GridFunc<T3> rhs(finegrid, bcx, bcy, bcz);
+    A.rhs(res, rhs);
+
+    GridFunc<T3> lhs(finegrid, bcx, bcy, bcz);
+
+    short bcwork[3] = { bcx, bcy, bcz };
+    for (short d = 0; d < 3; d++)
+        if (bcwork[d] == 2) bcwork[d] = 0;
+
+    // residual and correction in precision T4
+    GridFunc<T4> res_low(finegrid, bcx, bcy, bcz);
+    GridFunc<T4> work_low(finegrid, bcwork[0], bcwork[1], bcwork[2]);
+
+    const double inv_rhs_norm = 1. / norm(rhs);
+    double init_residual_norm = 1.;
+    bool converged            = false;
+    nb_sweeps                 = 0;
+    for (short i = 0; i < max_sweeps; i++)
+    {
+        A.apply(vh, lhs);
+        res.diff(rhs, lhs);
+
+        const double res_norm = norm(res);
+        if (i == 0) init_residual_norm = res_norm;
+
+        // check relative residual norm for convergence
+        if (res_norm * inv_rhs_norm < tol)
+        {
+            final_residual          = res_norm;
+            final_relative_residual = res_norm * inv_rhs_norm;
+            converged               = true;
+            break;
+        }
+
+        res_low.setValues(res);
+        work_low = 0.;
+        Vcycle(AL, work_low, res_low, cogr, nu1, nu2, gather_coarse_level);
+        nb_sweeps++;
+
+        vh.axpy(1., work_low);
+    }
+
+    if (!converged)
+    {
+        A.apply(vh, lhs);
+        lhs -= rhs;
+        final_residual          = norm(lhs);
+        final_relative_residual = final_residual * inv_rhs_norm;
+    }
+
+    A.transform(vh);
+
+    residual_reduction = final_residual / init_residual_norm;
+
+    return converged;
+}
+
 } // namespace pb
 
 #endif
@@ -84,6 +84,36 @@ PEenv::PEenv(MPI_Comm comm, const int nx, const int ny, const int nz,
 
     split_comm(nx, ny, nz, bias);
 
+    setupCartComm();
+}
+
+// Must be called from all the PEs of comm simultaneously!
+PEenv::PEenv(MPI_Comm comm, const int ntasks_dir[3], std::ostream* os)
+    : comm_(comm), os_(os)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        n_mpi_tasks_dir_[i] = ntasks_dir[i];
+        mytask_dir_[i]      = 0;
+    }
+    for (int i = 0; i < 6; i++)
+        mpi_neighbors_[i] = 0;
+
+    color_       = 0;
+    comm_active_ = comm_;
+
+    MPI_Comm_size(comm_, &n_mpi_tasks_);
+    MPI_Comm_rank(comm_, &mytask_);
+    assert(n_mpi_tasks_
+           == n_mpi_tasks_dir_[0] * n_mpi_tasks_dir_[1] * n_mpi_tasks_dir_[2]);
+
+    onpe0_ = (mytask_ == 0);
+
+    setupCartComm();
+}
+
+void PEenv::setupCartComm()
+{
     int periods[3] = { 1, 1, 1 };
     int reorder    = 0;
     MPI_Cart_create(
@@ -138,6 +168,90 @@ PEenv::PEenv(MPI_Comm comm, const int nx, const int ny, const int nz,
     set_other_tasks_dir();
 }
 
+bool PEenv::agglomerate() const
+{
+    // already set up?
+    if (agglomeration_factor_[0] > 0)
+        return (agglomeration_comm_ != MPI_COMM_NULL);
+
+    int ntasks_dir[3];
+    bool reduced = false;
+    for (int i = 0; i < 3; i++)
+    {
+        agglomeration_factor_[i] = (n_mpi_tasks_dir_[i] % 2 == 0) ? 2 : 1;
+        ntasks_dir[i] = n_mpi_tasks_dir_[i] / agglomeration_factor_[i];
+        if (agglomeration_factor_[i] > 1) reduced = true;
+    }
+    if (!reduced) return false;
+
+    const int* f = agglomeration_factor_;
+
+    // tasks merged together, ordered by position in group
+    const int leader = xyz2task(mytask_dir_[0] - mytask_dir_[0] % f[0],
+        mytask_dir_[1] - mytask_dir_[1] % f[1],
+        mytask_dir_[2] - mytask_dir_[2] % f[2]);
+    const int member = ((mytask_dir_[0] % f[0]) * f[1] + mytask_dir_[1] % f[1])
+                           * f[2]
+                       + mytask_dir_[2] % f[2];
+    MPI_Comm_split(comm_active_, leader, member, &agglomeration_comm_);
+
+    // group leaders, ordered as in a cartesian communicator
+    const int key
+        = ((mytask_dir_[0] / f[0]) * ntasks_dir[1] + mytask_dir_[1] / f[1])
+              * ntasks_dir[2]
+          + mytask_dir_[2] / f[2];
+    MPI_Comm_split(comm_active_, member == 0 ? 0 : MPI_UNDEFINED, key,
+        &agglomerated_comm_);
+
+    if (member == 0)
+        agglomerated_.reset(new PEenv(agglomerated_comm_, ntasks_dir, os_));
+
+    return true;
+}
+
+void PEenv::gatherAgglomeration(
+    const double* sendbuf, const int n, double* recvbuf) const
+{
+    assert(agglomeration_comm_ != MPI_COMM_NULL);
+    MPI_Gather(
+        sendbuf, n, MPI_DOUBLE, recvbuf, n, MPI_DOUBLE, 0, agglomeration_comm_);
+}
+
+void PEenv::gatherAgglomeration(
+    const float* sendbuf, const int n, float* recvbuf) const
+{
+    assert(agglomeration_comm_ != MPI_COMM_NULL);
+    MPI_Gather(
+        sendbuf, n, MPI_FLOAT, recvbuf, n, MPI_FLOAT, 0, agglomeration_comm_);
+}
+
+void PEenv::scatterAgglomeration(
+    const double* sendbuf, const int n, double* recvbuf) const
+{
+    assert(agglomeration_comm_ != MPI_COMM_NULL);
+    MPI_Scatter(
+        sendbuf, n, MPI_DOUBLE, recvbuf, n, MPI_DOUBLE, 0, agglomeration_comm_);
+}
+
+void PEenv::scatterAgglomeration(
+    const float* sendbuf, const int n, float* recvbuf) const
+{
+    assert(agglomeration_comm_ != MPI_COMM_NULL);
+    MPI_Scatter(
+        sendbuf, n, MPI_FLOAT, recvbuf, n, MPI_FLOAT, 0, agglomeration_comm_);
+}
+
+void PEenv::allGather(double* sendbuf, const int n, double* recvbuf) const
+{
+    MPI_Allgather(
+        sendbuf, n, MPI_DOUBLE, recvbuf, n, MPI_DOUBLE, comm_active_);
+}
+
+void PEenv::allGather(float* sendbuf, const int n, float* recvbuf) const
+{
+    MPI_Allgather(sendbuf, n, MPI_FLOAT, recvbuf, n, MPI_FLOAT, comm_active_);
+}
+
 void PEenv::set_other_tasks_dir()
 {
     for (int i = 0; i < 3; i++)
@@ -188,6 +302,12 @@ PEenv::PEenv(MPI_Comm comm,
 
 PEenv::~PEenv()
 {
+    agglomerated_.reset();
+    if (agglomerated_comm_ != MPI_COMM_NULL)
+        MPI_Comm_free(&agglomerated_comm_);
+    if (agglomeration_comm_ != MPI_COMM_NULL)
+        MPI_Comm_free(&agglomeration_comm_);
+
     if (comm_active_ != comm_ && comm_active_ != MPI_COMM_SELF)
     {
         // cout<<"MPI_Comm_free: "<<comm_active_<<endl;
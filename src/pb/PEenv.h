@@ -10,8 +10,11 @@
 #ifndef PB_PEENV_H
 #define PB_PEENV_H
 
+#include "Profiler.h"
+
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <unistd.h>
 
 #include <mpi.h>
@@ -57,6 +60,21 @@ private:
     bool onpe0_;
     std::ostream* os_;
 
+    // coarser environment made of one task out of each group
+    // of up to 2x2x2 neighboring tasks (see agglomerate())
+    mutable std::unique_ptr<PEenv> agglomerated_;
+    mutable MPI_Comm agglomerated_comm_ = MPI_COMM_NULL;
+
+    // communicator of the tasks merged together with mine
+    mutable MPI_Comm agglomeration_comm_ = MPI_COMM_NULL;
+
+    // number of tasks merged together in each direction (0 if not set)
+    mutable int agglomeration_factor_[3] = { 0, 0, 0 };
+
+    // build environment for a given distribution of tasks of comm
+    PEenv(MPI_Comm comm, const int ntasks_dir[3], std::ostream* os);
+
+    void setupCartComm();
     void setup_my_neighbors();
     int geom(const int, const int, const int, const int);
     void set_other_tasks_dir();
@@ -92,6 +110,38 @@ public:
 
     ~PEenv();
 
+    // Set up (at first call) a coarser environment where the subdomains
+    // of groups of up to 2x2x2 neighboring tasks are merged onto one task.
+    // Must be called from all the PEs simultaneously!
+    // Returns false if the number of tasks cannot be reduced
+    bool agglomerate() const;
+
+    // coarser environment, nullptr on tasks not part of it
+    const PEenv* agglomerated() const { return agglomerated_.get(); }
+
+    // communicator of the tasks merged together with mine,
+    // with the task part of agglomerated() having rank 0
+    MPI_Comm agglomeration_comm() const { return agglomeration_comm_; }
+
+    int agglomeration_factor(const int dir) const
+    {
+        assert(agglomeration_factor_[dir] > 0);
+        return agglomeration_factor_[dir];
+    }
+
+    // gather n values from each task merged together with mine
+    // into recvbuf on the task part of agglomerated()
+    void gatherAgglomeration(const double* sendbuf, const int n,
+        double* recvbuf) const;
+    void gatherAgglomeration(const float* sendbuf, const int n,
+        float* recvbuf) const;
+
+    // reverse of gatherAgglomeration()
+    void scatterAgglomeration(const double* sendbuf, const int n,
+        double* recvbuf) const;
+    void scatterAgglomeration(const float* sendbuf, const int n,
+        float* recvbuf) const;
+
     void task2xyz();
 
     void barrier(void) const;
@@ -99,6 +149,9 @@ public:
     void bcast(int*, const int n) const;
     void bcast(double*, const int n) const;
 
+    void allGather(double* sendbuf, const int n, double* recvbuf) const;
+    void allGather(float* sendbuf, const int n, float* recvbuf) const;
+
     double double_sum_all(double) const;
     double double_max_all(double) const;
     double double_min_all(double) const;
@@ -126,16 +179,19 @@ public:
 
     void Isend(double* buf, int sizeb, const short dst, MPI_Request* req) const
     {
+        Profiler::addHaloBytes(sizeb * sizeof(double));
         MPI_Isend(
             buf, sizeb, MPI_DOUBLE, mpi_neighbors(dst), 0, cart_comm_, req);
     }
     void Isend(float* buf, int sizeb, const short dst, MPI_Request* req) const
     {
+        Profiler::addHaloBytes(sizeb * sizeof(float));
         MPI_Isend(
             buf, sizeb, MPI_FLOAT, mpi_neighbors(dst), 0, cart_comm_, req);
     }
     void Isend(int* buf, int sizeb, const short dst, MPI_Request* req) const
     {
+        Profiler::addHaloBytes(sizeb * sizeof(int));
         MPI_Isend(buf, sizeb, MPI_INT, mpi_neighbors(dst), 0, cart_comm_, req);
     }
 
@@ -154,6 +210,33 @@ public:
         MPI_Irecv(buf, sizeb, MPI_INT, mpi_neighbors(src), 0, cart_comm_, req);
     }
 
+    // persistent versions of Isend/Irecv, to be started with MPI_Start
+    void Send_init(double* buf, int sizeb, const short dst,
+        MPI_Request* req) const
+    {
+        MPI_Send_init(
+            buf, sizeb, MPI_DOUBLE, mpi_neighbors(dst), 0, cart_comm_, req);
+    }
+    void Send_init(float* buf, int sizeb, const short dst,
+        MPI_Request* req) const
+    {
+        MPI_Send_init(
+            buf, sizeb, MPI_FLOAT, mpi_neighbors(dst), 0, cart_comm_, req);
+    }
+
+    void Recv_init(double* buf, int sizeb, const short src,
+        MPI_Request* req) const
+    {
+        MPI_Recv_init(
+            buf, sizeb, MPI_DOUBLE, mpi_neighbors(src), 0, cart_comm_, req);
+    }
+    void Recv_init(float* buf, int sizeb, const short src,
+        MPI_Request* req) const
+    {
+        MPI_Recv_init(
+            buf, sizeb, MPI_FLOAT, mpi_neighbors(src), 0, cart_comm_, req);
+    }
+
     // functions to reduce an int in one direction
     void maxXdir(int* values, const int count) const
     {
@@ -0,0 +1,117 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef PB_PERSISTENTREQUESTS_H
+#define PB_PERSISTENTREQUESTS_H
+
+#include "PEenv.h"
+#include "Timer.h"
+
+#include <map>
+#include <tuple>
+
+#include <mpi.h>
+
+namespace pb
+{
+
+// Cache of persistent MPI requests (MPI_Send_init/MPI_Recv_init) for
+// ghost values exchanges repeated many times with the same buffers,
+// sizes and neighbors.
+// A request is set up the first time a (buffer, size, neighbor)
+// combination is used, and simply restarted with MPI_Start afterwards.
+// Completion is checked by the caller with MPI_Wait, as for
+// MPI_Isend/MPI_Irecv requests.
+class PersistentRequests
+{
+    // communicator, neighbor rank, buffer, size, size of data type, send
+    // Note: a request holds a reference to its communicator, so a
+    // communicator handle cannot be recycled while it is in the cache
+    using Key = std::tuple<MPI_Comm, int, const void*, int, int, bool>;
+
+    std::map<Key, MPI_Request> requests_;
+
+    // time spent creating requests
+    Timer& setup_tm_;
+
+    template <typename T>
+    MPI_Request* getRequest(const PEenv& mype_env, T* buf, const int sizeb,
+        const short dir, const bool send)
+    {
+        const Key key(mype_env.cart_comm(), mype_env.mpi_neighbors(dir), buf,
+            sizeb, static_cast<int>(sizeof(T)), send);
+
+        auto it = requests_.find(key);
+        if (it != requests_.end()) return &it->second;
+
+        setup_tm_.start();
+
+        MPI_Request req;
+        if (send)
+            mype_env.Send_init(buf, sizeb, dir, &req);
+        else
+            mype_env.Recv_init(buf, sizeb, dir, &req);
+        it = requests_.insert(std::make_pair(key, req)).first;
+
+        setup_tm_.stop();
+
+        return &it->second;
+    }
+
+public:
+    PersistentRequests(Timer& setup_tm) : setup_tm_(setup_tm) {}
+
+    PersistentRequests(const PersistentRequests&) = delete;
+    PersistentRequests& operator=(const PersistentRequests&) = delete;
+
+    ~PersistentRequests() { clear(); }
+
+    // start sending sizeb values from buf to neighbor in direction dst.
+    // req is set to a handle to use with MPI_Wait
+    template <typename T>
+    void startSend(const PEenv& mype_env, T* buf, const int sizeb,
+        const short dst, MPI_Request* req)
+    {
+        MPI_Request* preq = getRequest(mype_env, buf, sizeb, dst, true);
+        Profiler::addHaloBytes(sizeb * sizeof(T));
+        MPI_Start(preq);
+        *req = *preq;
+    }
+
+    // start receiving up to sizeb values into buf from neighbor
+    // in direction src.
+    // req is set to a handle to use with MPI_Wait
+    template <typename T>
+    void startRecv(const PEenv& mype_env, T* buf, const int sizeb,
+        const short src, MPI_Request* req)
+    {
+        MPI_Request* preq = getRequest(mype_env, buf, sizeb, src, false);
+        MPI_Start(preq);
+        *req = *preq;
+    }
+
+    // free all the requests. Needs to be called when buffers are
+    // reallocated
+    void clear()
+    {
+        // static objects may be destroyed after MPI_Finalize
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+        if (!finalized)
+            for (auto& r : requests_)
+                MPI_Request_free(&r.second);
+        requests_.clear();
+    }
+
+    size_t size() const { return requests_.size(); }
+};
+
+} // namespace pb
+
+#endif
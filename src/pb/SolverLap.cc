@@ -8,6 +8,7 @@
 // Please also read this link https://github.com/llnl/mgmol/LICENSE
 
 #include "SolverLap.h"
+#include "SolverLapMixedPrecision.h"
 #include "Laph2.h"
 #include "Laph4.h"
 #include "Laph4M.h"
@@ -17,11 +18,6 @@
 #include "Mgm.h"
 #include "ShiftedLaph4M.h"
 
-Timer vcycle_repwrk_tm("vcycle_repwrk");
-Timer vcycle_repinit_tm("vcycle_repinit");
-Timer vcycle_repend_tm("vcycle_repend");
-Timer vcycle_repvcycle_tm("vcycle_repvcycle");
-
 namespace pb
 {
 // explicit instantiation declaration
@@ -42,6 +38,13 @@ template class SolverLap<Laph4<float>, float>;
 template class SolverLap<Laph2<float>, float>;
 template class SolverLap<Laph6<float>, float>;
 template class SolverLap<Laph8<float>, float>;
+// mixed
+template class SolverLapMixedPrecision<Laph4MP<double>, Laph4MP<float>, double>;
+template class SolverLapMixedPrecision<Laph4M<double>, Laph4M<float>, double>;
+template class SolverLapMixedPrecision<Laph4<double>, Laph4<float>, double>;
+template class SolverLapMixedPrecision<Laph2<double>, Laph2<float>, double>;
+template class SolverLapMixedPrecision<Laph6<double>, Laph6<float>, double>;
+template class SolverLapMixedPrecision<Laph8<double>, Laph8<float>, double>;
 
 template <class T, typename T2>
 bool SolverLap<T, T2>::solve(T2* phi, T2* rhs, const char dis)
@@ -77,4 +80,18 @@ bool SolverLap<T, T2>::solve(GridFunc<T2>& gf_phi, const GridFunc<T2>& gf_rhs)
     return conv;
 }
 
+template <class T, class TL, typename T2>
+bool SolverLapMixedPrecision<T, TL, T2>::solve(
+    GridFunc<T2>& gf_phi, const GridFunc<T2>& gf_rhs)
+{
+    bool conv = MgmMixedPrecision<float>(oper_, oper_low_, gf_phi, gf_rhs,
+        max_nlevels_, max_sweeps_, tol_, nu1_, nu2_, gather_coarse_level_,
+        final_residual_, final_relative_residual_, residual_reduction_,
+        nb_sweeps_);
+
+    if (Solver<T2>::fully_periodic_) gf_phi.average0();
+
+    return conv;
+}
+
 } // namespace pb
@@ -0,0 +1,38 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "Vcycle.h"
+
+Timer vcycle_repwrk_tm("vcycle_repwrk");
+Timer vcycle_repinit_tm("vcycle_repinit");
+Timer vcycle_repend_tm("vcycle_repend");
+Timer vcycle_repvcycle_tm("vcycle_repvcycle");
+
+namespace pb
+{
+int VcycleControl::agglomeration_min_points_ = 0;
+
+Timer VcycleControl::agglomerate_tm_("Vcycle::agglomerate");
+
+std::vector<Timer> VcycleControl::level_tm_
+    = { Timer("Vcycle::level_0"), Timer("Vcycle::level_1"),
+          Timer("Vcycle::level_2"), Timer("Vcycle::level_3"),
+          Timer("Vcycle::level_4"), Timer("Vcycle::level_5+") };
+
+void VcycleControl::printTimers(std::ostream& os)
+{
+    for (auto& tm : level_tm_)
+        tm.print(os);
+    agglomerate_tm_.print(os);
+    vcycle_repwrk_tm.print(os);
+    vcycle_repinit_tm.print(os);
+    vcycle_repvcycle_tm.print(os);
+    vcycle_repend_tm.print(os);
+}
+} // namespace pb
@@ -14,7 +14,9 @@
 #define USE_LOWER_ORDER 1 // decrease operator order when coarsening
 
 #include "GridFunc.h"
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 extern Timer vcycle_repwrk_tm;
 extern Timer vcycle_repinit_tm;
@@ -24,6 +26,39 @@ extern Timer vcycle_repvcycle_tm;
 namespace pb
 {
 
+// settings and timers common to all V-cycles
+class VcycleControl
+{
+    // number of grid points per task below which subdomains of
+    // neighboring tasks are merged onto fewer tasks (0: never)
+    static int agglomeration_min_points_;
+
+    static Timer agglomerate_tm_;
+
+    // time spent at each level, including coarser levels
+    static std::vector<Timer> level_tm_;
+
+public:
+    static void setAgglomerationMinPoints(const int n)
+    {
+        agglomeration_min_points_ = n;
+    }
+    static int agglomerationMinPoints() { return agglomeration_min_points_; }
+
+    static Timer& agglomerate_tm() { return agglomerate_tm_; }
+
+    // levels coarser than the last timer share it; only the finest of
+    // those levels starts and stops it
+    static Timer& level_tm(const short level)
+    {
+        const size_t index
+            = std::min(static_cast<size_t>(-level), level_tm_.size() - 1);
+        return level_tm_[index];
+    }
+
+    static void printTimers(std::ostream& os);
+};
+
 // assumes x=0 in input
 template <class T1, class T2, typename T3>
 int Vcycle(T1& A, T2& x, const GridFunc<T3>& rhs, const short cogr,
@@ -66,6 +101,50 @@ int Vcycle(T1& A, T2& x, const GridFunc<T3>& rhs, const short cogr,
     const bool flag_gather = ((!flag_coarsen || (level_grid.level() <= (-cogr)))
                               && gather_coarse_level);
 
+    // merge subdomains of neighboring tasks when they get too small,
+    // and continue on the tasks left
+    if (!flag_gather && level_grid.mype_env().n_mpi_tasks() > 1
+        && static_cast<int>(level_grid.size())
+               < VcycleControl::agglomerationMinPoints()
+        && level_grid.mype_env().agglomerate())
+    {
+        VcycleControl::agglomerate_tm().start();
+
+        const PEenv* agglomerated_peenv = level_grid.mype_env().agglomerated();
+
+        int ret = 0;
+        if (agglomerated_peenv != nullptr)
+        {
+            const Grid agglomerated_grid(
+                level_grid.replicated_grid(*agglomerated_peenv));
+
+            GridFunc<T3> agglomerated_rhs(
+                agglomerated_grid, x.bc(0), x.bc(1), x.bc(2));
+            rhs.gatherAgglomerated(&agglomerated_rhs);
+
+            GridFunc<T3> agglomerated_x(
+                agglomerated_grid, x.bc(0), x.bc(1), x.bc(2));
+
+            T1 agglomerated_A = A.replicatedOp(agglomerated_grid);
+
+            VcycleControl::agglomerate_tm().stop();
+            ret = Vcycle(agglomerated_A, agglomerated_x, agglomerated_rhs,
+                cogr, nu1, nu2, gather_coarse_level);
+            VcycleControl::agglomerate_tm().start();
+
+            x.scatterAgglomerated(&agglomerated_x);
+        }
+        else
+        {
+            rhs.gatherAgglomerated(nullptr);
+            x.scatterAgglomerated(nullptr);
+        }
+
+        VcycleControl::agglomerate_tm().stop();
+
+        return ret;
+    }
+
     // try gather data on single processor to reach coarser levels
     if (flag_gather && level_grid.mype_env().n_mpi_tasks() > 1)
     {
@@ -143,6 +222,11 @@ int Vcycle(T1& A, T2& x, const GridFunc<T3>& rhs, const short cogr,
         return ret;
     }
 
+    // levels sharing the last timer are timed by the finest one only
+    Timer& level_tm       = VcycleControl::level_tm(level_grid.level());
+    const bool time_level = !level_tm.running();
+    if (time_level) level_tm.start();
+
     GridFunc<T3> res(x.grid(), x.bc(0), x.bc(1), x.bc(2));
 
     // pre-smoothing
@@ -245,6 +329,8 @@ int Vcycle(T1& A, T2& x, const GridFunc<T3>& rhs, const short cogr,
         std::cout << "end of Vcycle: norm(res)=" << norm_tmp << std::endl;
 #endif
 
+    if (time_level) level_tm.stop();
+
     return 0;
 }
 
@@ -546,6 +546,7 @@ int MGmol<OrbitalsType>::quench(OrbitalsType& orbitals, Ions& ions,
     const std::vector<std::vector<int>>& gids(orbitals.getOverlappingGids());
 
     g_kbpsi_->setup(*ions_);
+    applyH_kbpsi_->setup(*ions_);
     electrostat_->setup(ct.vh_its);
     rho_->setup(ct.getOrthoType(), gids);
 
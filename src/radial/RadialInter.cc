@@ -9,6 +9,8 @@
 
 #include "RadialInter.h"
 
+#include <algorithm>
+
 // Gregory-Newton cubic interpolation using forward differences
 double RadialInter::cubint(const double r, const int j) const
 {
@@ -45,6 +47,128 @@ double RadialInter::cubint(const double r, const int j) const
     return f0 + d0 * (g1 + d1 * (h2 + d2 * i2));
 }
 
+void RadialInter::cubint(const int n, const double* const x,
+    double* const val, const int j) const
+{
+    assert(j < (int)y_.size());
+    assert(invdr_ > 0.);
+
+    const double* __restrict__ yj = y_[j].data();
+    const int ny                  = (int)y_[j].size();
+    assert(ny > 3);
+
+    // last interval where cubic interpolation is defined
+    const int icmax = ny - 3;
+
+    const double* __restrict__ px = x;
+    double* __restrict__ pval     = val;
+    for (int i = 0; i < n; i++)
+    {
+        // clamp before conversion to int to avoid overflow
+        const double d = std::min(px[i] * invdr_, (double)ny);
+
+        const int i0 = (int)d;
+        int ic       = (i0 > 0) ? i0 : 1;
+        ic           = (ic < icmax) ? ic : icmax;
+
+        const double d0 = d - (double)(ic);
+        const double d1 = (d0 - 1.) * 0.5;
+        const double d2 = (d0 - 2.) / 3.;
+
+        const double f0 = yj[ic];
+        const double g0 = yj[ic] - yj[ic - 1];
+        const double g1 = yj[ic + 1] - yj[ic];
+        const double g2 = yj[ic + 2] - yj[ic + 1];
+        const double h1 = g1 - g0;
+        const double h2 = g2 - g1;
+        const double i2 = h2 - h1;
+
+        const double vcub = f0 + d0 * (g1 + d1 * (h2 + d2 * i2));
+        const double vlin = (1. - d) * yj[0] + d * yj[1];
+
+        const double v = (i0 + 2 >= ny) ? 0. : vcub;
+        pval[i]        = (d < 1.) ? vlin : v;
+    }
+}
+
+void RadialInter::cubint(const int n, const double* const x,
+    double* const val, double* const dval, const int j) const
+{
+    assert(j < (int)y_.size());
+    assert(invdr_ > 0.);
+
+    const double* __restrict__ yj = y_[j].data();
+    const int ny                  = (int)y_[j].size();
+    assert(ny > 3);
+
+    const int icmax = ny - 3;
+
+    const double* __restrict__ px = x;
+    double* __restrict__ pval     = val;
+    double* __restrict__ pdval    = dval;
+    for (int i = 0; i < n; i++)
+    {
+        const double d = std::min(px[i] * invdr_, (double)ny);
+
+        const int i0 = (int)d;
+        int ic       = (i0 > 0) ? i0 : 1;
+        ic           = (ic < icmax) ? ic : icmax;
+
+        const double d0 = d - (double)(ic);
+        const double d1 = (d0 - 1.) * 0.5;
+        const double d2 = (d0 - 2.) / 3.;
+
+        const double f0 = yj[ic];
+        const double g0 = yj[ic] - yj[ic - 1];
+        const double g1 = yj[ic + 1] - yj[ic];
+        const double g2 = yj[ic + 2] - yj[ic + 1];
+        const double h1 = g1 - g0;
+        const double h2 = g2 - g1;
+        const double i2 = h2 - h1;
+
+        // value and derivative with respect to d0 of
+        // f0 + d0 * a, a = g1 + d1 * b, b = h2 + d2 * i2
+        const double b  = h2 + d2 * i2;
+        const double a  = g1 + d1 * b;
+        const double da = 0.5 * b + d1 * i2 / 3.;
+
+        const double vcub  = f0 + d0 * a;
+        const double dvcub = (a + d0 * da) * invdr_;
+        const double vlin  = (1. - d) * yj[0] + d * yj[1];
+        const double dvlin = (yj[1] - yj[0]) * invdr_;
+
+        const bool out = (i0 + 2 >= ny);
+        pval[i]        = (d < 1.) ? vlin : (out ? 0. : vcub);
+        pdval[i]       = (d < 1.) ? dvlin : (out ? 0. : dvcub);
+    }
+}
+
+void RadialInter::linint(const int n, const double* const x,
+    double* const val, const int j) const
+{
+    assert(j < (int)y_.size());
+    assert(invdr_ > 0.);
+
+    const double* __restrict__ yj = y_[j].data();
+    const int ny                  = (int)y_[j].size();
+    assert(ny > 1);
+
+    const double* __restrict__ px = x;
+    double* __restrict__ pval     = val;
+    for (int i = 0; i < n; i++)
+    {
+        const double d = std::min(px[i] * invdr_, (double)ny);
+
+        const int i0 = (int)d;
+        const int ic = (i0 < ny - 1) ? i0 : ny - 2;
+
+        const double b = d - (double)(ic);
+        const double a = 1. - b;
+
+        pval[i] = (i0 >= ny) ? 0. : a * yj[ic] + b * yj[ic + 1];
+    }
+}
+
 // linear interpolation
 double RadialInter::linint(const double r, const int j) const
 {
@@ -29,6 +29,17 @@ public:
 
     double linint(const double x, const int j = 0) const;
     double cubint(const double x, const int j = 0) const;
+
+    // batched versions for n values of x.
+    // Same results as scalar versions, but without branches in loop
+    // over x, so that it can be vectorized.
+    void linint(const int n, const double* const x, double* const val,
+        const int j = 0) const;
+    void cubint(const int n, const double* const x, double* const val,
+        const int j = 0) const;
+    // cubic interpolation of values and derivatives
+    void cubint(const int n, const double* const x, double* const val,
+        double* const dval, const int j = 0) const;
 };
 
 #endif
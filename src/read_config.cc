@@ -77,7 +77,9 @@ int read_config(int argc, char** argv, po::variables_map& vm,
             po::value<short>()->default_value(0),
             "Read restart level")("Restart.input_type",
             po::value<std::string>()->default_value("distributed"),
-            "Read restart type: distributed or single_file")(
+            "Read restart type: distributed, single_file, or "
+            "single_file_direct (each task reads its own block, any "
+            "processor grid)")(
             "Restart.output_filename",
             po::value<std::string>()->default_value("auto"),
             "Dump restart filename/directory")("Restart.output_level",
@@ -86,7 +88,18 @@ int read_config(int argc, char** argv, po::variables_map& vm,
             po::value<std::string>()->default_value("distributed"),
             "Write restart type: distributed or single_file")(
             "Restart.interval", po::value<short>()->default_value(1000),
-            "Restart frequency")("Restart.rescale_v",
+            "Restart frequency")("Restart.async",
+            po::value<bool>()->default_value(false),
+            "Write MD restart files in background while MD continues "
+            "(distributed output type only)")("Restart.compression",
+            po::value<std::string>()->default_value("none"),
+            "Lossless compression of restart datasets: none, deflate or "
+            "shuffle_deflate")("Restart.compression_level",
+            po::value<short>()->default_value(1),
+            "Deflate compression level (1-9)")("Restart.cb_nodes",
+            po::value<short>()->default_value(0),
+            "Number of MPI-IO aggregators for single_file restart "
+            "(0 for MPI-IO default)")("Restart.rescale_v",
             po::value<double>()->default_value(1.),
             "rescaling factor velocity of all atoms")("Poisson.bcx",
             po::value<std::string>()->default_value("periodic"),
@@ -98,6 +111,9 @@ int read_config(int argc, char** argv, po::variables_map& vm,
             po::value<std::string>()->default_value("off"),
             "continuum solvent: on/off")("Run.type",
             po::value<std::string>()->default_value("QUENCH"), "Run type")(
+            "Run.profile_output", po::value<std::string>()->default_value(""),
+            "Prefix of JSON/CSV files for hierarchical profiling data "
+            "(no profiling if empty)")(
             "Quench.solver", po::value<std::string>()->default_value("ABPG"),
             "Iterative solver for quench")("Quench.max_steps",
             po::value<short>()->default_value(200),
@@ -225,15 +241,23 @@ int read_config(int argc, char** argv, po::variables_map& vm,
             "Multiplicative factor of kernel radius to set threshold in "
             "AOMM projectors dropping")("Orbitals.type",
             po::value<std::string>()->default_value("NO"),
-            "orbital type")("Orbitals.dotProduct",
+            "orbital type: NO, Orthonormal or Eigenfunctions")(
+            "Orbitals.dotProduct",
             po::value<std::string>()->default_value("diagonal"),
             "orbital dot product type")("Orbitals.overallocate_factor",
             po::value<float>()->default_value(1.2),
             "safety factor to use for static allocation of orbitals")(
             "Potentials.filterPseudo", po::value<char>()->default_value('f'),
-            "filter")("Poisson.solver",
+            "filter")("Potentials.projectors_reuse_tol",
+            po::value<float>()->default_value(-1.),
+            "max. atomic displacement for reusing nonlocal projectors "
+            "(no reuse if negative)")("Poisson.solver",
             po::value<std::string>()->default_value("CG"),
-            "solver")("Poisson.e0", po::value<float>()->default_value(78.36),
+            "solver")("Poisson.precision",
+            po::value<std::string>()->default_value("double"),
+            "precision of MG Poisson solver: double or mixed (single "
+            "precision V-cycles)")(
+            "Poisson.e0", po::value<float>()->default_value(78.36),
             "continuum solvent: epsilon0")("Poisson.rho0",
             po::value<float>()->default_value(0.0004),
             "continuum solvent: rho0")("Poisson.beta",
@@ -249,7 +273,13 @@ int read_config(int argc, char** argv, po::variables_map& vm,
             "Poisson.max_levels", po::value<short>()->default_value(10),
             "max. nb. MG levels Poisson solver")("Poisson.reset",
             po::value<bool>()->default_value(false),
-            "reset Hartree potential at each MD step")("ABPG.m",
+            "reset Hartree potential at each MD step")("Poisson.extrapolate",
+            po::value<bool>()->default_value(false),
+            "extrapolate Hartree potential from previous two MD steps")(
+            "Poisson.adaptive_tol_factor",
+            po::value<float>()->default_value(0.),
+            "if positive, relative tolerance of Hartree solves is that "
+            "factor times the SCF dvrho per atom")("ABPG.m",
             po::value<short>()->default_value(1),
             "History length for Anderson extrapolation")("ABPG.beta",
             po::value<float>()->default_value(1.),
@@ -299,13 +329,23 @@ int read_config(int argc, char** argv, po::variables_map& vm,
             "DensityMatrix.mixing", po::value<float>()->default_value(-1.),
             "Mixing coefficient for Density Matrix")("DensityMatrix.solver",
             po::value<std::string>()->default_value("Mixing"),
-            "Algorithm for updating Density Matrix: Mixing, MVP, HMVP")(
+            "Algorithm for updating Density Matrix: Mixing, MVP, HMVP, "
+            "ChebyshevFilter")("DensityMatrix.filter_degree",
+            po::value<short>()->default_value(10),
+            "Degree of Chebyshev polynomial filter applied to orbitals")(
             "DensityMatrix.nb_inner_it", po::value<short>()->default_value(3),
             "Max. number of inner iterations in DM optimization")(
             "DensityMatrix.algo",
             po::value<std::string>()->default_value("Diagonalization"),
             "Algorithm for computing Density Matrix. "
-            "Diagonalization or SP2 or Chebyshev.")("DensityMatrix.use_old",
+            "Diagonalization or SP2 or Chebyshev.")(
+            "DensityMatrix.eigensolver",
+            po::value<std::string>()->default_value("QR"),
+            "Dense eigensolver used for Diagonalization: QR, "
+            "DivideAndConquer or MRRR (MRRR requests only the occupied "
+            "and Orbitals.nempty eigenpairs, which usually are all the "
+            "orbitals, so it generally computes the full spectrum).")(
+            "DensityMatrix.use_old",
             po::value<bool>()->default_value(true),
             "Start DM optimization with matrix of previous WF step")(
             "DensityMatrix.approximation_order",
@@ -322,7 +362,23 @@ int read_config(int argc, char** argv, po::variables_map& vm,
             "approximation of density matrix. ")("DensityMatrix.tol",
             po::value<float>()->default_value(1.e-7),
             "tolerance, used in iterative DM computation convergence "
-            "criteria");
+            "criteria")("DensityMatrix.drop_tol",
+            po::value<float>()->default_value(0.),
+            "entries smaller than drop_tol are discarded in sparse SP2 "
+            "iterations (fill-in control)")("Rho.accumulation",
+            po::value<std::string>()->default_value("blocked"),
+            "Threaded accumulation of rho: atomic or blocked")(
+            "Orbitals.overlap_halo_comm",
+            po::value<bool>()->default_value(false),
+            "Overlap orbitals ghost values exchange with FD stencil "
+            "application on interior points")(
+            "Parallel.persistent_halo_comm",
+            po::value<bool>()->default_value(false),
+            "Use persistent MPI requests for ghost values exchanges")(
+            "Poisson.agglomeration_min_points",
+            po::value<int>()->default_value(0),
+            "Number of grid points per task below which multigrid levels "
+            "are redistributed onto fewer tasks (0: never)");
 
         po::options_description cmdline_options;
         cmdline_options.add(generic);
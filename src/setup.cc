@@ -72,6 +72,8 @@ int MGmol<OrbitalsType>::setupFromInput(const std::string filename)
         MatricesBlacsContext::instance().setup(mmpi.commSpin(), ct.numst);
 
         dist_matrix::DistMatrix<DISTMATDTYPE>::setBlockSize(64);
+        dist_matrix::DistMatrix<DISTMATDTYPE>::setEigensolver(
+            ct.DMDenseEigensolver());
 
         dist_matrix::DistMatrix<DISTMATDTYPE>::setDefaultBlacsContext(
             MatricesBlacsContext::instance().bcxt());
@@ -0,0 +1,220 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "CSRMatrix.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+CSRMatrix::CSRMatrix() : n_(0), shift_(32) { row_ptr_.push_back(0); }
+
+template <class T>
+CSRMatrix::CSRMatrix(const VariableSizeMatrix<T>& A) : CSRMatrix()
+{
+    assign(A);
+}
+
+template <class T>
+CSRMatrix::CSRMatrix(
+    const VariableSizeMatrix<T>& A, const std::vector<int>& rows)
+    : CSRMatrix()
+{
+    assign(A, rows);
+}
+
+void CSRMatrix::clear()
+{
+    n_ = 0;
+    lvars_.clear();
+    row_ptr_.assign(1, 0);
+    cols_.clear();
+    vals_.clear();
+    keys_.clear();
+    values_.clear();
+}
+
+// append row of a VariableSizeMatrix, sorting its column indexes
+// (work: buffer to sort entries)
+template <class T>
+void CSRMatrix::appendRow(
+    const T& row, const int gid, std::vector<std::pair<int, double>>& work)
+{
+    const std::vector<int>& cols   = row.getColumnIndexes();
+    const std::vector<double>& val = row.getColumnEntries();
+    const int nnz                  = (int)cols.size();
+
+    work.resize(nnz);
+    for (int j = 0; j < nnz; j++)
+        work[j] = std::make_pair(cols[j], val[j]);
+    std::sort(work.begin(), work.end());
+
+    for (auto& e : work)
+    {
+        cols_.push_back(e.first);
+        vals_.push_back(e.second);
+    }
+    lvars_.push_back(gid);
+    row_ptr_.push_back((int)cols_.size());
+    n_++;
+}
+
+template <class T>
+void CSRMatrix::assign(const VariableSizeMatrix<T>& A)
+{
+    clear();
+
+    const int n = A.n();
+    lvars_.reserve(n);
+    row_ptr_.reserve(n + 1);
+    cols_.reserve(A.nnzmat());
+    vals_.reserve(A.nnzmat());
+
+    std::vector<std::pair<int, double>> work;
+    for (int i = 0; i < n; i++)
+        appendRow(A.getRow(i), A.getLocalVariableGlobalIndex(i), work);
+
+    buildIndexMap();
+}
+
+template <class T>
+void CSRMatrix::assign(
+    const VariableSizeMatrix<T>& A, const std::vector<int>& rows)
+{
+    clear();
+
+    lvars_.reserve(rows.size());
+    row_ptr_.reserve(rows.size() + 1);
+
+    std::vector<std::pair<int, double>> work;
+    for (auto gid : rows)
+    {
+        int* rindex = (int*)A.getTableValue(gid);
+        if (rindex != nullptr) appendRow(A.getRow(*rindex), gid, work);
+    }
+
+    buildIndexMap();
+}
+
+void CSRMatrix::buildIndexMap()
+{
+    // capacity: power of 2 at least twice the number of rows
+    int nbits = 4;
+    while ((1 << nbits) < 2 * n_)
+        nbits++;
+    shift_ = 32 - nbits;
+
+    keys_.assign(1 << nbits, -1);
+    values_.assign(1 << nbits, -1);
+
+    const int mask = (1 << nbits) - 1;
+    for (int i = 0; i < n_; i++)
+    {
+        const int gid = lvars_[i];
+        assert(gid >= 0);
+        int pos = hash(gid);
+        while (keys_[pos] != -1)
+        {
+            assert(keys_[pos] != gid);
+            pos = (pos + 1) & mask;
+        }
+        keys_[pos]   = gid;
+        values_[pos] = i;
+    }
+}
+
+double CSRMatrix::get_value(const int row, const int col) const
+{
+    const int i = getLocalRowIndex(row);
+    if (i == -1) return 0.;
+
+    const auto begin = cols_.begin() + row_ptr_[i];
+    const auto end   = cols_.begin() + row_ptr_[i + 1];
+    const auto it    = std::lower_bound(begin, end, col);
+    if (it != end && *it == col) return vals_[it - cols_.begin()];
+
+    return 0.;
+}
+
+// merge two sorted sparse rows
+double CSRMatrix::dotRows(const int i, const CSRMatrix& B, const int j) const
+{
+    int ka       = row_ptr_[i];
+    const int ea = row_ptr_[i + 1];
+    int kb       = B.row_ptr_[j];
+    const int eb = B.row_ptr_[j + 1];
+
+    double val = 0.;
+    while (ka < ea && kb < eb)
+    {
+        const int ca = cols_[ka];
+        const int cb = B.cols_[kb];
+        if (ca == cb)
+        {
+            val += vals_[ka] * B.vals_[kb];
+            ka++;
+            kb++;
+        }
+        else if (ca < cb)
+            ka++;
+        else
+            kb++;
+    }
+
+    return val;
+}
+
+double CSRMatrix::AmultSymBdiag(const CSRMatrix& B, const int row) const
+{
+    return AmultSymB_ij(B, row, row);
+}
+
+double CSRMatrix::AmultSymB_ij(
+    const CSRMatrix& B, const int row, const int col) const
+{
+    const int i = getLocalRowIndex(row);
+    const int j = B.getLocalRowIndex(col);
+
+    /* return zero if row/col does not exist */
+    if (i == -1 || j == -1) return 0.;
+
+    return dotRows(i, B, j);
+}
+
+double CSRMatrix::trace() const
+{
+    double trace = 0.;
+    for (int i = 0; i < n_; i++)
+        trace += get_value(lvars_[i], lvars_[i]);
+
+    return trace;
+}
+
+double CSRMatrix::trace(const std::vector<int>& rows) const
+{
+    double trace = 0.;
+    for (auto i : rows)
+        trace += get_value(lvars_[i], lvars_[i]);
+
+    return trace;
+}
+
+template CSRMatrix::CSRMatrix(const VariableSizeMatrix<SparseRow>& A);
+template CSRMatrix::CSRMatrix(const VariableSizeMatrix<SparseRowAndTable>& A);
+template CSRMatrix::CSRMatrix(
+    const VariableSizeMatrix<SparseRow>& A, const std::vector<int>& rows);
+template CSRMatrix::CSRMatrix(const VariableSizeMatrix<SparseRowAndTable>& A,
+    const std::vector<int>& rows);
+template void CSRMatrix::assign(const VariableSizeMatrix<SparseRow>& A);
+template void CSRMatrix::assign(const VariableSizeMatrix<SparseRowAndTable>& A);
+template void CSRMatrix::assign(
+    const VariableSizeMatrix<SparseRow>& A, const std::vector<int>& rows);
+template void CSRMatrix::assign(
+    const VariableSizeMatrix<SparseRowAndTable>& A,
+    const std::vector<int>& rows);
@@ -0,0 +1,121 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+/*!
+ * Packed storage alternative to VariableSizeMatrix: all the rows are stored
+ * in single contiguous CSR arrays, with column indexes sorted within each
+ * row, and global row indexes mapped to local ones by an open-addressing
+ * hash table. Meant for read-only operations (traces of products, ...)
+ * on matrices assembled once, without chasing one pointer per row.
+ */
+#ifndef MGMOL_CSRMATRIX_H_
+#define MGMOL_CSRMATRIX_H_
+
+#include "VariableSizeMatrix.h"
+
+#include <utility>
+#include <vector>
+
+class CSRMatrix
+{
+    int n_; // number of local rows
+
+    std::vector<int> lvars_; // global index of each local row
+    std::vector<int> row_ptr_; // start of each row in cols_/vals_ (size n_+1)
+    std::vector<int> cols_; // global column indexes, sorted within each row
+    std::vector<double> vals_;
+
+    // open addressing hash table (linear probing) for global->local
+    // row indexes, with a power of 2 capacity
+    std::vector<int> keys_;
+    std::vector<int> values_;
+    int shift_;
+
+    int hash(const int key) const
+    {
+        // multiplicative (Fibonacci) hashing
+        return (int)(((unsigned int)key * 2654435761u) >> shift_);
+    }
+
+    void buildIndexMap();
+
+    template <class T>
+    void appendRow(const T& row, const int gid,
+        std::vector<std::pair<int, double>>& work);
+
+    // dot product of local row i with local row j of B
+    double dotRows(const int i, const CSRMatrix& B, const int j) const;
+
+public:
+    CSRMatrix();
+
+    // packed copy of A
+    template <class T>
+    explicit CSRMatrix(const VariableSizeMatrix<T>& A);
+
+    // packed copy of rows of A with global indexes "rows"
+    // (rows not in A are skipped)
+    template <class T>
+    CSRMatrix(const VariableSizeMatrix<T>& A, const std::vector<int>& rows);
+
+    template <class T>
+    void assign(const VariableSizeMatrix<T>& A);
+    template <class T>
+    void assign(const VariableSizeMatrix<T>& A, const std::vector<int>& rows);
+
+    void clear();
+
+    /* get local size */
+    int n() const { return n_; }
+
+    /* get total nnz */
+    int nnzmat() const { return (int)vals_.size(); }
+
+    /* get number of nonzeros for a local row */
+    int nnzrow(const int lrindex) const
+    {
+        if (lrindex >= n_) return 0;
+        return row_ptr_[lrindex + 1] - row_ptr_[lrindex];
+    }
+
+    /* get global index of local row */
+    int getLocalVariableGlobalIndex(const int lrindex) const
+    {
+        return lvars_[lrindex];
+    }
+
+    /* get local index of global row, -1 if not present */
+    int getLocalRowIndex(const int gid) const
+    {
+        if (n_ == 0) return -1;
+
+        const int mask = (int)keys_.size() - 1;
+        for (int pos = hash(gid);; pos = (pos + 1) & mask)
+        {
+            if (keys_[pos] == gid) return values_[pos];
+            if (keys_[pos] == -1) return -1;
+        }
+    }
+
+    /* get matrix entry */
+    double get_value(const int row, const int col) const;
+
+    /* compute i-th diagonal entry of A*B, where A is the current matrix
+     * object. Assume B is a symmetric square matrix. */
+    double AmultSymBdiag(const CSRMatrix& B, const int row) const;
+
+    /* compute ij-th entry of A*B. Assume B is symmetric. */
+    double AmultSymB_ij(const CSRMatrix& B, const int row, const int col) const;
+
+    double trace() const; /* compute the trace of the matrix */
+    double trace(const std::vector<int>&
+            rows) const; /* compute the trace of selected (local) rows */
+};
+
+#endif
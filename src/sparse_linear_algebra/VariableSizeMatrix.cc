@@ -15,6 +15,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
@@ -32,6 +33,7 @@ Timer VariableSizeMatrixInterface::AmultSymBLocal_tm_(
     "VariableSizeMatrix::AmultSymBLocal");
 Timer VariableSizeMatrixInterface::AmultSymB_tm_(
     "VariableSizeMatrix::AmultSymB");
+Timer VariableSizeMatrixInterface::AmultB_tm_("VariableSizeMatrix::AmultB");
 Timer VariableSizeMatrixInterface::insert_tm_(
     "VariableSizeMatrix::Init_with_squareLocMat");
 Timer VariableSizeMatrixInterface::updateRow_tm_(
@@ -754,48 +756,82 @@ void VariableSizeMatrix<T>::copyDataToArray(
  ** Current implementation assumes the rows of the pattern matrix
  ** span the column indexes of matrix A.
  * The pattern of result matrix C matches 'pattern' matrix
+ * Entries of C smaller than tol (in absolute value) are dropped
+ *
+ * Rows of A are stored densely, in the order of the pattern rows, so
+ * that they serve as expanded rows (Gustavson) without scattering.
+ * The positions in these rows of the column indexes of B are computed once,
+ * so that the inner loops do not need any hash table lookup, and rows are
+ * distributed among OpenMP threads.
  */
 template <class T>
 void VariableSizeMatrix<T>::AmultSymBLocal(VariableSizeMatrix<T>* B,
     VariableSizeMatrix<T>& C, const std::vector<int>& locfcns,
-    VariableSizeMatrix<SparseRowAndTable>& pattern, bool flag)
+    VariableSizeMatrix<SparseRowAndTable>& pattern, bool flag,
+    const double tol)
 {
     const int nb = (*B).n();
 
-    assert((int)locfcns.size() >= 0);
     assert(nb > 0);
     AmultSymBLocal_tm_.start();
 
+    // packed B, with positions in rows of A of its column indexes
+    // (-1 if no corresponding column entry)
+    std::vector<int> bptr(nb + 1, 0);
+    std::vector<int> bpos;
+    std::vector<double> bvals;
+    bpos.reserve((*B).nnzmat());
+    bvals.reserve((*B).nnzmat());
+    for (int j = 0; j < nb; j++)
+    {
+        const int nnzrow = (*B).nnzrow(j);
+        for (int k = 0; k < nnzrow; k++)
+        {
+            const int jrow = (*B).getColumnIndex(j, k);
+            const int* pos = (int*)pattern.getTableValue(jrow);
+            bpos.push_back(pos != nullptr ? *pos : -1);
+            bvals.push_back((*B).getRowEntry(j, k));
+        }
+        bptr[j + 1] = (int)bpos.size();
+    }
+
+    const int nrows = (int)locfcns.size();
+    int newnnz      = 0;
+
     /* Loop over rows of this matrix*/
-    for (std::vector<int>::const_iterator row = locfcns.begin();
-         row != locfcns.end(); ++row)
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+ : newnnz)
+#endif
+    for (int r = 0; r < nrows; r++)
     {
-        int* rindex = (int*)getTableValue(*row);
-        const int i = *rindex;
-        int* pidx   = (int*)pattern.getTableValue(*row);
+        const int row    = locfcns[r];
+        int* rindex      = (int*)getTableValue(row);
+        const int i      = *rindex;
+        int* pidx        = (int*)pattern.getTableValue(row);
+        const double* ai = data_[i]->getPtrToColumnEntries();
 
         for (int j = 0; j < nb; j++)
         {
             const int col = (*B).getLocalVariableGlobalIndex(j);
-            const int idx = pattern.getColumnPos(*pidx, col);
-            if (flag && (idx == -1)) continue;
+            if (flag && (pattern.getColumnPos(*pidx, col) == -1)) continue;
 
-            double val       = 0.0;
-            const int nnzrow = (*B).nnzrow(j);
-            for (int k = 0; k < nnzrow; k++)
+            double val = 0.0;
+            for (int k = bptr[j]; k < bptr[j + 1]; k++)
             {
-                const int jrow = (*B).getColumnIndex(j, k);
-
-                const int* pos = (int*)pattern.getTableValue(
-                    jrow); // check if corresponding column entry exists.
-                if (pos != nullptr)
-                    val += data_[i]->getEntryFromPosition(*pos)
-                           * (*B).getRowEntry(j, k);
+                const int pos = bpos[k];
+                if (pos != -1)
+                {
+                    assert(pos < data_[i]->nnz());
+                    val += ai[pos] * bvals[k];
+                }
             }
+            if (std::fabs(val) < tol) continue;
+
             C.data_[i]->insertEntry(col, val);
-            C.totnnz_++;
+            newnnz++;
         }
     }
+    C.totnnz_ += newnnz;
 
     AmultSymBLocal_tm_.stop();
     return;
@@ -806,47 +842,193 @@ void VariableSizeMatrix<T>::AmultSymBLocal(VariableSizeMatrix<T>* B,
  * is the current matrix object.
  * Assume B is a symmetric square matrix.
  * The pattern of result matrix C matches 'pattern' matrix
+ * Entries of C smaller than tol (in absolute value) are dropped
+ *
+ * Each row of A is scattered into a dense thread-local accumulator
+ * indexed by the (compacted) column indexes of B (Gustavson's expanded
+ * row), then multiplied by the rows of B. Rows are distributed among
+ * OpenMP threads.
  */
 template <class T>
 void VariableSizeMatrix<T>::AmultSymB(VariableSizeMatrix<T>* B,
     VariableSizeMatrix<T>& C, VariableSizeMatrix<SparseRowAndTable>& pattern,
-    bool flag)
+    bool flag, const double tol)
 {
     const int nb = (*B).n();
     assert(nb > 0);
 
     AmultSymB_tm_.start();
 
-    for (int i = 0; i < n_; i++)
+    // compact indexes for column indexes of B
+    std::vector<int> bcols;
+    (*B).getAllColumnIndexes(bcols);
+    const int nbcols = (int)bcols.size();
+
+    // packed B, with compact column indexes
+    std::vector<int> bptr(nb + 1, 0);
+    std::vector<int> bidx;
+    std::vector<double> bvals;
+    bidx.reserve((*B).nnzmat());
+    bvals.reserve((*B).nnzmat());
+    for (int j = 0; j < nb; j++)
     {
-        for (int j = 0; j < nb; j++)
+        const int nnzrow = (*B).nnzrow(j);
+        for (int k = 0; k < nnzrow; k++)
         {
-            const int col = (*B).getLocalVariableGlobalIndex(j);
-            int* pidx     = (int*)pattern.getTableValue(lvars_[i]);
-            const int idx = pattern.getColumnPos(*pidx, col);
-            if (flag && (idx == -1)) continue;
+            const int jrow = (*B).getColumnIndex(j, k);
+            bidx.push_back(
+                std::lower_bound(bcols.begin(), bcols.end(), jrow)
+                - bcols.begin());
+            bvals.push_back((*B).getRowEntry(j, k));
+        }
+        bptr[j + 1] = (int)bidx.size();
+    }
+
+    int newnnz = 0;
 
-            double val       = 0.0;
-            const int nnzrow = (*B).nnzrow(j);
-            for (int k = 0; k < nnzrow; k++)
+#ifdef _OPENMP
+#pragma omp parallel reduction(+ : newnnz)
+#endif
+    {
+        // expanded row of A and its nonzero positions
+        std::vector<double> acc(nbcols, 0.);
+        std::vector<int> nzpos;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int i = 0; i < n_; i++)
+        {
+            const std::vector<int>& acols    = data_[i]->getColumnIndexes();
+            const std::vector<double>& avals = data_[i]->getColumnEntries();
+            for (int k = 0; k < (int)acols.size(); k++)
             {
-                const int jrow = (*B).getColumnIndex(j, k);
-                const int pos  = getColumnPos(i, jrow);
-                if (pos != -1)
+                std::vector<int>::const_iterator it = std::lower_bound(
+                    bcols.begin(), bcols.end(), acols[k]);
+                if (it != bcols.end() && *it == acols[k])
                 {
-                    val += data_[i]->getEntryFromPosition(pos)
-                           * (*B).getRowEntry(j, k);
+                    const int p = it - bcols.begin();
+                    acc[p]      = avals[k];
+                    nzpos.push_back(p);
                 }
             }
-            C.data_[i]->insertEntry(col, val);
-            C.totnnz_++;
+
+            int* pidx = (int*)pattern.getTableValue(lvars_[i]);
+            for (int j = 0; j < nb; j++)
+            {
+                const int col = (*B).getLocalVariableGlobalIndex(j);
+                if (flag && (pattern.getColumnPos(*pidx, col) == -1)) continue;
+
+                double val = 0.0;
+                for (int k = bptr[j]; k < bptr[j + 1]; k++)
+                    val += acc[bidx[k]] * bvals[k];
+                if (std::fabs(val) < tol) continue;
+
+                C.data_[i]->insertEntry(col, val);
+                newnnz++;
+            }
+
+            // reset accumulator
+            for (auto p : nzpos)
+                acc[p] = 0.;
+            nzpos.clear();
         }
     }
+    C.totnnz_ += newnnz;
 
     AmultSymB_tm_.stop();
     return;
 }
 
+template <class T>
+void VariableSizeMatrix<T>::AmultB(const VariableSizeMatrix<T>& B,
+    VariableSizeMatrix<T>& C, const std::vector<int>& rows,
+    const double tol) const
+{
+    AmultB_tm_.start();
+
+    const int nb = B.n();
+    const int nc = C.n();
+
+    // packed B, with column indexes replaced by local row indexes of C
+    // (columns without a matching row in C are discarded)
+    std::vector<int> bptr(nb + 1, 0);
+    std::vector<int> bidx;
+    std::vector<double> bvals;
+    bidx.reserve(B.nnzmat());
+    bvals.reserve(B.nnzmat());
+    for (int j = 0; j < nb; j++)
+    {
+        const std::vector<int>& bcols   = B.data_[j]->getColumnIndexes();
+        const std::vector<double>& bval = B.data_[j]->getColumnEntries();
+        for (int k = 0; k < (int)bcols.size(); k++)
+        {
+            const int* cindex = (int*)C.getTableValue(bcols[k]);
+            if (cindex == nullptr) continue;
+            bidx.push_back(*cindex);
+            bvals.push_back(bval[k]);
+        }
+        bptr[j + 1] = (int)bidx.size();
+    }
+
+    const int nrows = (int)rows.size();
+    int newnnz      = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel reduction(+ : newnnz)
+#endif
+    {
+        // expanded row of C (Gustavson's algorithm) and its nonzero positions
+        std::vector<double> acc(nc, 0.);
+        std::vector<int> marker(nc, -1);
+        std::vector<int> nzpos;
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int r = 0; r < nrows; r++)
+        {
+            const int* aindex = (int*)getTableValue(rows[r]);
+            const int* cindex = (int*)C.getTableValue(rows[r]);
+            if (aindex == nullptr || cindex == nullptr) continue;
+
+            const T& arow                    = *data_[*aindex];
+            const std::vector<int>& acols    = arow.getColumnIndexes();
+            const std::vector<double>& avals = arow.getColumnEntries();
+            for (int k = 0; k < (int)acols.size(); k++)
+            {
+                const int* bindex = (int*)B.getTableValue(acols[k]);
+                if (bindex == nullptr) continue;
+
+                const double a = avals[k];
+                for (int l = bptr[*bindex]; l < bptr[*bindex + 1]; l++)
+                {
+                    const int p = bidx[l];
+                    if (marker[p] != r)
+                    {
+                        marker[p] = r;
+                        acc[p]    = 0.;
+                        nzpos.push_back(p);
+                    }
+                    acc[p] += a * bvals[l];
+                }
+            }
+
+            T* crow = C.data_[*cindex];
+            for (auto p : nzpos)
+            {
+                if (std::fabs(acc[p]) < tol) continue;
+                crow->insertEntry(C.lvars_[p], acc[p]);
+                newnnz++;
+            }
+            nzpos.clear();
+        }
+    }
+    C.totnnz_ += newnnz;
+
+    AmultB_tm_.stop();
+}
+
 /* Reset matrix to zero, keeping only rows specified by keeprow[row]==true as
  * nonzero rows */
 template <class T>
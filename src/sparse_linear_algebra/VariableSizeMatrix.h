@@ -475,13 +475,23 @@ public:
 
     // matrix multiplication operations (locally centered contributions only)
     // flag== true => compute entries for specific nonzero pattern only
+    // entries smaller than tol are dropped
     void AmultSymBLocal(VariableSizeMatrix<T>* B, VariableSizeMatrix<T>& C,
         const std::vector<int>& locfcns,
-        VariableSizeMatrix<SparseRowAndTable>& pattern, bool flag = true);
+        VariableSizeMatrix<SparseRowAndTable>& pattern, bool flag = true,
+        const double tol = 0.);
 
     // matrix multiplication operations
     void AmultSymB(VariableSizeMatrix<T>* B, VariableSizeMatrix<T>& C,
-        VariableSizeMatrix<SparseRowAndTable>& pattern, bool flag = true);
+        VariableSizeMatrix<SparseRowAndTable>& pattern, bool flag = true,
+        const double tol = 0.);
+
+    // general matrix multiplication C = A*B for rows of A with global
+    // indexes "rows" (rows of C assumed empty). Rows of B are found by
+    // global index (missing ones contribute zero), only columns matching
+    // rows of C are kept and entries smaller than tol are dropped
+    void AmultB(const VariableSizeMatrix<T>& B, VariableSizeMatrix<T>& C,
+        const std::vector<int>& rows, const double tol = 0.) const;
 
     const std::vector<int>& lvars() const { return lvars_; }
 
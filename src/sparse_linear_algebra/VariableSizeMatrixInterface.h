@@ -36,6 +36,7 @@ protected:
     static Timer AmultSymB_ij_tm_;
     static Timer AmultSymBLocal_tm_;
     static Timer AmultSymB_tm_;
+    static Timer AmultB_tm_;
 
 public:
     virtual ~VariableSizeMatrixInterface() {}
@@ -46,6 +47,7 @@ public:
         AmultSymB_ij_tm_.print(os);
         AmultSymBLocal_tm_.print(os);
         AmultSymB_tm_.print(os);
+        AmultB_tm_.print(os);
         insert_tm_.print(os);
         updateRow_tm_.print(os);
         insertRow_tm_.print(os);
@@ -9,6 +9,7 @@
 
 #include "MGmol_MPI.h"
 #include "MPIdata.h"
+#include "Profiler.h"
 #include "Timer.h"
 #include "mgmol_mpi_tools.h"
 
@@ -161,6 +162,7 @@ void MGmol_MPI::setupComm(
 
 int MGmol_MPI::bcast(double* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(double));
     int mpi_err = MPI_Bcast(val, size, MPI_DOUBLE, root, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -172,6 +174,7 @@ int MGmol_MPI::bcast(double* val, int size, int root) const
 
 int MGmol_MPI::bcast(float* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(float));
     int mpi_err = MPI_Bcast(val, size, MPI_FLOAT, root, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -183,6 +186,7 @@ int MGmol_MPI::bcast(float* val, int size, int root) const
 
 int MGmol_MPI::bcast(int* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(int));
     int mpi_err = MPI_Bcast(val, size, MPI_INT, root, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -193,6 +197,7 @@ int MGmol_MPI::bcast(int* val, int size, int root) const
 
 int MGmol_MPI::bcast(short* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(short));
     int mpi_err = MPI_Bcast(val, size, MPI_SHORT, root, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -203,6 +208,7 @@ int MGmol_MPI::bcast(short* val, int size, int root) const
 
 int MGmol_MPI::bcastGlobal(double* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(double));
     int mpi_err = MPI_Bcast(val, size, MPI_DOUBLE, root, comm_global_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -213,6 +219,7 @@ int MGmol_MPI::bcastGlobal(double* val, int size, int root) const
 
 int MGmol_MPI::bcastGlobal(short* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(short));
     int mpi_err = MPI_Bcast(val, size, MPI_SHORT, root, comm_global_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -223,6 +230,7 @@ int MGmol_MPI::bcastGlobal(short* val, int size, int root) const
 
 int MGmol_MPI::bcastGlobal(int* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(int));
     int mpi_err = MPI_Bcast(val, size, MPI_INT, root, comm_global_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -233,6 +241,7 @@ int MGmol_MPI::bcastGlobal(int* val, int size, int root) const
 
 int MGmol_MPI::bcast(char* val, int size, int root) const
 {
+    Profiler::addCollectiveBytes(size * sizeof(char));
     int mpi_err = MPI_Bcast(val, size, MPI_CHAR, root, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
     {
@@ -268,6 +277,7 @@ int MGmol_MPI::reduce(
 int MGmol_MPI::allreduce(
     double* sendbuf, double* recvbuf, int count, MPI_Op op) const
 {
+    Profiler::addCollectiveBytes(count * sizeof(double));
     int mpi_err
         = MPI_Allreduce(sendbuf, recvbuf, count, MPI_DOUBLE, op, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
@@ -281,6 +291,7 @@ int MGmol_MPI::allreduce(
 int MGmol_MPI::allreduce(
     float* sendbuf, float* recvbuf, int count, MPI_Op op) const
 {
+    Profiler::addCollectiveBytes(count * sizeof(float));
     int mpi_err
         = MPI_Allreduce(sendbuf, recvbuf, count, MPI_FLOAT, op, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
@@ -293,6 +304,7 @@ int MGmol_MPI::allreduce(
 
 int MGmol_MPI::allreduce(int* sendbuf, int* recvbuf, int count, MPI_Op op) const
 {
+    Profiler::addCollectiveBytes(count * sizeof(int));
     int mpi_err
         = MPI_Allreduce(sendbuf, recvbuf, count, MPI_INT, op, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
@@ -305,6 +317,7 @@ int MGmol_MPI::allreduce(int* sendbuf, int* recvbuf, int count, MPI_Op op) const
 int MGmol_MPI::allreduce(
     short* sendbuf, short* recvbuf, int count, MPI_Op op) const
 {
+    Profiler::addCollectiveBytes(count * sizeof(short));
     int mpi_err
         = MPI_Allreduce(sendbuf, recvbuf, count, MPI_SHORT, op, comm_spin_);
     if (mpi_err != MPI_SUCCESS)
@@ -317,6 +330,7 @@ int MGmol_MPI::allreduce(
 int MGmol_MPI::allreduceGlobal(
     int* sendbuf, int* recvbuf, int count, MPI_Op op) const
 {
+    Profiler::addCollectiveBytes(count * sizeof(int));
     int mpi_err
         = MPI_Allreduce(sendbuf, recvbuf, count, MPI_INT, op, comm_global_);
     if (mpi_err != MPI_SUCCESS)
@@ -329,6 +343,7 @@ int MGmol_MPI::allreduceGlobal(
 int MGmol_MPI::allreduceGlobal(
     double* sendbuf, double* recvbuf, int count, MPI_Op op) const
 {
+    Profiler::addCollectiveBytes(count * sizeof(double));
     int mpi_err
         = MPI_Allreduce(sendbuf, recvbuf, count, MPI_DOUBLE, op, comm_global_);
     if (mpi_err != MPI_SUCCESS)
@@ -383,6 +398,7 @@ int MGmol_MPI::getRankMaxVal(const float val, int* rank)
 int MGmol_MPI::allreduceImages(
     double* sendbuf, double* recvbuf, int count, MPI_Op op) const
 {
+    Profiler::addCollectiveBytes(count * sizeof(double));
     int mpi_err
         = MPI_Allreduce(sendbuf, recvbuf, count, MPI_DOUBLE, op, comm_images_);
     if (mpi_err != MPI_SUCCESS)
@@ -1261,6 +1277,7 @@ int MGmol_MPI::scatter(
 void MGmol_MPI::split_allreduce_sums_float(float* array, const int nelements)
 {
     split_allreduce_sums_float_tm_.start();
+    Profiler::addCollectiveBytes(nelements * sizeof(float));
 
     const int work_size = MIN(MAX_SIZE, nelements);
     float* work_float   = new float[work_size];
@@ -1305,6 +1322,7 @@ void MGmol_MPI::split_allreduce_sums_float(float* array, const int nelements)
 void MGmol_MPI::split_allreduce_sums_double(double* array, const int nelements)
 {
     split_allreduce_sums_double_tm_.start();
+    Profiler::addCollectiveBytes(nelements * sizeof(double));
 
     const int work_size = MIN(MAX_SIZE, nelements);
     double* work_double = new double[work_size];
@@ -1348,6 +1366,7 @@ void MGmol_MPI::split_allreduce_sums_double(double* array, const int nelements)
 
 void MGmol_MPI::split_allreduce_sums_int(int* array, const int nelements)
 {
+    Profiler::addCollectiveBytes(nelements * sizeof(int));
     int* work_int = new int[MAX_SIZE];
 
     int newsize   = MAX_SIZE;
@@ -1388,6 +1407,7 @@ void MGmol_MPI::split_allreduce_sums_int(int* array, const int nelements)
 void MGmol_MPI::split_allreduce_sums_short(
     short int* array, const int nelements)
 {
+    Profiler::addCollectiveBytes(nelements * sizeof(short));
     assert(nelements > 0);
 
     short* work_short = new short[MAX_SIZE];
@@ -0,0 +1,396 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+bool Profiler::enabled_ = false;
+
+namespace
+{
+// number of statistics (min, avg, max) for each quantity
+const int nstats = 3;
+
+std::vector<std::string> splitPath(const std::string& path)
+{
+    std::vector<std::string> names;
+    std::stringstream ss(path);
+    std::string name;
+    while (std::getline(ss, name, '/'))
+        names.push_back(name);
+    return names;
+}
+
+std::string escapeJSON(const std::string& str)
+{
+    std::string escaped;
+    for (auto c : str)
+    {
+        if (c == '"' || c == '\\') escaped.push_back('\\');
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+
+std::string quoteCSV(const std::string& str)
+{
+    std::string quoted("\"");
+    for (auto c : str)
+    {
+        if (c == '"') quoted.push_back('"');
+        quoted.push_back(c);
+    }
+    quoted.push_back('"');
+    return quoted;
+}
+
+// reduce values over tasks and store min, avg, max on task 0
+void reduceStats(const std::vector<double>& values, const int nvalues,
+    std::vector<std::vector<double>>& stats, MPI_Comm comm)
+{
+    int ntasks;
+    MPI_Comm_size(comm, &ntasks);
+
+    const int n = static_cast<int>(values.size());
+    std::vector<double> vmin(n);
+    std::vector<double> vmax(n);
+    std::vector<double> vsum(n);
+    if (n > 0)
+    {
+        std::vector<double> sendbuf(values);
+        MPI_Reduce(sendbuf.data(), vmin.data(), n, MPI_DOUBLE, MPI_MIN, 0,
+            comm);
+        MPI_Reduce(sendbuf.data(), vmax.data(), n, MPI_DOUBLE, MPI_MAX, 0,
+            comm);
+        MPI_Reduce(sendbuf.data(), vsum.data(), n, MPI_DOUBLE, MPI_SUM, 0,
+            comm);
+    }
+
+    const int nitems = n / nvalues;
+    stats.resize(nitems);
+    for (int i = 0; i < nitems; i++)
+    {
+        stats[i].resize(nstats * nvalues);
+        for (int j = 0; j < nvalues; j++)
+        {
+            const int k              = i * nvalues + j;
+            stats[i][nstats * j]     = vmin[k];
+            stats[i][nstats * j + 1] = vsum[k] / ntasks;
+            stats[i][nstats * j + 2] = vmax[k];
+        }
+    }
+}
+
+void writeStatsJSON(std::ostream& os, const std::string& name,
+    const std::vector<double>& stats, const int j)
+{
+    os << "\"" << name << "\": {\"min\": " << stats[nstats * j]
+       << ", \"avg\": " << stats[nstats * j + 1]
+       << ", \"max\": " << stats[nstats * j + 2] << "}";
+}
+
+void writeStatsCSV(std::ostream& os, const std::vector<double>& stats)
+{
+    for (auto s : stats)
+        os << "," << s;
+    os << std::endl;
+}
+}
+
+Profiler::Profiler() : thread_id_(std::this_thread::get_id()) { reset(); }
+
+void Profiler::enable()
+{
+    thread_id_ = std::this_thread::get_id();
+    enabled_   = true;
+}
+
+void Profiler::reset()
+{
+    regions_.clear();
+    regions_.emplace_back("", -1);
+    current_ = 0;
+
+    halo_bytes_       = 0.;
+    collective_bytes_ = 0.;
+
+    open_steps_.clear();
+    steps_.clear();
+}
+
+void Profiler::start(const std::string& name)
+{
+    if (!recording()) return;
+
+    int index = 0;
+    auto it   = regions_[current_].children.find(name);
+    if (it == regions_[current_].children.end())
+    {
+        index = static_cast<int>(regions_.size());
+        regions_.emplace_back(name, current_);
+        regions_[current_].children.insert(std::make_pair(name, index));
+    }
+    else
+    {
+        index = it->second;
+    }
+
+    regions_[index].ncalls++;
+    regions_[index].start = MPI_Wtime();
+    current_              = index;
+}
+
+void Profiler::stop(const std::string& name)
+{
+    if (!recording()) return;
+
+    // look for region in stack of running regions
+    int index = current_;
+    while (index > 0 && regions_[index].name != name)
+        index = regions_[index].parent;
+
+    // region not running (started before profiler was enabled,
+    // or closed by an enclosing region)
+    if (index == 0) return;
+
+    const double t = MPI_Wtime();
+    int i          = current_;
+    for (;;)
+    {
+        regions_[i].time += t - regions_[i].start;
+        if (i == index) break;
+        i = regions_[i].parent;
+    }
+    current_ = regions_[index].parent;
+}
+
+void Profiler::startStep(const std::string& kind, const int index)
+{
+    if (!recording()) return;
+
+    start(kind);
+
+    // store values at beginning of step
+    Step step = { kind, index, MPI_Wtime(), halo_bytes_, collective_bytes_ };
+    open_steps_.push_back(step);
+}
+
+void Profiler::stopStep()
+{
+    if (!recording() || open_steps_.empty()) return;
+
+    Step step = open_steps_.back();
+    open_steps_.pop_back();
+
+    step.time             = MPI_Wtime() - step.time;
+    step.halo_bytes       = halo_bytes_ - step.halo_bytes;
+    step.collective_bytes = collective_bytes_ - step.collective_bytes;
+    steps_.push_back(step);
+
+    stop(step.kind);
+}
+
+std::string Profiler::path(const int index) const
+{
+    std::string str(regions_[index].name);
+    int i = regions_[index].parent;
+    while (i > 0)
+    {
+        str = regions_[i].name + "/" + str;
+        i   = regions_[i].parent;
+    }
+    return str;
+}
+
+void Profiler::write(const std::string& prefix, MPI_Comm comm) const
+{
+    int mytask, ntasks;
+    MPI_Comm_rank(comm, &mytask);
+    MPI_Comm_size(comm, &ntasks);
+
+    const double t     = MPI_Wtime();
+    const int nregions = static_cast<int>(regions_.size());
+    std::vector<double> time(nregions);
+    for (int i = 0; i < nregions; i++)
+        time[i] = regions_[i].time;
+    // add time elapsed so far for regions still running
+    for (int i = current_; i > 0; i = regions_[i].parent)
+        time[i] += t - regions_[i].start;
+
+    // gather paths of all the regions found on each task
+    std::map<std::string, int> local_index;
+    std::string local_paths;
+    for (int i = 1; i < nregions; i++)
+    {
+        const std::string p(path(i));
+        local_index[p] = i;
+        local_paths.append(p);
+        local_paths.push_back('\n');
+    }
+
+    int size = static_cast<int>(local_paths.size());
+    std::vector<int> sizes(ntasks);
+    MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+    std::vector<int> displs(ntasks, 0);
+    for (int i = 1; i < ntasks; i++)
+        displs[i] = displs[i - 1] + sizes[i - 1];
+    std::vector<char> all_paths(
+        mytask == 0 ? displs[ntasks - 1] + sizes[ntasks - 1] + 1 : 1);
+    MPI_Gatherv(&local_paths[0], size, MPI_CHAR, all_paths.data(),
+        sizes.data(), displs.data(), MPI_CHAR, 0, comm);
+
+    // union of paths, sorted so that regions appear in tree order
+    std::string union_paths;
+    if (mytask == 0)
+    {
+        std::map<std::vector<std::string>, std::string> tree;
+        std::stringstream ss(
+            std::string(all_paths.begin(), all_paths.end() - 1));
+        std::string p;
+        while (std::getline(ss, p))
+            tree[splitPath(p)] = p;
+        for (auto& node : tree)
+        {
+            union_paths.append(node.second);
+            union_paths.push_back('\n');
+        }
+    }
+    size = static_cast<int>(union_paths.size());
+    MPI_Bcast(&size, 1, MPI_INT, 0, comm);
+    union_paths.resize(size);
+    MPI_Bcast(&union_paths[0], size, MPI_CHAR, 0, comm);
+
+    std::vector<std::string> paths;
+    std::stringstream ss(union_paths);
+    std::string p;
+    while (std::getline(ss, p))
+        paths.push_back(p);
+
+    // values for each region: ncalls, time, halo and collective bytes
+    const int nvalues = 4;
+    std::vector<double> values(nvalues * paths.size(), 0.);
+    for (unsigned i = 0; i < paths.size(); i++)
+    {
+        auto it = local_index.find(paths[i]);
+        if (it != local_index.end())
+        {
+            const Region& region    = regions_[it->second];
+            values[nvalues * i]     = region.ncalls;
+            values[nvalues * i + 1] = time[it->second];
+            values[nvalues * i + 2] = region.halo_bytes;
+            values[nvalues * i + 3] = region.collective_bytes;
+        }
+    }
+    std::vector<std::vector<double>> stats;
+    reduceStats(values, nvalues, stats, comm);
+
+    // steps completed by all tasks
+    int nsteps = static_cast<int>(steps_.size());
+    MPI_Allreduce(MPI_IN_PLACE, &nsteps, 1, MPI_INT, MPI_MIN, comm);
+    const int nstep_values = 3;
+    std::vector<double> step_values(nstep_values * nsteps);
+    for (int i = 0; i < nsteps; i++)
+    {
+        step_values[nstep_values * i]     = steps_[i].time;
+        step_values[nstep_values * i + 1] = steps_[i].halo_bytes;
+        step_values[nstep_values * i + 2] = steps_[i].collective_bytes;
+    }
+    std::vector<std::vector<double>> step_stats;
+    reduceStats(step_values, nstep_values, step_stats, comm);
+
+    if (mytask == 0)
+    {
+        writeJSON(prefix + ".json", ntasks, paths, stats, step_stats);
+        writeCSV(prefix + ".csv", paths, stats);
+        writeStepsCSV(prefix + "_steps.csv", step_stats);
+    }
+}
+
+void Profiler::writeJSON(const std::string& filename, const int ntasks,
+    const std::vector<std::string>& paths,
+    const std::vector<std::vector<double>>& stats,
+    const std::vector<std::vector<double>>& step_stats) const
+{
+    std::ofstream os(filename.c_str());
+    os << std::setprecision(6);
+
+    os << "{" << std::endl;
+    os << "  \"ntasks\": " << ntasks << "," << std::endl;
+    os << "  \"regions\": [" << std::endl;
+    for (unsigned i = 0; i < paths.size(); i++)
+    {
+        const std::vector<std::string> names(splitPath(paths[i]));
+        os << "    {\"path\": \"" << escapeJSON(paths[i]) << "\", \"name\": \""
+           << escapeJSON(names.back()) << "\", \"depth\": " << names.size() - 1
+           << ", ";
+        writeStatsJSON(os, "ncalls", stats[i], 0);
+        os << ", ";
+        writeStatsJSON(os, "time", stats[i], 1);
+        os << ", ";
+        writeStatsJSON(os, "halo_bytes", stats[i], 2);
+        os << ", ";
+        writeStatsJSON(os, "collective_bytes", stats[i], 3);
+        os << "}" << (i + 1 < paths.size() ? "," : "") << std::endl;
+    }
+    os << "  ]," << std::endl;
+    os << "  \"steps\": [" << std::endl;
+    for (unsigned i = 0; i < step_stats.size(); i++)
+    {
+        os << "    {\"kind\": \"" << escapeJSON(steps_[i].kind)
+           << "\", \"index\": " << steps_[i].index << ", ";
+        writeStatsJSON(os, "time", step_stats[i], 0);
+        os << ", ";
+        writeStatsJSON(os, "halo_bytes", step_stats[i], 1);
+        os << ", ";
+        writeStatsJSON(os, "collective_bytes", step_stats[i], 2);
+        os << "}" << (i + 1 < step_stats.size() ? "," : "") << std::endl;
+    }
+    os << "  ]" << std::endl;
+    os << "}" << std::endl;
+}
+
+void Profiler::writeCSV(const std::string& filename,
+    const std::vector<std::string>& paths,
+    const std::vector<std::vector<double>>& stats) const
+{
+    std::ofstream os(filename.c_str());
+    os << std::setprecision(6);
+
+    os << "path,depth,ncalls_min,ncalls_avg,ncalls_max,time_min,time_avg,"
+          "time_max,halo_bytes_min,halo_bytes_avg,halo_bytes_max,"
+          "collective_bytes_min,collective_bytes_avg,collective_bytes_max"
+       << std::endl;
+    for (unsigned i = 0; i < paths.size(); i++)
+    {
+        os << quoteCSV(paths[i]) << ","
+           << std::count(paths[i].begin(), paths[i].end(), '/');
+        writeStatsCSV(os, stats[i]);
+    }
+}
+
+void Profiler::writeStepsCSV(const std::string& filename,
+    const std::vector<std::vector<double>>& step_stats) const
+{
+    std::ofstream os(filename.c_str());
+    os << std::setprecision(6);
+
+    os << "kind,index,time_min,time_avg,time_max,halo_bytes_min,"
+          "halo_bytes_avg,halo_bytes_max,collective_bytes_min,"
+          "collective_bytes_avg,collective_bytes_max"
+       << std::endl;
+    for (unsigned i = 0; i < step_stats.size(); i++)
+    {
+        os << quoteCSV(steps_[i].kind) << "," << steps_[i].index;
+        writeStatsCSV(os, step_stats[i]);
+    }
+}
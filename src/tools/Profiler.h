@@ -0,0 +1,184 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#ifndef MGMOL_PROFILER_H
+#define MGMOL_PROFILER_H
+
+#include <map>
+#include <mpi.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Hierarchical profiler.
+// Every Timer started while the profiler is enabled opens a region nested
+// in the region of the timer running at that time, so that time is
+// attributed to the calling context (path of enclosing timers) instead of
+// a flat list of timers.
+// Regions also count bytes sent in halo exchanges and MPI collectives.
+// SCF and MD iterations are marked as steps, for which time and bytes
+// are recorded individually.
+// Results are reduced across MPI tasks (min/avg/max) and written in JSON
+// and CSV formats.
+// Only the thread that enabled the profiler records data.
+class Profiler
+{
+    struct Region
+    {
+        std::string name;
+        int parent;
+        std::map<std::string, int> children;
+
+        int ncalls;
+        double time;
+        double start;
+        double halo_bytes;
+        double collective_bytes;
+
+        Region(const std::string& region_name, const int parent_index)
+            : name(region_name),
+              parent(parent_index),
+              ncalls(0),
+              time(0.),
+              start(0.),
+              halo_bytes(0.),
+              collective_bytes(0.)
+        {
+        }
+    };
+
+    struct Step
+    {
+        std::string kind;
+        int index;
+        double time;
+        double halo_bytes;
+        double collective_bytes;
+    };
+
+    static bool enabled_;
+
+    std::thread::id thread_id_;
+
+    // regions_[0] is the root of the tree
+    std::vector<Region> regions_;
+
+    // region currently running
+    int current_;
+
+    // totals used to compute steps data
+    double halo_bytes_;
+    double collective_bytes_;
+
+    // steps in progress and completed steps
+    std::vector<Step> open_steps_;
+    std::vector<Step> steps_;
+
+    Profiler();
+
+    bool recording() const
+    {
+        return enabled_ && std::this_thread::get_id() == thread_id_;
+    }
+
+    std::string path(const int index) const;
+
+    void writeJSON(const std::string& filename, const int ntasks,
+        const std::vector<std::string>& paths,
+        const std::vector<std::vector<double>>& stats,
+        const std::vector<std::vector<double>>& step_stats) const;
+    void writeCSV(const std::string& filename,
+        const std::vector<std::string>& paths,
+        const std::vector<std::vector<double>>& stats) const;
+    void writeStepsCSV(const std::string& filename,
+        const std::vector<std::vector<double>>& step_stats) const;
+
+public:
+    static Profiler& instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    static bool enabled() { return enabled_; }
+
+    // start recording data from calling thread
+    void enable();
+    void disable() { enabled_ = false; }
+
+    // clear all data
+    void reset();
+
+    // open region "name" nested in current region
+    void start(const std::string& name);
+
+    // close region "name" and any region nested in it still running
+    void stop(const std::string& name);
+
+    // mark beginning and end of iteration "index" of type "kind"
+    // (e.g. "SCF step")
+    void startStep(const std::string& kind, const int index);
+    void stopStep();
+
+    static void addHaloBytes(const double nbytes)
+    {
+        if (enabled_)
+        {
+            Profiler& profiler = instance();
+            if (profiler.recording())
+            {
+                profiler.regions_[profiler.current_].halo_bytes += nbytes;
+                profiler.halo_bytes_ += nbytes;
+            }
+        }
+    }
+
+    static void addCollectiveBytes(const double nbytes)
+    {
+        if (enabled_)
+        {
+            Profiler& profiler = instance();
+            if (profiler.recording())
+            {
+                profiler.regions_[profiler.current_].collective_bytes
+                    += nbytes;
+                profiler.collective_bytes_ += nbytes;
+            }
+        }
+    }
+
+    // Reduce data over all tasks of comm and write files
+    // "prefix.json", "prefix.csv" and "prefix_steps.csv" (by task 0).
+    // Needs to be called by all tasks in comm.
+    void write(const std::string& prefix, MPI_Comm comm) const;
+};
+
+// Mark iteration of a loop as a profiler step for the lifetime of an
+// object of this class
+class ProfilerStep
+{
+    const bool active_;
+
+public:
+    ProfilerStep(const std::string& kind, const int index)
+        : active_(Profiler::enabled())
+    {
+        if (active_) Profiler::instance().startStep(kind, index);
+    }
+
+    ~ProfilerStep()
+    {
+        if (active_) Profiler::instance().stopStep();
+    }
+
+    ProfilerStep(const ProfilerStep&) = delete;
+    ProfilerStep& operator=(const ProfilerStep&) = delete;
+};
+
+#endif
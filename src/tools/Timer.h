@@ -10,6 +10,8 @@
 #ifndef MGMOL_TIMER_H
 #define MGMOL_TIMER_H
 
+#include "Profiler.h"
+
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -87,6 +89,7 @@ public:
             t_       = gtod();
             running_ = true;
             ncalls_++;
+            if (Profiler::enabled()) Profiler::instance().start(name_);
         }
     };
 
@@ -102,6 +105,7 @@ public:
                 total_cpu_ += ((double)(clock() - clk_)) / CLOCKS_PER_SEC;
                 total_real_ += gtod() - t_;
                 running_ = false;
+                if (Profiler::enabled()) Profiler::instance().stop(name_);
             }
     };
 
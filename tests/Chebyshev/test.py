@@ -90,5 +90,24 @@ for line in lines:
         sys.exit(1)
     break
 
+tol = 1.e-8
+print("Check trace from Chebyshev moments against trace of matrix...")
+ntraces=0
+for line in lines:
+  if line.count(b'Chebyshev trace from moments'):
+    words=line.split()
+    trace_matrix = eval(words[10].split(b',')[0])
+    difference = eval(words[13])
+    ntraces=ntraces+1
+    if abs(difference)>tol*abs(trace_matrix):
+      print(line)
+      print("Check Chebyshev trace test FAILED")
+      sys.exit(1)
+
+if ntraces==0:
+  print("No Chebyshev trace found in output")
+  sys.exit(1)
+print("Checked {} Chebyshev traces".format(ntraces))
+
 print("Test PASSED")
 sys.exit(0)
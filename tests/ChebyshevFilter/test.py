@@ -0,0 +1,86 @@
+#!/usr/bin/env python
+import sys
+import os
+import subprocess
+import string
+
+print("Test Chebyshev filter DM strategy...")
+
+def getEnergies(lines):
+  converged=0
+  energies=[]
+  for line in lines:
+    if line.count(b'%%'):
+      print(line)
+      words=line.split()
+      energy=(words[5].split(b','))[0]
+      energies.append(energy)
+    if line.count(b'DFTsolver:') and line.count(b'convergence'):
+      converged=1
+  return converged, energies
+
+nargs=len(sys.argv)
+
+mpicmd = sys.argv[1]+" "+sys.argv[2]+" "+sys.argv[3]
+for i in range(4,nargs-5):
+  mpicmd = mpicmd + " "+sys.argv[i]
+print("MPI run command: {}".format(mpicmd))
+
+exe = sys.argv[nargs-5]
+inp1 = sys.argv[nargs-4]
+inp2 = sys.argv[nargs-3]
+coords = sys.argv[nargs-2]
+print("coordinates file: %s"%coords)
+
+#create links to potentials files
+dst1 = 'pseudo.Si'
+dst2 = 'pseudo.H'
+src1 = sys.argv[nargs-1] + '/' + dst1
+src2 = sys.argv[nargs-1] + '/' + dst2
+
+if not os.path.exists(dst1):
+  print("Create link to %s"%dst1)
+  os.symlink(src1, dst1)
+if not os.path.exists(dst2):
+  print("Create link to %s"%dst2)
+  os.symlink(src2, dst2)
+
+#run reference quench with diagonalization
+command1 = "{} {} -c {} -i {}".format(mpicmd,exe,inp1,coords)
+print("Run command: {}".format(command1))
+output1 = subprocess.check_output(command1,shell=True)
+lines1=output1.split(b'\n')
+
+#run quench with Chebyshev filter
+command2 = "{} {} -c {} -i {}".format(mpicmd,exe,inp2,coords)
+print("Run command: {}".format(command2))
+output2 = subprocess.check_output(command2,shell=True)
+lines2=output2.split(b'\n')
+
+os.remove(dst1)
+os.remove(dst2)
+
+converged1, energies1 = getEnergies(lines1)
+if converged1==0:
+  print("Reference quench did not converge")
+  sys.exit(1)
+
+#filter uses temporary orbitals: a wrong H*phi for the orbitals
+#would prevent convergence to the reference energy
+converged2, energies2 = getEnergies(lines2)
+if converged2==0:
+  print("Quench with Chebyshev filter did not converge")
+  sys.exit(1)
+
+print("Check energy...")
+tol = 1.e-5
+energy1 = eval(energies1[-1])
+energy2 = eval(energies2[-1])
+print("Energy with diagonalization = {}".format(energy1))
+print("Energy with Chebyshev filter = {}".format(energy2))
+if abs(energy2-energy1)>tol:
+  print("Energies differ: {} vs {} !!!".format(energy1,energy2))
+  sys.exit(1)
+
+print("Test PASSED")
+sys.exit(0)
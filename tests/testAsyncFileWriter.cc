@@ -0,0 +1,58 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "AsyncFileWriter.h"
+
+#include "catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+static std::vector<char> readFile(const std::string& filename)
+{
+    std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+    return std::vector<char>(
+        (std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+}
+
+TEST_CASE("Check asynchronous file writes", "[async_write]")
+{
+    AsyncFileWriter writer;
+
+    const std::string filename1("testAsyncFileWriter1.dat");
+    const std::string filename2("testAsyncFileWriter2.dat");
+
+    std::vector<char> data1(1 << 20);
+    for (std::size_t i = 0; i < data1.size(); i++)
+        data1[i] = static_cast<char>(i % 127);
+    std::vector<char> data2(1000, 'x');
+
+    writer.stagingBuffer() = data1;
+    CHECK(writer.submit(filename1) == 0);
+
+    // fill staging buffer while first file is being written
+    writer.stagingBuffer() = data2;
+    CHECK(writer.submit(filename2) == 0);
+
+    CHECK(writer.wait() == 0);
+    CHECK(!writer.busy());
+
+    CHECK(readFile(filename1) == data1);
+    CHECK(readFile(filename2) == data2);
+
+    std::remove(filename1.c_str());
+    std::remove(filename2.c_str());
+
+    // failure is reported at next fence
+    writer.stagingBuffer() = data2;
+    CHECK(writer.submit("nonexistent_dir/testAsyncFileWriter.dat") == 0);
+    CHECK(writer.wait() < 0);
+}
@@ -0,0 +1,162 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "BlacsContext.h"
+#include "DistMatrix.h"
+#include "MGmol_MPI.h"
+#include "Timer.h"
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// symmetric matrix with diagonal i+1 and slowly decaying
+// off-diagonal elements
+static void setMatrix(dist_matrix::DistMatrix<double>& a)
+{
+    for (int j = 0; j < a.nloc(); j++)
+    {
+        const int jg = a.indxl2gcol(j);
+        for (int i = 0; i < a.mloc(); i++)
+        {
+            const int ig = a.indxl2grow(i);
+            double val   = 0.1 / (1. + std::abs(ig - jg));
+            if (ig == jg) val += ig + 1.;
+            a.setval(i + j * a.mloc(), val);
+        }
+    }
+}
+
+// sum over columns j of z_j^T*a*z_j
+static double traceZtAZ(const dist_matrix::DistMatrix<double>& a,
+    const dist_matrix::DistMatrix<double>& z)
+{
+    dist_matrix::DistMatrix<double> az(z);
+    az.gemm('n', 'n', 1., a, z, 0.);
+    return z.sumProdElements(az);
+}
+
+TEST_CASE("Check DistMatrix eigensolvers", "[dist_matrix_eigensolvers]")
+{
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+
+    int nprow = 2;
+    int npcol = 2;
+    dist_matrix::BlacsContext bc(MPI_COMM_WORLD, nprow, npcol);
+
+    const int n   = 101;
+    const int nb  = 8;
+    const int nev = 30;
+
+    dist_matrix::DistMatrix<double> a("A", bc, n, n, nb, nb);
+    setMatrix(a);
+
+    // reference: QR algorithm
+    std::vector<double> wref(n);
+    {
+        dist_matrix::DistMatrix<double>::setEigensolver('q');
+        dist_matrix::DistMatrix<double> work(a);
+        dist_matrix::DistMatrix<double> z("Z", bc, n, n, nb, nb);
+        work.syev('v', 'l', wref, z);
+    }
+    double sumref = 0.;
+    for (int i = 0; i < nev; i++)
+        sumref += wref[i];
+
+    const double tol = 1.e-10;
+    for (const char algo : { 'd', 'r' })
+    {
+        dist_matrix::DistMatrix<double>::setEigensolver(algo);
+
+        // full spectrum
+        {
+            std::vector<double> w(n);
+            dist_matrix::DistMatrix<double> work(a);
+            dist_matrix::DistMatrix<double> z("Z", bc, n, n, nb, nb);
+            work.syev('v', 'l', w, z);
+            for (int i = 0; i < n; i++)
+                CHECK(w[i] == Approx(wref[i]).epsilon(tol));
+        }
+
+        // lowest nev eigenpairs
+        {
+            std::vector<double> w(n);
+            dist_matrix::DistMatrix<double> work(a);
+            dist_matrix::DistMatrix<double> z("Z", bc, n, n, nb, nb);
+            const int neig = work.syev('v', 'l', nev, w, z);
+            CHECK(neig >= nev);
+            for (int i = 0; i < nev; i++)
+                CHECK(w[i] == Approx(wref[i]).epsilon(tol));
+
+            // eigenvectors: trace over first nev columns
+            dist_matrix::DistMatrix<double> zev("Zev", bc, n, n, nb, nb);
+            zev.getsub(z, n, nev, 0, 0);
+            CHECK(traceZtAZ(a, zev) == Approx(sumref).epsilon(tol));
+        }
+    }
+
+    dist_matrix::DistMatrix<double>::setEigensolver('q');
+}
+
+// Timings of the various eigensolvers for large matrices
+// (hidden test, run with: testDistMatrixEigensolvers "[.eigensolvers_bench]")
+TEST_CASE("Benchmark DistMatrix eigensolvers", "[.eigensolvers_bench]")
+{
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+
+    int nprow = 2;
+    int npcol = 2;
+    dist_matrix::BlacsContext bc(MPI_COMM_WORLD, nprow, npcol);
+
+    const int nb = 64;
+
+    for (const int n : { 1000, 2000, 5000, 10000, 20000 })
+    {
+        dist_matrix::DistMatrix<double> a("A", bc, n, n, nb, nb);
+        setMatrix(a);
+        std::vector<double> w(n);
+
+        // occupied + empty states window typical of DFT calculations
+        const int nev = n / 2 + n / 20;
+
+        Timer qr_tm("syev QR, n=" + std::to_string(n));
+        Timer dc_tm("syev DivideAndConquer, n=" + std::to_string(n));
+        Timer mrrr_tm("syev MRRR, n=" + std::to_string(n));
+        Timer mrrr_partial_tm("syev MRRR partial, n=" + std::to_string(n));
+
+        for (const char algo : { 'q', 'd', 'r' })
+        {
+            dist_matrix::DistMatrix<double>::setEigensolver(algo);
+            dist_matrix::DistMatrix<double> work(a);
+            dist_matrix::DistMatrix<double> z("Z", bc, n, n, nb, nb);
+
+            Timer& tm
+                = (algo == 'q') ? qr_tm : ((algo == 'd') ? dc_tm : mrrr_tm);
+            tm.start();
+            work.syev('v', 'l', w, z);
+            tm.stop();
+        }
+        {
+            dist_matrix::DistMatrix<double> work(a);
+            dist_matrix::DistMatrix<double> z("Z", bc, n, n, nb, nb);
+            mrrr_partial_tm.start();
+            work.syev('v', 'l', nev, w, z);
+            mrrr_partial_tm.stop();
+        }
+
+        qr_tm.print(std::cout);
+        dc_tm.print(std::cout);
+        mrrr_tm.print(std::cout);
+        mrrr_partial_tm.print(std::cout);
+    }
+
+    dist_matrix::DistMatrix<double>::setEigensolver('q');
+}
@@ -13,6 +13,12 @@
 #include "stdlib.h"
 #include <mpi.h>
 
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
 #define H5FILE_NAME "SDS_chnk.h5"
 #define DATASETNAME "IntArray"
 #define NX 8 /* dataset dimensions */
@@ -155,3 +161,161 @@ TEST_CASE("Check HDF5P", "[hdf5]")
     H5Pclose(plist_id);
     H5Fclose(file_id);
 }
+
+// Write/read bandwidth for 3D mesh functions distributed over a processor
+// grid, each task owning one block of the global mesh.
+// Compare layouts used for restart files: contiguous dataset with
+// independent I/O, chunks aligned with task blocks with collective I/O,
+// and chunks with shuffle+deflate filters.
+// Increase BENCH_N to benchmark realistic restart file sizes.
+#define BENCH_N 32 /* local block dimension */
+#define BENCH_NFUNCS 8 /* number of datasets written in each file */
+
+namespace
+{
+double writeReadFile(const std::string& filename, const bool chunked,
+    const bool collective, const int compression, double& read_time)
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+    int mpi_size, mpi_rank;
+    MPI_Comm_size(comm, &mpi_size);
+    MPI_Comm_rank(comm, &mpi_rank);
+
+    // processor grid: mpi_size x 1 x 1
+    hsize_t block[3]  = { BENCH_N, BENCH_N, BENCH_N };
+    hsize_t dimsf[3]  = { mpi_size * block[0], block[1], block[2] };
+    hsize_t offset[3] = { mpi_rank * block[0], 0, 0 };
+    hsize_t count[3]  = { 1, 1, 1 };
+    hsize_t stride[3] = { 1, 1, 1 };
+
+    // smooth function, similar to orbitals
+    const int n = BENCH_N * BENCH_N * BENCH_N;
+    std::vector<double> data(n);
+    for (int i = 0; i < n; i++)
+        data[i] = std::exp(-0.001 * (i % 1000)) * std::cos(0.01 * i);
+
+    MPI_Info info;
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "romio_cb_write", "enable");
+    MPI_Info_set(info, "romio_cb_read", "enable");
+
+    hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+    H5Pset_fapl_mpio(fapl_id, comm, info);
+
+    hid_t dcpl_id = H5P_DEFAULT;
+    if (chunked)
+    {
+        dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(dcpl_id, 3, block);
+        if (compression == 2) H5Pset_shuffle(dcpl_id);
+        if (compression > 0) H5Pset_deflate(dcpl_id, 1);
+    }
+
+    hid_t dxpl_id = H5Pcreate(H5P_DATASET_XFER);
+    if (collective) H5Pset_dxpl_mpio(dxpl_id, H5FD_MPIO_COLLECTIVE);
+
+    hid_t memspace = H5Screate_simple(3, block, nullptr);
+
+    // write
+    MPI_Barrier(comm);
+    double t0 = MPI_Wtime();
+
+    hid_t file_id = H5Fcreate(
+        filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, fapl_id);
+    CHECK(file_id >= 0);
+    for (int f = 0; f < BENCH_NFUNCS; f++)
+    {
+        std::string name("Function" + std::to_string(f));
+        hid_t filespace = H5Screate_simple(3, dimsf, nullptr);
+        hid_t dset_id   = H5Dcreate2(file_id, name.c_str(),
+            H5T_NATIVE_DOUBLE, filespace, H5P_DEFAULT, dcpl_id, H5P_DEFAULT);
+        H5Sselect_hyperslab(
+            filespace, H5S_SELECT_SET, offset, stride, count, block);
+        herr_t status = H5Dwrite(dset_id, H5T_NATIVE_DOUBLE, memspace,
+            filespace, dxpl_id, data.data());
+        CHECK(status >= 0);
+        H5Dclose(dset_id);
+        H5Sclose(filespace);
+    }
+    H5Fclose(file_id);
+
+    MPI_Barrier(comm);
+    const double write_time = MPI_Wtime() - t0;
+
+    // read
+    t0      = MPI_Wtime();
+    file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, fapl_id);
+    CHECK(file_id >= 0);
+    std::vector<double> readback(n);
+    for (int f = 0; f < BENCH_NFUNCS; f++)
+    {
+        std::string name("Function" + std::to_string(f));
+        hid_t dset_id   = H5Dopen2(file_id, name.c_str(), H5P_DEFAULT);
+        hid_t filespace = H5Dget_space(dset_id);
+        H5Sselect_hyperslab(
+            filespace, H5S_SELECT_SET, offset, stride, count, block);
+        herr_t status = H5Dread(dset_id, H5T_NATIVE_DOUBLE, memspace,
+            filespace, dxpl_id, readback.data());
+        CHECK(status >= 0);
+        H5Dclose(dset_id);
+        H5Sclose(filespace);
+    }
+    H5Fclose(file_id);
+
+    MPI_Barrier(comm);
+    read_time = MPI_Wtime() - t0;
+
+    CHECK(readback == data);
+
+    H5Sclose(memspace);
+    H5Pclose(dxpl_id);
+    if (dcpl_id != H5P_DEFAULT) H5Pclose(dcpl_id);
+    H5Pclose(fapl_id);
+    MPI_Info_free(&info);
+
+    return write_time;
+}
+}
+
+TEST_CASE("HDF5P restart layouts bandwidth", "[hdf5]")
+{
+    int mpi_size, mpi_rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+
+    const double mbytes = static_cast<double>(BENCH_NFUNCS) * mpi_size
+                          * BENCH_N * BENCH_N * BENCH_N * sizeof(double)
+                          / (1024. * 1024.);
+
+    struct Layout
+    {
+        std::string name;
+        bool chunked;
+        bool collective;
+        int compression;
+    };
+    std::vector<Layout> layouts;
+    layouts.push_back({ "contiguous/independent", false, false, 0 });
+    layouts.push_back({ "chunked/collective", true, true, 0 });
+#if H5_VERSION_GE(1, 10, 2)
+    // parallel writes of filtered datasets require HDF5>=1.10.2
+    layouts.push_back({ "chunked/collective/shuffle+deflate", true, true, 2 });
+#endif
+
+    for (auto& layout : layouts)
+    {
+        const std::string filename("testHDF5Pbandwidth.h5");
+        double read_time        = 0.;
+        const double write_time = writeReadFile(filename, layout.chunked,
+            layout.collective, layout.compression, read_time);
+
+        if (mpi_rank == 0)
+        {
+            std::cout << layout.name << ": write " << mbytes / write_time
+                      << " MB/s, read " << mbytes / read_time << " MB/s"
+                      << std::endl;
+            std::remove(filename.c_str());
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+}
@@ -1,10 +1,105 @@
 #include "Control.h"
+#include "IonCellList.h"
 #include "Ions.h"
 #include "MGmol_MPI.h"
 #include "Mesh.h"
 #include "Species.h"
+#include "Timer.h"
 
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
 #include <random>
+#include <string>
+
+// short-range pair energy, as in Species::ediff()
+static double pairEnergy(const double r)
+{
+    const double zion = 4.;
+    const double rc   = 1.;
+    return zion * zion * erfc(r / (M_SQRT2 * rc)) / r;
+}
+
+static double minimage(
+    const std::vector<double>& x, const int i, const int j, const double ll)
+{
+    double r2 = 0.;
+    for (short d = 0; d < 3; d++)
+    {
+        double dx = x[3 * i + d] - x[3 * j + d];
+        dx -= ll * std::round(dx / ll);
+        r2 += dx * dx;
+    }
+    return std::sqrt(r2);
+}
+
+// Compare short-range pair energy computed over all pairs and with
+// a cell list, for random atoms in a periodic box at constant density,
+// for numbers of atoms from 1000 to max_natoms.
+// Returns number of errors.
+static int benchmarkCellList(const int max_natoms)
+{
+    const double density = 0.1; // atoms/bohr^3
+    const double cutoff  = 6. * M_SQRT2;
+    const short bc[3]    = { 1, 1, 1 };
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<> dis(0.0, 1.0);
+
+    int nerrors = 0;
+    for (int natoms = 1000; natoms <= max_natoms; natoms *= 10)
+    {
+        const double ll         = std::cbrt(natoms / density);
+        const double lattice[3] = { ll, ll, ll };
+
+        std::vector<double> x(3 * natoms);
+        for (auto& v : x)
+            v = ll * dis(gen);
+
+        Timer cells_tm("cell list, natoms = " + std::to_string(natoms));
+        cells_tm.start();
+        IonCellList cells(x, lattice, bc, cutoff);
+        std::vector<int> neighbors;
+        double ecells = 0.;
+        for (int i = 0; i < natoms; i++)
+        {
+            cells.getNeighbors(&x[3 * i], neighbors);
+            for (auto j : neighbors)
+            {
+                if (j == i) continue;
+                const double r = minimage(x, i, j, ll);
+                if (r < cutoff) ecells += pairEnergy(r);
+            }
+        }
+        cells_tm.stop();
+
+        cells_tm.print(std::cout);
+
+        // all pairs (quadratic cost), for smaller sizes only
+        if (natoms <= 10000)
+        {
+            Timer allpairs_tm(
+                "all pairs, natoms = " + std::to_string(natoms));
+            allpairs_tm.start();
+            double eall = 0.;
+            for (int i = 0; i < natoms; i++)
+                for (int j = 0; j < natoms; j++)
+                    if (j != i) eall += pairEnergy(minimage(x, i, j, ll));
+            allpairs_tm.stop();
+
+            allpairs_tm.print(std::cout);
+            if (std::abs(ecells - eall) > 1.e-10 * std::abs(eall))
+            {
+                std::cerr << "Cell list energy " << ecells
+                          << " differs from all pairs energy " << eall
+                          << std::endl;
+                nerrors++;
+            }
+        }
+    }
+
+    return nerrors;
+}
 
 int main(int argc, char** argv)
 {
@@ -87,6 +182,20 @@ int main(int argc, char** argv)
 
     int ntotal = 0;
     MPI_Allreduce(&nlocal, &ntotal, 1, MPI_INT, MPI_SUM, comm);
+
+    // compare ion-ion energy with sum over all pairs
+    const short bc[3]  = { 1, 1, 1 };
+    const double ediff = ions.energyDiff(bc);
+    double ediff_ref   = 0.;
+    for (auto ion1 : ions.list_ions())
+        for (auto ion2 : ions.list_ions())
+            if (ion1 != ion2)
+                ediff_ref += 0.5 * ion1->energyDiff(*ion2, lattice, bc);
+
+    // optional max. number of atoms for cell list benchmark
+    const int max_natoms = argc > 2 ? std::atoi(argv[2]) : 1000;
+    const int nerrors    = benchmarkCellList(max_natoms);
+
     mpirc = MPI_Finalize();
     if (mpirc != MPI_SUCCESS)
     {
@@ -100,5 +209,14 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    if (std::abs(ediff - ediff_ref) > 1.e-10 * std::abs(ediff_ref))
+    {
+        std::cout << "energyDiff = " << ediff << ", expected " << ediff_ref
+                  << std::endl;
+        return 1;
+    }
+
+    if (nerrors > 0) return 1;
+
     return 0;
 }
@@ -0,0 +1,173 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+
+#include "Control.h"
+#include "Ion.h"
+#include "KBprojector.h"
+#include "MGmol_MPI.h"
+#include "Mesh.h"
+#include "Species.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compare batched (dotPsiBatch, axpyKetBatch) and per-projector
+// (dotPsi, axpyKet) applications of the KB projectors of one ion,
+// for several random functions in each subdomain.
+// Returns number of errors.
+static int compareBatchAndPerProjector(
+    KBprojector& kbproj, const int numpt, const int subdivx)
+{
+    const int ncols    = 5;
+    const short nprojs = kbproj.nProjectors();
+    const double tol   = 1.e-5;
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+
+    std::vector<std::vector<ORBDTYPE>> psi(ncols);
+    for (auto& p : psi)
+    {
+        p.resize(numpt);
+        for (auto& v : p)
+            v = dis(gen);
+    }
+
+    int nerrors      = 0;
+    int noverlapping = 0;
+    for (short iloc = 0; iloc < subdivx; iloc++)
+    {
+        if (!kbproj.overlaps(iloc)) continue;
+        noverlapping++;
+
+        // <proj_i|psi_j>
+        std::vector<const ORBDTYPE*> cpsi;
+        for (auto& p : psi)
+            cpsi.push_back(p.data());
+        std::vector<double> vals;
+        kbproj.dotPsiBatch(iloc, cpsi, vals);
+        for (int j = 0; j < ncols; j++)
+        {
+            kbproj.registerPsi(iloc, psi[j].data());
+            for (short i = 0; i < nprojs; i++)
+            {
+                const double ref = kbproj.dotPsi(iloc, i);
+                if (std::abs(vals[i + nprojs * j] - ref)
+                    > tol * (1. + std::abs(ref)))
+                {
+                    std::cerr << "dotPsiBatch: iloc=" << iloc << ", i=" << i
+                              << ", j=" << j << ", " << vals[i + nprojs * j]
+                              << " instead of " << ref << std::endl;
+                    nerrors++;
+                }
+            }
+        }
+
+        // psi_j += sum_i alpha_ij proj_i
+        std::vector<double> alpha(nprojs * ncols);
+        for (auto& a : alpha)
+            a = dis(gen);
+
+        std::vector<std::vector<ORBDTYPE>> dst(psi);
+        std::vector<ORBDTYPE*> pdst;
+        for (auto& d : dst)
+            pdst.push_back(d.data());
+        kbproj.axpyKetBatch(iloc, alpha, pdst);
+
+        std::vector<std::vector<ORBDTYPE>> dst_ref(psi);
+        for (int j = 0; j < ncols; j++)
+        {
+            std::vector<double> alphaj(
+                alpha.begin() + nprojs * j, alpha.begin() + nprojs * (j + 1));
+            kbproj.axpyKet(iloc, alphaj, dst_ref[j].data());
+
+            for (int k = 0; k < numpt; k++)
+                if (std::abs(dst[j][k] - dst_ref[j][k])
+                    > tol * (1. + std::abs(dst_ref[j][k])))
+                {
+                    std::cerr << "axpyKetBatch: iloc=" << iloc << ", j=" << j
+                              << ", k=" << k << ", " << dst[j][k]
+                              << " instead of " << dst_ref[j][k] << std::endl;
+                    nerrors++;
+                }
+        }
+    }
+
+    std::cout << "Projector overlaps " << noverlapping << " of " << subdivx
+              << " subdomains" << std::endl;
+    if (noverlapping == 0)
+    {
+        std::cerr << "Projector does not overlap any subdomain" << std::endl;
+        nerrors++;
+    }
+
+    return nerrors;
+}
+
+int main(int argc, char** argv)
+{
+    int mpirc = MPI_Init(&argc, &argv);
+
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    MGmol_MPI::setup(comm, std::cout);
+    Control::setup(comm, false, 0.);
+
+    // create a domain [0.16.]^3
+    const double origin[3]  = { 0., 0., 0. };
+    const double ll         = 16.;
+    const double lattice[3] = { ll, ll, ll };
+    const unsigned ngpts[3] = { 64, 48, 48 };
+    short lap_type          = 0;
+
+    Mesh::setup(comm, ngpts, origin, lattice, lap_type);
+
+    // split mesh into several subdomains along x
+    Mesh* mymesh = Mesh::instance();
+    mymesh->subdivGridx(1);
+    const int subdivx = mymesh->subdivx();
+    const int numpt   = mymesh->grid().size();
+
+    const double h[3] = { ll / (double(ngpts[0])), ll / (double(ngpts[1])),
+        ll / (double(ngpts[2])) };
+
+    // read species info from pseudopotential file
+    Species sp(MPI_COMM_WORLD);
+    std::string file_path = argv[1];
+    std::string filename(file_path + "/pseudo.C_ONCV_PBE_SG15");
+    std::cout << "Potential = " << filename << std::endl;
+
+    sp.read_1species(filename);
+    sp.set_dim_nl(h[0]);
+    sp.set_dim_l(h[0]);
+    sp.initPotentials('f', h[0], true);
+
+    // one atom, straddling several subdomains
+    double x[3]        = { 0.5 * ll + 0.1, 0.5 * ll - 0.2, 0.5 * ll + 0.3 };
+    double velocity[3] = { 0., 0., 0. };
+    Ion ion(sp, "C0", x, velocity, false);
+    ion.setup();
+
+    const int nerrors
+        = compareBatchAndPerProjector(*ion.kbproj(), numpt, subdivx);
+
+    mpirc = MPI_Finalize();
+    if (mpirc != MPI_SUCCESS)
+    {
+        std::cerr << "MPI Finalize failed!!!" << std::endl;
+        return 1;
+    }
+
+    if (nerrors > 0) return 1;
+
+    return 0;
+}
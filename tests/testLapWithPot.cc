@@ -0,0 +1,205 @@
+#include "GridFunc.h"
+#include "GridFuncVector.h"
+#include "Laph2.h"
+#include "Laph4.h"
+#include "Laph4M.h"
+#include "Laph6.h"
+#include "Laph8.h"
+#include "MGmol_MPI.h"
+#include "PEenv.h"
+#include "Timer.h"
+
+#include "catch.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+const int ntimes = 10;
+
+// Compare fused evaluation of -Lap*phi+V*phi with the sequence
+// of separate sweeps it replaces, and time both
+template <class LapType>
+void checkApplyWithPot(LapType& lap, const pb::Grid& grid, const bool mehr)
+{
+    const int numpt = grid.size();
+
+    std::mt19937 gen(1234 + grid.mype_env().mytask());
+    std::uniform_real_distribution<> dis(-1., 1.);
+
+    std::vector<double> phi(numpt);
+    std::vector<double> pot(numpt);
+    for (auto& v : phi)
+        v = dis(gen);
+    for (auto& v : pot)
+        v = dis(gen);
+
+    // periodic GridFunc
+    pb::GridFunc<double> gfphi(grid, 1, 1, 1);
+    gfphi.assign(phi.data());
+    gfphi.trade_boundaries();
+
+    pb::GridFunc<double> gfpot(grid, 1, 1, 1);
+    gfpot.assign(pot.data());
+    gfpot.trade_boundaries();
+
+    Timer unfused_tm("unfused " + lap.name());
+    Timer fused_tm("fused " + lap.name());
+
+    pb::GridFunc<double> gfw1(grid, 1, 1, 1);
+    pb::GridFunc<double> gfw2(grid, 1, 1, 1);
+    std::vector<double> expected(numpt);
+    std::vector<double> work(numpt);
+    for (int it = 0; it < ntimes; it++)
+    {
+        unfused_tm.start();
+        if (mehr)
+        {
+            // B*(V*phi)
+            gfw1.prod(gfphi, gfpot);
+            lap.rhs(gfw1, expected.data());
+        }
+        else
+        {
+            for (int i = 0; i < numpt; i++)
+                expected[i] = pot[i] * phi[i];
+        }
+        // -Lap*phi
+        lap.apply(gfphi, gfw2);
+        gfw2.init_vect(work.data(), 'd');
+        for (int i = 0; i < numpt; i++)
+            expected[i] += work[i];
+        unfused_tm.stop();
+    }
+
+    std::vector<double> result(numpt);
+    for (int it = 0; it < ntimes; it++)
+    {
+        fused_tm.start();
+        if (mehr)
+            lap.applyWithPot(gfphi, gfpot, result.data());
+        else
+            lap.applyWithPot(gfphi, pot.data(), result.data());
+        fused_tm.stop();
+    }
+
+    for (int i = 0; i < numpt; i++)
+        CHECK(result[i] == Approx(expected[i]).epsilon(1.e-12).margin(1.e-8));
+
+    // same result when splitting the subdomain in interior and shell
+    std::vector<double> result_split(numpt, 0.);
+    for (auto region :
+        { pb::StencilRegion::Interior, pb::StencilRegion::Shell })
+    {
+        if (mehr)
+            lap.applyWithPot(gfphi, gfpot, result_split.data(), region);
+        else
+            lap.applyWithPot(gfphi, pot.data(), result_split.data(), region);
+    }
+    for (int i = 0; i < numpt; i++)
+        CHECK(result_split[i] == Approx(result[i]).epsilon(1.e-14));
+
+    unfused_tm.print(std::cout);
+    fused_tm.print(std::cout);
+}
+}
+
+TEST_CASE("Fused Laplacian plus potential", "[lap_with_pot]")
+{
+    const double origin[3]  = { 0., 0., 0. };
+    const double ll         = 2.;
+    const double lattice[3] = { ll, ll, ll };
+    const unsigned ngpts[3] = { 48, 40, 32 };
+    const short nghosts     = 4;
+
+    pb::PEenv mype_env(MPI_COMM_WORLD, ngpts[0], ngpts[1], ngpts[2]);
+    pb::Grid grid(origin, lattice, ngpts, mype_env, nghosts, 0);
+
+    SECTION("Laph2")
+    {
+        pb::Laph2<double> lap(grid);
+        checkApplyWithPot(lap, grid, false);
+    }
+    SECTION("Laph4")
+    {
+        pb::Laph4<double> lap(grid);
+        checkApplyWithPot(lap, grid, false);
+    }
+    SECTION("Laph4M")
+    {
+        pb::Laph4M<double> lap(grid);
+        checkApplyWithPot(lap, grid, true);
+    }
+    SECTION("Laph6")
+    {
+        pb::Laph6<double> lap(grid);
+        checkApplyWithPot(lap, grid, false);
+    }
+    SECTION("Laph8")
+    {
+        pb::Laph8<double> lap(grid);
+        checkApplyWithPot(lap, grid, false);
+    }
+}
+
+TEST_CASE("Laplacian with overlapped ghost values exchange", "[lap_overlap]")
+{
+    const double origin[3]  = { 0., 0., 0. };
+    const double ll         = 2.;
+    const double lattice[3] = { ll, ll, ll };
+    const unsigned ngpts[3] = { 32, 24, 40 };
+    const short nghosts     = 4;
+    const int nfunc         = 6;
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+
+    pb::PEenv mype_env(MPI_COMM_WORLD, ngpts[0], ngpts[1], ngpts[2]);
+    pb::Grid grid(origin, lattice, ngpts, mype_env, nghosts, 0);
+
+    std::vector<std::vector<int>> gids(1);
+    for (int i = 0; i < nfunc; i++)
+        gids[0].push_back(i);
+
+    std::mt19937 gen(4321 + mype_env.mytask());
+    std::uniform_real_distribution<> dis(-1., 1.);
+    std::vector<double> data(grid.size());
+
+    // 0: Mehrstellen, 1 to 4: 2nd to 8th order
+    for (short lap_type = 0; lap_type < 5; lap_type++)
+    {
+        // Mehrstellen needs ghost values in edges and corners
+        const bool skinny = (lap_type > 0);
+        pb::GridFuncVector<double> gfv(grid, 1, 1, 1, gids, skinny);
+        pb::GridFuncVector<double> gfv_ref(grid, 1, 1, 1, gids, skinny);
+        pb::GridFuncVector<double> gfv_overlap(grid, 1, 1, 1, gids, skinny);
+
+        for (int i = 0; i < nfunc; i++)
+        {
+            for (auto& v : data)
+                v = dis(gen);
+            gfv.assign(i, data.data());
+        }
+
+        pb::GridFuncVector<double>::setOverlapComm(false);
+        gfv.applyLap(lap_type, gfv_ref);
+
+        gfv.set_updated_boundaries(false);
+        pb::GridFuncVector<double>::setOverlapComm(true);
+        gfv.applyLap(lap_type, gfv_overlap);
+        CHECK(gfv.updated_boundaries());
+
+        INFO("Laplacian type " << lap_type);
+        for (int i = 0; i < nfunc; i++)
+        {
+            std::vector<double> ref(grid.size());
+            std::vector<double> val(grid.size());
+            gfv_ref.init_vect(i, ref.data(), 'd');
+            gfv_overlap.init_vect(i, val.data(), 'd');
+            for (unsigned j = 0; j < grid.size(); j++)
+                CHECK(val[j] == Approx(ref[j]).epsilon(1.e-12).margin(1.e-10));
+        }
+    }
+    pb::GridFuncVector<double>::setOverlapComm(false);
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "LocalMatrices.h"
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Compare the block-sparse local product used for localized orbitals with
+// the dense one, for a right-hand side b (H*phi for instance) with nonzero
+// columns for colors which have no data in the subdomain.
+TEST_CASE("Sparse local product a^T*b with b extending past mask",
+    "[local_product_sparse]")
+{
+    const int numpt   = 200;
+    const int lda     = numpt + 3;
+    const int ncolors = 10;
+    const double vel  = 0.3;
+
+    // colors with data in subdomain
+    const std::vector<int> active = { 1, 2, 5, 8 };
+
+    std::mt19937 gen(1234);
+    std::uniform_real_distribution<> dis(-1., 1.);
+
+    // a: zero for inactive colors
+    std::vector<double> a(lda * ncolors, 0.);
+    for (auto color : active)
+        for (int i = 0; i < numpt; i++)
+            a[color * lda + i] = dis(gen);
+
+    // b: nonzero everywhere
+    std::vector<double> b(lda * ncolors);
+    for (auto& v : b)
+        v = dis(gen);
+
+    LocalMatrices<double, MemorySpace::Host> dense(1, ncolors, ncolors);
+    dense.gemm(0, numpt, a.data(), lda, b.data(), lda);
+    dense.scal(vel);
+
+    LocalMatrices<double, MemorySpace::Host> sparse(1, ncolors, ncolors);
+    sparse.setValues(-1.);
+    sparse.gemmRows(0, numpt, active, vel, a.data(), lda, b.data(), lda);
+
+    for (int j = 0; j < ncolors; j++)
+        for (int i = 0; i < ncolors; i++)
+            CHECK(sparse.getVal(i, j)
+                  == Approx(dense.getVal(i, j)).margin(1.e-12));
+
+    // some entries associated with inactive colors in b are nonzero
+    CHECK(std::abs(sparse.getVal(active[0], 0)) > 1.e-8);
+}
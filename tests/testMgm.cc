@@ -0,0 +1,170 @@
+#include "GridFunc.h"
+#include "Laph4M.h"
+#include "MGmol_MPI.h"
+#include "Mgm.h"
+#include "PEenv.h"
+#include "Timer.h"
+
+#include "catch.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Solve a periodic Poisson problem with and without redistribution of
+// coarse multigrid levels onto fewer tasks, and compare solutions
+TEST_CASE("Multigrid with coarse levels agglomeration", "[mgm_agglomeration]")
+{
+    const double origin[3]  = { 0., 0., 0. };
+    const double ll         = 2.;
+    const double lattice[3] = { ll, ll, ll };
+    const unsigned ngpts[3] = { 64, 64, 64 };
+    const short nghosts     = 2;
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+
+    pb::PEenv mype_env(MPI_COMM_WORLD, ngpts[0], ngpts[1], ngpts[2]);
+    pb::Grid grid(origin, lattice, ngpts, mype_env, nghosts, 0);
+
+    const int numpt = grid.size();
+
+    std::mt19937 gen(5678 + mype_env.mytask());
+    std::uniform_real_distribution<> dis(-1., 1.);
+
+    std::vector<double> rho(numpt);
+    double sum = 0.;
+    for (auto& v : rho)
+    {
+        v = dis(gen);
+        sum += v;
+    }
+    // zero total charge for periodic problem
+    sum = mype_env.double_sum_all(sum) / grid.gsize();
+    for (auto& v : rho)
+        v -= sum;
+
+    pb::GridFunc<double> gfrho(grid, 1, 1, 1);
+    gfrho.assign(rho.data());
+
+    pb::Laph4M<double> lap(grid);
+
+    const short max_sweeps = 20;
+    const double tol       = 1.e-10;
+
+    std::vector<std::vector<double>> solutions;
+    std::vector<short> nb_sweeps;
+    for (const int min_points : { 0, numpt + 1 })
+    {
+        pb::VcycleControl::setAgglomerationMinPoints(min_points);
+
+        pb::GridFunc<double> gfvh(grid, 1, 1, 1);
+        double final_residual;
+        double final_relative_residual;
+        double residual_reduction;
+        short nsweeps;
+
+        Timer solve_tm("Mgm, agglomeration_min_points="
+                       + std::to_string(min_points));
+        solve_tm.start();
+        const bool converged = pb::Mgm(lap, gfvh, gfrho, 10, max_sweeps, tol,
+            2, 2, true, final_residual, final_relative_residual,
+            residual_reduction, nsweeps);
+        solve_tm.stop();
+        CHECK(converged);
+
+        gfvh.average0();
+        solutions.emplace_back(numpt);
+        gfvh.init_vect(solutions.back().data(), 'd');
+        nb_sweeps.push_back(nsweeps);
+
+        solve_tm.print(std::cout);
+    }
+    pb::VcycleControl::setAgglomerationMinPoints(0);
+
+    if (mype_env.n_mpi_tasks() > 1) CHECK(mype_env.agglomerate());
+
+    CHECK(nb_sweeps[0] == nb_sweeps[1]);
+    for (int i = 0; i < numpt; i++)
+        CHECK(solutions[1][i] == Approx(solutions[0][i]).margin(1.e-10));
+
+    pb::VcycleControl::printTimers(std::cout);
+}
+
+// Compare double precision solve with mixed precision solve using
+// single precision V-cycles
+TEST_CASE("Mixed precision multigrid", "[mgm_mixed_precision]")
+{
+    const double origin[3]  = { 0., 0., 0. };
+    const double ll         = 2.;
+    const double lattice[3] = { ll, ll, ll };
+    const unsigned ngpts[3] = { 64, 64, 64 };
+    const short nghosts     = 2;
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+
+    pb::PEenv mype_env(MPI_COMM_WORLD, ngpts[0], ngpts[1], ngpts[2]);
+    pb::Grid grid(origin, lattice, ngpts, mype_env, nghosts, 0);
+
+    const int numpt = grid.size();
+
+    std::mt19937 gen(6789 + mype_env.mytask());
+    std::uniform_real_distribution<> dis(-1., 1.);
+
+    std::vector<double> rho(numpt);
+    double sum = 0.;
+    for (auto& v : rho)
+    {
+        v = dis(gen);
+        sum += v;
+    }
+    sum = mype_env.double_sum_all(sum) / grid.gsize();
+    for (auto& v : rho)
+        v -= sum;
+
+    pb::GridFunc<double> gfrho(grid, 1, 1, 1);
+    gfrho.assign(rho.data());
+
+    pb::Laph4M<double> lap(grid);
+    pb::Laph4M<float> lap_float(grid);
+
+    const short max_sweeps = 20;
+    const double tol       = 1.e-10;
+
+    double final_residual;
+    double final_relative_residual;
+    double residual_reduction;
+    short nsweeps;
+
+    pb::GridFunc<double> gfvh(grid, 1, 1, 1);
+    Timer double_tm("Mgm, double");
+    double_tm.start();
+    bool converged = pb::Mgm(lap, gfvh, gfrho, 10, max_sweeps, tol, 2, 2,
+        true, final_residual, final_relative_residual, residual_reduction,
+        nsweeps);
+    double_tm.stop();
+    CHECK(converged);
+
+    pb::GridFunc<double> gfvh_mixed(grid, 1, 1, 1);
+    Timer mixed_tm("Mgm, mixed");
+    mixed_tm.start();
+    converged = pb::MgmMixedPrecision<float>(lap, lap_float, gfvh_mixed, gfrho,
+        10, max_sweeps, tol, 2, 2, true, final_residual,
+        final_relative_residual, residual_reduction, nsweeps);
+    mixed_tm.stop();
+    // same tolerance reached in double precision
+    CHECK(converged);
+    CHECK(final_relative_residual < tol);
+
+    gfvh.average0();
+    gfvh_mixed.average0();
+
+    std::vector<double> vh(numpt);
+    std::vector<double> vh_mixed(numpt);
+    gfvh.init_vect(vh.data(), 'd');
+    gfvh_mixed.init_vect(vh_mixed.data(), 'd');
+    for (int i = 0; i < numpt; i++)
+        CHECK(vh_mixed[i] == Approx(vh[i]).margin(1.e-8));
+
+    double_tm.print(std::cout);
+    mixed_tm.print(std::cout);
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "Profiler.h"
+#include "Timer.h"
+
+#include "catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static std::vector<std::string> readLines(const std::string& filename)
+{
+    std::vector<std::string> lines;
+    std::ifstream in(filename.c_str());
+    std::string line;
+    while (std::getline(in, line))
+        lines.push_back(line);
+    return lines;
+}
+
+static std::vector<std::string> splitCSV(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::stringstream ss(line);
+    std::string field;
+    while (std::getline(ss, field, ','))
+        fields.push_back(field);
+    return fields;
+}
+
+TEST_CASE("Check hierarchical profiler", "[profiler]")
+{
+    int mytask, ntasks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mytask);
+    MPI_Comm_size(MPI_COMM_WORLD, &ntasks);
+
+    Timer outer_tm("outer");
+    Timer inner_tm("inner");
+    Timer other_tm("other");
+
+    Profiler& profiler = Profiler::instance();
+    profiler.reset();
+    profiler.enable();
+
+    const int nsteps = 3;
+    for (int step = 0; step < nsteps; step++)
+    {
+        ProfilerStep profiler_step("SCF step", step);
+
+        outer_tm.start();
+        Profiler::addCollectiveBytes(8.);
+
+        // same timer called in two different contexts
+        inner_tm.start();
+        Profiler::addHaloBytes(100.);
+        inner_tm.stop();
+
+        other_tm.start();
+        inner_tm.start();
+        inner_tm.stop();
+        other_tm.stop();
+
+        outer_tm.stop();
+    }
+
+    // region opened only on task 0
+    if (mytask == 0)
+    {
+        other_tm.start();
+        other_tm.stop();
+    }
+
+    const std::string prefix("testProfiler");
+    profiler.write(prefix, MPI_COMM_WORLD);
+    profiler.disable();
+
+    if (mytask == 0)
+    {
+        std::vector<std::string> lines(readLines(prefix + ".csv"));
+        // header + 6 regions in tree order
+        REQUIRE(lines.size() == 7);
+        CHECK(lines[1].find("\"SCF step\",0,3,3,3") == 0);
+        CHECK(lines[2].find("\"SCF step/outer\",1,3,3,3") == 0);
+        CHECK(lines[3].find("\"SCF step/outer/inner\",2,3,3,3") == 0);
+        CHECK(lines[4].find("\"SCF step/outer/other\",2,3,3,3") == 0);
+        CHECK(lines[5].find("\"SCF step/outer/other/inner\",3,3,3,3") == 0);
+        // min number of calls over tasks
+        CHECK(lines[6].find(ntasks > 1 ? "\"other\",0,0," : "\"other\",0,1,")
+              == 0);
+
+        // bytes attributed to regions active when they are counted
+        std::vector<std::string> outer(splitCSV(lines[2]));
+        REQUIRE(outer.size() == 14);
+        CHECK(std::stod(outer[10]) == 0.);
+        CHECK(std::stod(outer[13]) == 24.);
+        std::vector<std::string> inner(splitCSV(lines[3]));
+        REQUIRE(inner.size() == 14);
+        CHECK(std::stod(inner[10]) == 300.);
+        CHECK(std::stod(inner[13]) == 0.);
+
+        std::vector<std::string> steps(readLines(prefix + "_steps.csv"));
+        REQUIRE(steps.size() == nsteps + 1);
+        CHECK(steps[3].find("\"SCF step\",2,") == 0);
+
+        std::vector<std::string> json(readLines(prefix + ".json"));
+        CHECK(json.size() > 8);
+        CHECK(json[0] == "{");
+        CHECK(json.back() == "}");
+
+        std::remove((prefix + ".csv").c_str());
+        std::remove((prefix + "_steps.csv").c_str());
+        std::remove((prefix + ".json").c_str());
+    }
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "RadialInter.h"
+#include "Timer.h"
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Compare batched and scalar interpolations of a radial function
+// on a uniform mesh, for radii in and out of the mesh range
+TEST_CASE("Batched radial interpolation", "[radial_inter]")
+{
+    const int nmesh   = 800;
+    const double dr   = 0.01;
+    const int npoints = 20000;
+    const int ntimes  = 50;
+
+    std::vector<double> xmesh(nmesh);
+    std::vector<double> ymesh(nmesh);
+    for (int i = 0; i < nmesh; i++)
+    {
+        xmesh[i] = i * dr;
+        ymesh[i] = std::exp(-xmesh[i] * xmesh[i]) * std::cos(xmesh[i]);
+    }
+    RadialInter func;
+    func.assign(xmesh, ymesh);
+
+    std::mt19937 gen(2345);
+    std::uniform_real_distribution<> dis(0., 1.1 * nmesh * dr);
+    std::vector<double> r(npoints);
+    for (auto& v : r)
+        v = dis(gen);
+    // radii in first interval and at the end of the mesh
+    r[0] = 0.;
+    r[1] = 0.5 * dr;
+    r[2] = (nmesh - 3) * dr;
+    r[3] = (nmesh - 1) * dr;
+
+    std::vector<double> val_ref(npoints);
+    std::vector<double> val(npoints);
+    std::vector<double> dval(npoints);
+
+    Timer scalar_tm("RadialInter::cubint scalar");
+    Timer batch_tm("RadialInter::cubint batch");
+
+    for (int it = 0; it < ntimes; it++)
+    {
+        scalar_tm.start();
+        for (int i = 0; i < npoints; i++)
+            val_ref[i] = func.cubint(r[i]);
+        scalar_tm.stop();
+
+        batch_tm.start();
+        func.cubint(npoints, r.data(), val.data());
+        batch_tm.stop();
+    }
+
+    // same formula as scalar version (up to FMA contractions)
+    for (int i = 0; i < npoints; i++)
+        CHECK(val[i] == Approx(val_ref[i]).margin(1.e-14));
+
+    // values and derivatives
+    func.cubint(npoints, r.data(), val.data(), dval.data());
+    const double delta = 1.e-6;
+    for (int i = 0; i < npoints; i++)
+    {
+        CHECK(val[i] == Approx(val_ref[i]).margin(1.e-14));
+
+        // compare derivative with finite differences away from
+        // interval boundaries, where cubic interpolation is smooth
+        const double t = r[i] / dr - std::floor(r[i] / dr);
+        if (r[i] > dr && r[i] < (nmesh - 4) * dr && t > 0.01 && t < 0.99)
+        {
+            const double fd
+                = (func.cubint(r[i] + delta) - func.cubint(r[i] - delta))
+                  / (2. * delta);
+            CHECK(dval[i] == Approx(fd).margin(1.e-6));
+        }
+    }
+
+    // linear interpolation inside mesh range
+    std::vector<double> rlin;
+    for (auto v : r)
+        if (v < (nmesh - 1) * dr) rlin.push_back(v);
+    std::vector<double> vlin(rlin.size());
+    func.linint(rlin.size(), rlin.data(), vlin.data());
+    for (unsigned int i = 0; i < rlin.size(); i++)
+        CHECK(vlin[i] == Approx(func.linint(rlin[i])).margin(1.e-14));
+
+    std::cout << "npoints=" << npoints << ", " << ntimes << " calls"
+              << std::endl;
+    scalar_tm.print(std::cout);
+    batch_tm.print(std::cout);
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "Control.h"
+#include "HDFrestart.h"
+#include "MGmol_MPI.h"
+#include "MPIdata.h"
+#include "PEenv.h"
+
+#include "catch.hpp"
+
+#include <hdf5.h>
+#include <mpi.h>
+
+#include <cmath>
+#include <vector>
+
+static double value(const int i, const int j, const int k)
+{
+    return std::sin(0.1 * i) * std::cos(0.2 * j) + 0.01 * k;
+}
+
+// Write a mesh function in a restart file with compression enabled
+// (shuffle + deflate), and read it back
+TEST_CASE("Write and read compressed restart file", "[restart_compression]")
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int myrank;
+    MPI_Comm_rank(comm, &myrank);
+    MPIdata::mype  = myrank;
+    MPIdata::onpe0 = (myrank == 0);
+
+    MGmol_MPI::setup(comm, std::cout);
+    Control::setup(comm, false, 0.);
+
+    Control& ct                      = *(Control::instance());
+    ct.out_restart_compression       = 2;
+    ct.out_restart_compression_level = 6;
+
+    const unsigned gdim[3] = { 16, 16, 16 };
+    double ll[3]           = { 8., 8., 8. };
+    double origin[3]       = { 0., 0., 0. };
+    const std::string filename("restart_compression");
+
+    pb::PEenv pes(comm, gdim[0], gdim[1], gdim[2], 1);
+
+    int ntasks[3];
+    for (short d = 0; d < 3; d++)
+        ntasks[d] = pes.n_mpi_task(d);
+    const int n0 = gdim[0] / ntasks[0];
+    const int n1 = gdim[1] / ntasks[1];
+    const int n2 = gdim[2] / ntasks[2];
+
+    // write one file per task
+    {
+        std::vector<double> data(n0 * n1 * n2);
+        for (int i = 0; i < n0; i++)
+            for (int j = 0; j < n1; j++)
+                for (int k = 0; k < n2; k++)
+                    data[(i * n1 + j) * n2 + k] = value(
+                        pes.my_mpi(0) * n0 + i, pes.my_mpi(1) * n1 + j,
+                        pes.my_mpi(2) * n2 + k);
+
+        HDFrestart h5file(filename, pes, gdim, 0);
+        int ierr = h5file.write_1func_hdf5(data.data(), "Vtotal", ll, origin);
+        CHECK(ierr == 0);
+        h5file.close();
+    }
+
+    // read it back
+    {
+        HDFrestart h5file(filename, pes, 0);
+
+        // check dataset was written chunked, with shuffle and deflate filters
+        hid_t dset_id = h5file.open_dset("Vtotal");
+        REQUIRE(dset_id >= 0);
+        hid_t plist_id = H5Dget_create_plist(dset_id);
+        CHECK(H5Pget_layout(plist_id) == H5D_CHUNKED);
+        const int nfilters = H5Pget_nfilters(plist_id);
+        CHECK(nfilters == 2);
+        bool shuffle = false;
+        bool deflate = false;
+        for (int i = 0; i < nfilters; i++)
+        {
+            unsigned int flags;
+            size_t nelmts = 0;
+            H5Z_filter_t filter
+                = H5Pget_filter2(plist_id, i, &flags, &nelmts, nullptr, 0,
+                    nullptr, nullptr);
+            if (filter == H5Z_FILTER_SHUFFLE) shuffle = true;
+            if (filter == H5Z_FILTER_DEFLATE) deflate = true;
+        }
+        CHECK(shuffle);
+        CHECK(deflate);
+        H5Pclose(plist_id);
+
+        // smooth data should compress
+        CHECK(H5Dget_storage_size(dset_id) < n0 * n1 * n2 * sizeof(double));
+        h5file.close_dset(dset_id);
+
+        std::vector<double> data(n0 * n1 * n2, -1.);
+        int ierr = h5file.read_1func_hdf5(data.data(), "Vtotal");
+        CHECK(ierr == 0);
+        h5file.close();
+
+        for (int i = 0; i < n0; i++)
+            for (int j = 0; j < n1; j++)
+                for (int k = 0; k < n2; k++)
+                    CHECK(data[(i * n1 + j) * n2 + k]
+                          == value(pes.my_mpi(0) * n0 + i,
+                              pes.my_mpi(1) * n1 + j, pes.my_mpi(2) * n2 + k));
+    }
+}
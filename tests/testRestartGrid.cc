@@ -0,0 +1,105 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "Control.h"
+#include "HDFrestart.h"
+#include "MGmol_MPI.h"
+#include "MPIdata.h"
+#include "PEenv.h"
+
+#include "catch.hpp"
+
+#include <mpi.h>
+
+#include <vector>
+
+static double value(const int i, const int j, const int k)
+{
+    return 10000. * i + 100. * j + k;
+}
+
+// Write a mesh function in a single restart file with one processor grid
+// and read it back with another one using option 3 (single_file_direct)
+TEST_CASE("Read single restart file on a different processor grid",
+    "[restart_grid]")
+{
+    MPI_Comm comm = MPI_COMM_WORLD;
+
+    int npes;
+    MPI_Comm_size(comm, &npes);
+    INFO("This example to set up to use only 4 processes");
+    REQUIRE(npes == 4);
+
+    int myrank;
+    MPI_Comm_rank(comm, &myrank);
+    MPIdata::mype  = myrank;
+    MPIdata::onpe0 = (myrank == 0);
+
+    MGmol_MPI::setup(comm, std::cout);
+    Control::setup(comm, false, 0.);
+
+    const unsigned gdim[3] = { 16, 16, 16 };
+    double ll[3]           = { 8., 8., 8. };
+    double origin[3]       = { 0., 0., 0. };
+    const std::string filename("restart_grid.h5");
+
+    // processor grids split along x and z respectively (PEenv picks the
+    // decomposition for a given shape of mesh)
+    pb::PEenv pes_write(comm, 32, 8, 8, 1);
+    pb::PEenv pes_read(comm, 8, 8, 32, 1);
+    REQUIRE(pes_write.n_mpi_task(0) != pes_read.n_mpi_task(0));
+
+    // write single file, data gathered in x
+    {
+        const pb::PEenv& pes = pes_write;
+        int ntasks[3];
+        for (short d = 0; d < 3; d++)
+            ntasks[d] = pes.n_mpi_task(d);
+
+        const int n0 = gdim[0] / ntasks[0];
+        const int n1 = gdim[1] / ntasks[1];
+        const int n2 = gdim[2] / ntasks[2];
+        std::vector<double> data(n0 * n1 * n2);
+        for (int i = 0; i < n0; i++)
+            for (int j = 0; j < n1; j++)
+                for (int k = 0; k < n2; k++)
+                    data[(i * n1 + j) * n2 + k] = value(
+                        pes.my_mpi(0) * n0 + i, pes.my_mpi(1) * n1 + j,
+                        pes.my_mpi(2) * n2 + k);
+
+        HDFrestart h5file(filename, pes, gdim, 1);
+        int ierr = h5file.write_1func_hdf5(data.data(), "Vtotal", ll, origin);
+        CHECK(ierr == 0);
+        h5file.close();
+    }
+
+    // read with other grid, each task reading its own block
+    {
+        const pb::PEenv& pes = pes_read;
+        int ntasks[3];
+        for (short d = 0; d < 3; d++)
+            ntasks[d] = pes.n_mpi_task(d);
+
+        HDFrestart h5file(filename, pes, 3);
+
+        const int n0 = gdim[0] / ntasks[0];
+        const int n1 = gdim[1] / ntasks[1];
+        const int n2 = gdim[2] / ntasks[2];
+        std::vector<double> data(n0 * n1 * n2, -1.);
+        int ierr = h5file.read_1func_hdf5(data.data(), "Vtotal");
+        CHECK(ierr == 0);
+        h5file.close();
+
+        for (int i = 0; i < n0; i++)
+            for (int j = 0; j < n1; j++)
+                for (int k = 0; k < n2; k++)
+                    CHECK(data[(i * n1 + j) * n2 + k]
+                          == value(pes.my_mpi(0) * n0 + i,
+                              pes.my_mpi(1) * n1 + j, pes.my_mpi(2) * n2 + k));
+    }
+}
@@ -0,0 +1,71 @@
+#include "Timer.h"
+#include "global.h"
+#include "numerical_kernels.h"
+
+#include "catch.hpp"
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Compare threaded accumulation strategies for the O(N^2) part
+// of the density computation, for sizes typical of a
+// LocGridOrbitals subdomain (nrows grid points, ncols colors)
+TEST_CASE("Rho accumulation kernels", "[rho_kernels]")
+{
+    const int nrows  = 16 * 16 * 16;
+    const int ncols  = 128;
+    const int ld     = nrows + 8;
+    const int ntimes = 20;
+
+    std::mt19937 gen(2345);
+    std::uniform_real_distribution<> dis(-1., 1.);
+
+    std::vector<ORBDTYPE> product(nrows * ncols);
+    std::vector<ORBDTYPE> phi(ld * ncols);
+    for (auto& v : product)
+        v = dis(gen);
+    for (auto& v : phi)
+        v = dis(gen);
+
+    // reference computed serially
+    std::vector<RHODTYPE> rho_ref(nrows, 0.);
+    for (int j = 0; j < ncols; ++j)
+        for (int i = 0; i < nrows; ++i)
+            rho_ref[i] += product[j * nrows + i] * phi[j * ld + i];
+
+    std::vector<RHODTYPE> rho_atomic(nrows, 0.);
+    std::vector<RHODTYPE> rho_blocked(nrows, 0.);
+
+    Timer atomic_tm("rhoProductKernelAtomic");
+    Timer blocked_tm("rhoProductKernelBlocked");
+
+    for (int it = 0; it < ntimes; it++)
+    {
+        std::fill(rho_atomic.begin(), rho_atomic.end(), 0.);
+        atomic_tm.start();
+        rhoProductKernelAtomic(
+            nrows, ncols, product.data(), phi.data(), ld, rho_atomic.data());
+        atomic_tm.stop();
+
+        std::fill(rho_blocked.begin(), rho_blocked.end(), 0.);
+        blocked_tm.start();
+        rhoProductKernelBlocked(
+            nrows, ncols, product.data(), phi.data(), ld, rho_blocked.data());
+        blocked_tm.stop();
+    }
+
+    for (int i = 0; i < nrows; ++i)
+    {
+        CHECK(rho_atomic[i] == Approx(rho_ref[i]).margin(1.e-10));
+        CHECK(rho_blocked[i] == Approx(rho_ref[i]).margin(1.e-10));
+    }
+
+#ifdef _OPENMP
+    std::cout << "Number of threads: " << omp_get_max_threads() << std::endl;
+#endif
+    std::cout << "nrows=" << nrows << ", ncols=" << ncols << ", " << ntimes
+              << " calls" << std::endl;
+    atomic_tm.print(std::cout);
+    blocked_tm.print(std::cout);
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "BlacsContext.h"
+#include "Control.h"
+#include "DataDistribution.h"
+#include "DistMatrix.h"
+#include "GramMatrix.h"
+#include "MGmol_MPI.h"
+#include "PEenv.h"
+#include "SP2.h"
+#include "SP2Sparse.h"
+#include "SquareLocalMatrices.h"
+#include "VariableSizeMatrix.h"
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Compare the density matrix computed by sparse SP2 purification with the
+// one computed by dense SP2, for a small banded H and S on one MPI task
+TEST_CASE("Check SP2Sparse against dense SP2", "[sp2sparse]")
+{
+    typedef dist_matrix::DistMatrix<double> MatrixType;
+
+    int npes;
+    MPI_Comm_size(MPI_COMM_WORLD, &npes);
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+    Control::setup(MPI_COMM_WORLD, false, 0.);
+
+    INFO("This example to set up to use only 1 process");
+    REQUIRE(npes == 1);
+
+    dist_matrix::BlacsContext bc(MPI_COMM_WORLD, 1, 1);
+    dist_matrix::DistMatrix<DISTMATDTYPE>::setDefaultBlacsContext(&bc);
+
+    const int n       = 40;
+    const int nocc    = 13;
+    const double tol  = 1.e-8;
+    const double emin = -5.;
+    const double emax = 5.;
+
+    // pentadiagonal H and tridiagonal S
+    std::vector<double> raw_h(n * n, 0.);
+    std::vector<double> raw_s(n * n, 0.);
+    for (int i = 0; i < n; i++)
+    {
+        raw_h[(n + 1) * i] = 1.5 * std::cos(0.7 * i);
+        raw_s[(n + 1) * i] = 1.;
+        if (i < n - 1)
+        {
+            raw_h[(n + 1) * i + 1]       = -0.5;
+            raw_h[(n + 1) * (i + 1) - 1] = -0.5;
+            raw_s[(n + 1) * i + 1]       = 0.1;
+            raw_s[(n + 1) * (i + 1) - 1] = 0.1;
+        }
+        if (i < n - 2)
+        {
+            raw_h[(n + 1) * i + 2]       = 0.2;
+            raw_h[(n + 1) * (i + 2) - 2] = 0.2;
+        }
+    }
+    MatrixType matH("H", n, n);
+    matH.init(raw_h.data(), n);
+    MatrixType matS("S", n, n);
+    matS.init(raw_s.data(), n);
+
+    GramMatrix<MatrixType> gram(n);
+    gram.setMatrix(matS, 0);
+    gram.computeInverse();
+    const MatrixType& invS = gram.getInverse();
+
+    // theta = inv(S)*H
+    MatrixType theta("theta", n, n);
+    theta.gemm('n', 'n', 1., invS, matH, 0.);
+
+    // dense SP2
+    std::vector<double> raw_theta(n * n);
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < n; i++)
+            raw_theta[i + n * j] = theta.getVal(i, j);
+    SquareLocalMatrices<double, MemorySpace::Host> theta_loc(1, n);
+    theta_loc.setValues(raw_theta.data(), n);
+
+    std::vector<int> ids(n);
+    for (int i = 0; i < n; i++)
+        ids[i] = i;
+    SP2 sp2(tol, false);
+    sp2.initializeLocalMat(theta_loc, emin, emax, ids);
+    sp2.solve(2 * nocc, false);
+
+    MatrixType dm("dm", n, n);
+    sp2.getDM(dm, invS);
+
+    // sparse SP2, with all the rows centered on this task
+    VariableSizeMatrix<sparserow> theta_sparse("theta", n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            theta_sparse.insertMatrixElement(
+                i, j, raw_theta[i + n * j], INSERT, true);
+
+    pb::PEenv peenv(MPI_COMM_WORLD, 32, 32, 32);
+    const double domain[3] = { 10., 10., 10. };
+    DataDistribution distributor("SP2", 1., peenv, domain);
+
+    SP2Sparse sp2sparse(tol, 0., ids, ids, distributor);
+    sp2sparse.initialize(theta_sparse, emin, emax);
+    sp2sparse.solve(nocc, false);
+
+    // dm_sparse = 2 * X * inv(S)
+    const VariableSizeMatrix<sparserow>& xi = sp2sparse.getXi();
+    std::vector<double> raw_x(n * n);
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < n; i++)
+            raw_x[i + n * j] = xi.get_value(i, j);
+    MatrixType matX("X", n, n);
+    matX.init(raw_x.data(), n);
+    MatrixType dm_sparse("dm_sparse", n, n);
+    dm_sparse.gemm('n', 'n', 2., matX, invS, 0.);
+
+    // trace(DM*S) = number of electrons
+    CHECK(dm_sparse.traceProduct(matS) == Approx(2. * nocc).epsilon(1.e-6));
+
+    // idempotency: DM*S*DM = 2*DM
+    MatrixType work("work", n, n);
+    work.gemm('n', 'n', 1., dm_sparse, matS, 0.);
+    MatrixType dmsdm("dmsdm", n, n);
+    dmsdm.gemm('n', 'n', 1., work, dm_sparse, 0.);
+    dmsdm.axpy(-2., dm_sparse);
+    CHECK(dmsdm.norm('m') == Approx(0.).margin(1.e-6));
+
+    // same DM as dense SP2
+    dm_sparse.axpy(-1., dm);
+    CHECK(dm_sparse.norm('m') == Approx(0.).margin(1.e-6));
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "Control.h"
+#include "DataDistribution.h"
+#include "MGmol_MPI.h"
+#include "PEenv.h"
+#include "SP2Sparse.h"
+#include "VariableSizeMatrix.h"
+#include "lapack_c.h"
+
+#include "catch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Compare the projector computed by sparse SP2 purification, with rows
+// centered on different MPI tasks, with the projector onto the occupied
+// eigenvectors of the generalized eigenvalue problem H*C = S*C*Lambda
+TEST_CASE("Check SP2Sparse with rows distributed over MPI tasks",
+    "[sp2sparse_mpi]")
+{
+    int npes;
+    MPI_Comm_size(MPI_COMM_WORLD, &npes);
+    int mype;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mype);
+
+    MGmol_MPI::setup(MPI_COMM_WORLD, std::cout);
+    Control::setup(MPI_COMM_WORLD, false, 0.);
+
+    INFO("This example is set up to use more than 1 process");
+    REQUIRE(npes > 1);
+
+    const int n       = 40;
+    const int nocc    = 13;
+    const double tol  = 1.e-8;
+    const double emin = -5.;
+    const double emax = 5.;
+
+    // pentadiagonal H and tridiagonal S
+    std::vector<double> raw_h(n * n, 0.);
+    std::vector<double> raw_s(n * n, 0.);
+    for (int i = 0; i < n; i++)
+    {
+        raw_h[(n + 1) * i] = 1.5 * std::cos(0.7 * i);
+        raw_s[(n + 1) * i] = 1.;
+        if (i < n - 1)
+        {
+            raw_h[(n + 1) * i + 1]       = -0.5;
+            raw_h[(n + 1) * (i + 1) - 1] = -0.5;
+            raw_s[(n + 1) * i + 1]       = 0.1;
+            raw_s[(n + 1) * (i + 1) - 1] = 0.1;
+        }
+        if (i < n - 2)
+        {
+            raw_h[(n + 1) * i + 2]       = 0.2;
+            raw_h[(n + 1) * (i + 2) - 2] = 0.2;
+        }
+    }
+
+    // reference: solve H*C = S*C*Lambda (same result on every task)
+    std::vector<double> evects(raw_h);
+    std::vector<double> work_s(raw_s);
+    std::vector<double> evals(n);
+    const int itype = 1;
+    const int lwork = 4 * n;
+    std::vector<double> work(lwork);
+    int info;
+    DSYGV(&itype, "V", "U", &n, evects.data(), &n, work_s.data(), &n,
+        evals.data(), work.data(), &lwork, &info);
+    REQUIRE(info == 0);
+
+    // C^T*S
+    std::vector<double> cts(n * n, 0.);
+    for (int k = 0; k < n; k++)
+        for (int j = 0; j < n; j++)
+            for (int l = 0; l < n; l++)
+                cts[k + n * j] += evects[l + n * k] * raw_s[l + n * j];
+
+    // theta = inv(S)*H = C*Lambda*C^T*S
+    // and projector onto occupied states X = C_occ*C_occ^T*S
+    std::vector<double> raw_theta(n * n, 0.);
+    std::vector<double> raw_x(n * n, 0.);
+    for (int j = 0; j < n; j++)
+        for (int i = 0; i < n; i++)
+            for (int k = 0; k < n; k++)
+            {
+                const double val = evects[i + n * k] * cts[k + n * j];
+                raw_theta[i + n * j] += evals[k] * val;
+                if (k < nocc) raw_x[i + n * j] += val;
+            }
+
+    // functions centered on this task (round robin), and all functions
+    // overlapping with them
+    std::vector<int> locfcns;
+    for (int i = mype; i < n; i += npes)
+        locfcns.push_back(i);
+    std::vector<int> locvars(n);
+    for (int i = 0; i < n; i++)
+        locvars[i] = i;
+
+    // only rows centered on this task are set in theta
+    VariableSizeMatrix<sparserow> theta_sparse("theta", n);
+    for (auto i : locfcns)
+        for (int j = 0; j < n; j++)
+            theta_sparse.insertMatrixElement(
+                i, j, raw_theta[i + n * j], INSERT, true);
+
+    // spreading radius covers the whole domain, so that every task
+    // gets the rows centered on all the other tasks
+    pb::PEenv peenv(MPI_COMM_WORLD, 32, 32, 32);
+    const double domain[3] = { 10., 10., 10. };
+    DataDistribution distributor("SP2", 10., peenv, domain);
+
+    SP2Sparse sp2sparse(tol, 0., locvars, locfcns, distributor);
+    sp2sparse.initialize(theta_sparse, emin, emax);
+    sp2sparse.solve(nocc, false);
+
+    // every row of Xi, centered on this task or not, matches
+    // the reference projector
+    const VariableSizeMatrix<sparserow>& xi = sp2sparse.getXi();
+    double maxdiff = 0.;
+    double trace   = 0.;
+    for (int i = 0; i < n; i++)
+    {
+        trace += xi.get_value(i, i);
+        for (int j = 0; j < n; j++)
+            maxdiff = std::max(
+                maxdiff, std::abs(xi.get_value(i, j) - raw_x[i + n * j]));
+    }
+    CHECK(trace == Approx(nocc).epsilon(1.e-6));
+    CHECK(maxdiff == Approx(0.).margin(1.e-6));
+}
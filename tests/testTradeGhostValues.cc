@@ -13,6 +13,8 @@
 
 #include "catch.hpp"
 
+#include <array>
+
 // function of periodicity nx, ny, nz
 double cos3(const int i, const int j, const int k, const int nx, const int ny,
     const int nz)
@@ -36,6 +38,10 @@ TEST_CASE("Trade ghost values", "[trade]")
 
     MGmol_MPI& mmpi = *(MGmol_MPI::instance());
 
+    // test with non-blocking and persistent MPI requests
+    const bool persistent = GENERATE(false, true);
+    pb::GridFuncInterface::setPersistentComm(persistent);
+
     // prepare 3 mesh sizes to test with
     std::vector<std::array<unsigned, 3>> meshes;
     {
@@ -63,6 +69,8 @@ TEST_CASE("Trade ghost values", "[trade]")
                 std::cout << "===================================" << std::endl;
                 std::cout << "Number of ghosts points: " << nghosts
                           << std::endl;
+                std::cout << "Persistent requests: " << persistent
+                          << std::endl;
             }
 
             const unsigned ngpts[3] = { mesh[0], mesh[1], mesh[2] };
@@ -113,7 +121,12 @@ TEST_CASE("Trade ghost values", "[trade]")
             double norm_before = gf.norm2();
 
             // fill ghost values with data from neighboring subdomain
-            gf.trade_boundaries();
+            // (twice to reuse persistent requests)
+            for (short i = 0; i < 2; i++)
+            {
+                gf.set_updated_boundaries(false);
+                gf.trade_boundaries();
+            }
 
             // check norm has not changed
             double norm_after = gf.norm2();
@@ -165,7 +178,11 @@ TEST_CASE("Trade ghost values", "[trade]")
                     nx * ny * nz, (double)(i + 1), scaled_data.data());
                 gfv.assign(i, scaled_data.data(), 'd');
             }
-            gfv.trade_boundaries();
+            for (short i = 0; i < 2; i++)
+            {
+                gfv.set_updated_boundaries(false);
+                gfv.trade_boundaries();
+            }
 
             if (mype_env.onpe0())
                 for (int i = 0; i < nfunc; i++)
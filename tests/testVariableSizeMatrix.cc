@@ -6,6 +6,7 @@
 // are all local operations, hence this unit test is designed to use
 // only one processor (without loss of generality).
 //
+#include "CSRMatrix.h"
 #include "MGmol_MPI.h"
 #include "VariableSizeMatrix.h"
 
@@ -14,6 +15,7 @@
 #include <mpi.h>
 
 #include <cassert>
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <iomanip>
@@ -198,3 +200,248 @@ TEST_CASE("Check VariableSizeMatrix", "[variable_size_matrix]")
     std::cout << "Check trace ..." << std::endl;
     CHECK(matC.trace() == Approx(scal * matA.trace()).epsilon(1.e-8));
 }
+
+// Build matrix with sparsity pattern of a Gram matrix: functions centered
+// on a n x n x n cubic lattice (unit spacing), overlapping if their centers
+// are within a distance rc
+static void buildGramLikeMatrix(
+    const int n, const double rc, VariableSizeMatrix<sparserow>& mat)
+{
+    const int rcint = static_cast<int>(rc);
+
+    std::vector<int> cols;
+    std::vector<double> vals;
+    for (int i = 0; i < n * n * n; i++)
+    {
+        const int ix = i / (n * n);
+        const int iy = (i / n) % n;
+        const int iz = i % n;
+
+        cols.clear();
+        vals.clear();
+        for (int jx = std::max(0, ix - rcint); jx <= std::min(n - 1, ix + rcint);
+             jx++)
+            for (int jy = std::max(0, iy - rcint);
+                 jy <= std::min(n - 1, iy + rcint); jy++)
+                for (int jz = std::max(0, iz - rcint);
+                     jz <= std::min(n - 1, iz + rcint); jz++)
+                {
+                    const double r2 = (jx - ix) * (jx - ix)
+                                      + (jy - iy) * (jy - iy)
+                                      + (jz - iz) * (jz - iz);
+                    if (r2 > rc * rc) continue;
+
+                    // columns not sorted, as in matrices assembled
+                    // from local contributions
+                    cols.insert(cols.begin(), (jx * n + jy) * n + jz);
+                    vals.insert(vals.begin(), std::exp(-r2));
+                }
+        mat.insertNewRow(
+            static_cast<int>(cols.size()), i, cols.data(), vals.data(), true);
+    }
+}
+
+TEST_CASE("Check CSRMatrix", "[csr]")
+{
+    const int n = 6;
+
+    VariableSizeMatrix<sparserow> matA("A", n * n * n);
+    buildGramLikeMatrix(n, 2.5, matA);
+
+    VariableSizeMatrix<sparserow> matB("B", n * n * n);
+    buildGramLikeMatrix(n, 1.5, matB);
+
+    CSRMatrix csrA(matA);
+    CSRMatrix csrB(matB);
+
+    CHECK(csrA.n() == matA.n());
+    CHECK(csrA.nnzmat() == matA.nnzmat());
+    CHECK(csrA.trace() == Approx(matA.trace()).epsilon(1.e-12));
+
+    for (int i = 0; i < matA.n(); i += 7)
+    {
+        CHECK(csrA.nnzrow(i) == matA.nnzrow(i));
+        for (int j = 0; j < matA.n(); j += 5)
+        {
+            CHECK(csrA.get_value(i, j) == matA.get_value(i, j));
+            CHECK(csrA.AmultSymB_ij(csrB, i, j)
+                  == Approx(matA.AmultSymB_ij(&matB, i, j)).epsilon(1.e-12));
+        }
+        CHECK(csrA.AmultSymBdiag(csrB, i)
+              == Approx(matA.AmultSymBdiag(&matB, i)).epsilon(1.e-12));
+    }
+
+    // subset of rows
+    std::vector<int> rows = { 3, 17, 100, 1000 };
+    CSRMatrix csrS(matA, rows);
+    CHECK(csrS.n() == 3);
+    CHECK(csrS.getLocalRowIndex(1000) == -1);
+    CHECK(csrS.getLocalRowIndex(17) == 1);
+    CHECK(csrS.AmultSymBdiag(csrB, 100)
+          == Approx(matA.AmultSymBdiag(&matB, 100)).epsilon(1.e-12));
+}
+
+// Timings of one Tr(A*B), as computed for each energy term, where B changes
+// at each call and A (DM or inverse of Gram matrix) only when it is updated.
+// Hidden by default: run with tag [csr_bench]
+TEST_CASE("Benchmark trace of product with Gram matrix", "[.csr_bench]")
+{
+    // about 60 nonzeros per row, as in Gram matrices of typical
+    // localized orbitals
+    const int n   = 12;
+    const int dim = n * n * n;
+
+    VariableSizeMatrix<sparserow> matA("A", dim);
+    buildGramLikeMatrix(n, 2.5, matA);
+    VariableSizeMatrix<sparserow> matB("B", dim);
+    buildGramLikeMatrix(n, 2.5, matB);
+
+    std::cout << "Gram-like matrix: n = " << matA.n()
+              << ", nnz/row = " << matA.nnzmat() / matA.n() << std::endl;
+
+    // rows actually used, as locally centered functions
+    std::vector<int> rows(dim);
+    for (int i = 0; i < dim; i++)
+        rows[i] = i;
+
+    // average over a few calls
+    const int ncalls = 10;
+
+    auto start       = std::chrono::steady_clock::now();
+    double trace_vsm = 0.;
+    for (int k = 0; k < ncalls; k++)
+    {
+        trace_vsm = 0.;
+        for (int i = 0; i < dim; i++)
+            trace_vsm += matA.AmultSymBdiag(&matB, i);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> vsm_time = end - start;
+
+    // A packed once, when it is updated
+    start = std::chrono::steady_clock::now();
+    const CSRMatrix csrA(matA, rows);
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> packA_time = end - start;
+
+    // per call: pack B, then trace
+    start            = std::chrono::steady_clock::now();
+    double trace_csr = 0.;
+    for (int k = 0; k < ncalls; k++)
+    {
+        const CSRMatrix csrB(matB, rows);
+        trace_csr = 0.;
+        for (int i = 0; i < dim; i++)
+            trace_csr += csrA.AmultSymBdiag(csrB, i);
+    }
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> csr_time = end - start;
+
+    std::cout << "Tr(A*B) with VariableSizeMatrix:          "
+              << vsm_time.count() / ncalls << " s" << std::endl;
+    std::cout << "Tr(A*B) with CSRMatrix, incl. packing B:  "
+              << csr_time.count() / ncalls << " s" << std::endl;
+    std::cout << "Packing A (once per update of A):         "
+              << packA_time.count() << " s" << std::endl;
+
+    CHECK(trace_csr == Approx(trace_vsm).epsilon(1.e-12));
+}
+
+TEST_CASE("Check VariableSizeMatrix products", "[matmult]")
+{
+    const int n   = 4;
+    const int dim = n * n * n;
+
+    VariableSizeMatrix<sparserow> matA("A", dim);
+    buildGramLikeMatrix(n, 1.5, matA);
+    VariableSizeMatrix<sparserow> matB("B", dim);
+    buildGramLikeMatrix(n, 2.5, matB);
+
+    VariableSizeMatrix<sparserowtab> pattern(matA, true);
+
+    std::vector<int> rows(dim);
+    std::iota(rows.begin(), rows.end(), 0);
+
+    // reference: dense product
+    std::vector<double> ref(dim * dim, 0.);
+    for (int i = 0; i < dim; i++)
+        for (int j = 0; j < dim; j++)
+            for (int k = 0; k < dim; k++)
+                ref[i * dim + j] += matA.get_value(i, k) * matB.get_value(k, j);
+
+    SECTION("AmultSymB")
+    {
+        VariableSizeMatrix<sparserow> matC("C", dim);
+        matC.setupSparseRows(rows);
+        matA.AmultSymB(&matB, matC, pattern, false);
+
+        for (int i = 0; i < dim; i++)
+            for (int j = 0; j < dim; j++)
+                CHECK(matC.get_value(i, j)
+                      == Approx(ref[i * dim + j]).margin(1.e-12));
+
+        // with pattern and drop tolerance
+        VariableSizeMatrix<sparserow> matD("D", dim);
+        matD.setupSparseRows(rows);
+        matA.AmultSymB(&matB, matD, pattern, true, 1.e-1);
+        for (int i = 0; i < dim; i++)
+            for (int j = 0; j < dim; j++)
+            {
+                const double expected
+                    = (matA.get_value(i, j) != 0.
+                          && std::abs(ref[i * dim + j]) >= 1.e-1)
+                          ? ref[i * dim + j]
+                          : 0.;
+                CHECK(matD.get_value(i, j) == Approx(expected).margin(1.e-12));
+            }
+    }
+
+    SECTION("AmultSymBLocal")
+    {
+        // rows of A stored densely, in the order of the pattern rows
+        VariableSizeMatrix<sparserow> matAdense("Adense", dim);
+        matAdense.setupSparseRows(rows);
+        std::vector<double> vals(dim);
+        for (int i = 0; i < dim; i++)
+        {
+            for (int k = 0; k < dim; k++)
+                vals[k] = matA.get_value(i, k);
+            matAdense.initializeLocalRow(dim, i, rows.data(), vals.data());
+        }
+
+        std::vector<int> locfcns = { 0, 5, 21, 42, 63 };
+
+        VariableSizeMatrix<sparserow> matC("C", dim);
+        matC.setupSparseRows(rows);
+        matAdense.AmultSymBLocal(&matB, matC, locfcns, pattern, false);
+
+        for (auto i : locfcns)
+            for (int j = 0; j < dim; j++)
+                CHECK(matC.get_value(i, j)
+                      == Approx(ref[i * dim + j]).margin(1.e-12));
+    }
+
+    SECTION("AmultB")
+    {
+        // C without rows for last plane of lattice: these columns are
+        // discarded
+        const int nc = dim - n * n;
+        std::vector<int> crows(rows.begin(), rows.begin() + nc);
+        std::vector<int> arows = { 0, 5, 21, 42, 47 };
+
+        VariableSizeMatrix<sparserow> matC("C", dim);
+        matC.setupSparseRows(crows);
+        matA.AmultB(matB, matC, arows, 1.e-2);
+
+        for (auto i : arows)
+            for (int j = 0; j < dim; j++)
+            {
+                const double expected
+                    = (j < nc && std::abs(ref[i * dim + j]) >= 1.e-2)
+                          ? ref[i * dim + j]
+                          : 0.;
+                CHECK(matC.get_value(i, j) == Approx(expected).margin(1.e-12));
+            }
+        CHECK(matC.nnzrow(1) == 0);
+    }
+}
@@ -0,0 +1,388 @@
+// Copyright (c) 2017, Lawrence Livermore National Security, LLC and
+// UT-Battelle, LLC.
+// Produced at the Lawrence Livermore National Laboratory and the Oak Ridge
+// National Laboratory.
+// LLNL-CODE-743438
+// All rights reserved.
+// This file is part of MGmol. For details, see https://github.com/llnl/mgmol.
+// Please also read this link https://github.com/llnl/mgmol/LICENSE
+#include "Delh4.h"
+#include "GridFunc.h"
+#include "LDAFunctional.h"
+#include "PBEFunctional.h"
+#include "PEenv.h"
+#include "Timer.h"
+
+#ifdef USE_LIBXC
+#include <xc.h>
+#endif
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// give access to the energy density of a functional
+template <class XCFunctionalType>
+class XCTester : public XCFunctionalType
+{
+public:
+    XCTester(std::vector<std::vector<RHODTYPE>>& rhoe)
+        : XCFunctionalType(rhoe)
+    {
+    }
+
+    // rho*exc at grid point i
+    double energyDensity(const int i) const
+    {
+        if (this->nspin_ == 1) return this->prho_[i] * this->pexc_[i];
+        if (this->pexc_ != nullptr)
+            return (this->prho_up_[i] + this->prho_dn_[i]) * this->pexc_[i];
+        return this->prho_up_[i] * this->pexc_up_[i]
+               + this->prho_dn_[i] * this->pexc_dn_[i];
+    }
+
+    void setGradients(std::vector<std::vector<RHODTYPE>>& grad)
+    {
+        for (int dir = 0; dir < 3; dir++)
+        {
+            if (this->nspin_ == 1)
+                this->setGradRho(dir, grad[dir].data());
+            else
+            {
+                this->setGradRhoUp(dir, grad[dir].data());
+                this->setGradRhoDn(dir, grad[3 + dir].data());
+            }
+        }
+    }
+};
+
+// random densities in [1.e-4, 1.] and gradients of moderate
+// reduced gradient s ~ |grad rho| / rho^(4/3)
+static void setDensities(std::vector<std::vector<RHODTYPE>>& rho,
+    std::vector<std::vector<RHODTYPE>>& grad, const int seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<> dis(-4., 0.);
+    std::uniform_real_distribution<> disg(-1., 1.);
+
+    for (auto& r : rho)
+        for (auto& v : r)
+            v = std::pow(10., dis(gen));
+
+    const int np = rho[0].size();
+    for (unsigned int is = 0; is < rho.size(); is++)
+        for (int dir = 0; dir < 3; dir++)
+            for (int i = 0; i < np; i++)
+                grad[3 * is + dir][i]
+                    = disg(gen) * std::pow(rho[is][i], 4. / 3.);
+}
+
+// Check potentials against finite differences of the energy density
+// with respect to density (vxc1) and gradient (vxc2) for random inputs,
+// and check densities below threshold are screened out
+TEST_CASE("LDA and PBE functionals", "[xc_functionals]")
+{
+    const int np     = 1000;
+    const double eps = 1.e-6;
+
+    for (const int nspin : { 1, 2 })
+    {
+        std::vector<std::vector<RHODTYPE>> rho(
+            nspin, std::vector<RHODTYPE>(np));
+        std::vector<std::vector<RHODTYPE>> grad(
+            3 * nspin, std::vector<RHODTYPE>(np));
+        setDensities(rho, grad, 1234 + nspin);
+
+        // zero density and density below threshold
+        for (int is = 0; is < nspin; is++)
+        {
+            rho[is][0] = 0.;
+            rho[is][1] = 1.e-20;
+        }
+
+        // perturbed spin up densities, with step balancing truncation
+        // errors (relative to rho_up) and roundoff errors (relative to
+        // total density)
+        std::vector<double> delta(np);
+        std::vector<std::vector<RHODTYPE>> rhop(rho);
+        std::vector<std::vector<RHODTYPE>> rhom(rho);
+        for (int i = 0; i < np; i++)
+        {
+            double rhotot = rho[0][i];
+            if (nspin == 2) rhotot += rho[1][i];
+            delta[i] = eps * std::sqrt(rho[0][i] * rhotot);
+            rhop[0][i] += delta[i];
+            rhom[0][i] -= delta[i];
+        }
+
+        // LDA
+        {
+            XCTester<LDAFunctional> lda(rho);
+            lda.computeXC();
+            XCTester<LDAFunctional> ldap(rhop);
+            ldap.computeXC();
+            XCTester<LDAFunctional> ldam(rhom);
+            ldam.computeXC();
+
+            const POTDTYPE* vxc = (nspin == 1) ? lda.pvxc1_ : lda.pvxc1_up_;
+            CHECK(vxc[0] == 0.);
+            CHECK(lda.energyDensity(0) == 0.);
+            for (int i = 2; i < np; i++)
+            {
+                const double fd
+                    = (ldap.energyDensity(i) - ldam.energyDensity(i))
+                      / (2. * delta[i]);
+                CHECK(vxc[i] == Approx(fd).epsilon(1.e-6));
+            }
+        }
+
+        // PBE
+        {
+            XCTester<PBEFunctional> pbe(rho);
+            pbe.setGradients(grad);
+            pbe.computeXC();
+            XCTester<PBEFunctional> pbep(rhop);
+            pbep.setGradients(grad);
+            pbep.computeXC();
+            XCTester<PBEFunctional> pbem(rhom);
+            pbem.setGradients(grad);
+            pbem.computeXC();
+
+            const POTDTYPE* vxc1 = (nspin == 1) ? pbe.pvxc1_ : pbe.pvxc1_up_;
+            for (int i = 0; i < 2; i++)
+            {
+                CHECK(vxc1[i] == 0.);
+                CHECK(pbe.energyDensity(i) == 0.);
+            }
+            for (int i = 2; i < np; i++)
+            {
+                const double fd
+                    = (pbep.energyDensity(i) - pbem.energyDensity(i))
+                      / (2. * delta[i]);
+                CHECK(vxc1[i] == Approx(fd).epsilon(1.e-6));
+            }
+
+            // scale spin up gradient by (1+-epsg):
+            // d(rho*exc)/d(epsg) = -grad_up.(vxc2_upup grad_up
+            //                                + vxc2_updn grad_dn)
+            const double epsg = 1.e-4;
+            std::vector<std::vector<RHODTYPE>> gradp(grad);
+            std::vector<std::vector<RHODTYPE>> gradm(grad);
+            for (int dir = 0; dir < 3; dir++)
+                for (int i = 0; i < np; i++)
+                {
+                    gradp[dir][i] += epsg * grad[dir][i];
+                    gradm[dir][i] -= epsg * grad[dir][i];
+                }
+            XCTester<PBEFunctional> pbegp(rho);
+            pbegp.setGradients(gradp);
+            pbegp.computeXC();
+            XCTester<PBEFunctional> pbegm(rho);
+            pbegm.setGradients(gradm);
+            pbegm.computeXC();
+
+            for (int i = 2; i < np; i++)
+            {
+                double g2 = 0.;
+                for (int dir = 0; dir < 3; dir++)
+                    g2 += grad[dir][i] * grad[dir][i];
+                double expected = 0.;
+                if (nspin == 1)
+                    expected = -pbe.pvxc2_[i] * g2;
+                else
+                {
+                    double gud = 0.;
+                    for (int dir = 0; dir < 3; dir++)
+                        gud += grad[dir][i] * grad[3 + dir][i];
+                    expected = -pbe.pvxc2_upup_[i] * g2
+                               - pbe.pvxc2_updn_[i] * gud;
+                }
+                const double fd
+                    = (pbegp.energyDensity(i) - pbegm.energyDensity(i))
+                      / (2. * epsg);
+                // roundoff errors relative to energy density
+                const double margin = 1.e-10 * std::abs(pbe.energyDensity(i));
+                CHECK(expected == Approx(fd).epsilon(1.e-6).margin(margin));
+            }
+        }
+    }
+}
+
+// Check gradient computed in one pass against directional derivatives
+TEST_CASE("Gradient 4th order", "[xc_functionals]")
+{
+    const double origin[3]  = { 0., 0., 0. };
+    const double ll         = 2.;
+    const double lattice[3] = { ll, ll, ll };
+    const unsigned ngpts[3] = { 32, 24, 20 };
+    const short nghosts     = 2;
+
+    pb::PEenv mype_env(MPI_COMM_WORLD, ngpts[0], ngpts[1], ngpts[2]);
+    pb::Grid grid(origin, lattice, ngpts, mype_env, nghosts, 0);
+
+    pb::GridFunc<double> gf(grid, 1, 1, 1);
+    std::mt19937 gen(321);
+    std::uniform_real_distribution<> dis(0., 1.);
+    const int np = grid.size();
+    std::vector<double> f(np);
+    for (auto& v : f)
+        v = dis(gen);
+    gf.assign(f.data());
+
+    std::vector<std::vector<double>> grad(3, std::vector<double>(np));
+    pb::Delxh4<double> delx(grid);
+    delx.grad_4th(gf, grad[0].data(), grad[1].data(), grad[2].data());
+
+    pb::Delyh4<double> dely(grid);
+    pb::Delzh4<double> delz(grid);
+    pb::FDoper<double>* del[3] = { &delx, &dely, &delz };
+    pb::GridFunc<double> gf_tmp(grid, 1, 1, 1);
+    std::vector<double> ref(np);
+    for (int dir = 0; dir < 3; dir++)
+    {
+        del[dir]->apply(gf, gf_tmp);
+        gf_tmp.init_vect(ref.data(), 'd');
+        for (int i = 0; i < np; i++)
+            CHECK(grad[dir][i] == Approx(ref[i]).margin(1.e-12));
+    }
+}
+
+// Timings of computeXC on a large number of grid points,
+// compared to LibXC when available
+// (hidden test, run with: testXCFunctionals "[.xc_bench]")
+TEST_CASE("Timing of XC kernels", "[.xc_bench]")
+{
+    const int np     = 200000;
+    const int ntimes = 10;
+
+    for (const int nspin : { 1, 2 })
+    {
+        std::vector<std::vector<RHODTYPE>> rho(
+            nspin, std::vector<RHODTYPE>(np));
+        std::vector<std::vector<RHODTYPE>> grad(
+            3 * nspin, std::vector<RHODTYPE>(np));
+        setDensities(rho, grad, 5678);
+
+        const std::string spin = (nspin == 1) ? "" : " spin";
+        Timer lda_tm("LDAFunctional::computeXC" + spin);
+        Timer pbe_tm("PBEFunctional::computeXC" + spin);
+
+        LDAFunctional lda(rho);
+        XCTester<PBEFunctional> pbe(rho);
+        pbe.setGradients(grad);
+        for (int it = 0; it < ntimes; it++)
+        {
+            lda_tm.start();
+            lda.computeXC();
+            lda_tm.stop();
+
+            pbe_tm.start();
+            pbe.computeXC();
+            pbe_tm.stop();
+        }
+
+        std::cout << "npoints=" << np << ", " << ntimes << " calls"
+                  << std::endl;
+        lda_tm.print(std::cout);
+        pbe_tm.print(std::cout);
+
+#ifdef USE_LIBXC
+        const int xcspin = (nspin == 1) ? XC_UNPOLARIZED : XC_POLARIZED;
+
+        // LibXC inputs: interleaved spin components
+        std::vector<double> xrho(nspin * np);
+        std::vector<double> sigma((2 * nspin - 1) * np);
+        for (int i = 0; i < np; i++)
+        {
+            for (int is = 0; is < nspin; is++)
+                xrho[nspin * i + is] = rho[is][i];
+            for (int dir = 0; dir < 3; dir++)
+            {
+                const double gu = grad[dir][i];
+                const double gd = grad[3 * (nspin - 1) + dir][i];
+                if (nspin == 1)
+                    sigma[i] += gu * gu;
+                else
+                {
+                    sigma[3 * i] += gu * gu;
+                    sigma[3 * i + 1] += gu * gd;
+                    sigma[3 * i + 2] += gd * gd;
+                }
+            }
+        }
+
+        std::vector<double> exc(np);
+        std::vector<double> vrho(nspin * np);
+        std::vector<double> vsigma((2 * nspin - 1) * np);
+        std::vector<double> ctmp(np);
+        std::vector<double> vctmp(nspin * np);
+        std::vector<double> vsctmp((2 * nspin - 1) * np);
+
+        xc_func_type xfunc, cfunc;
+        Timer libxc_lda_tm("LibXC LDA" + spin);
+        xc_func_init(&xfunc, XC_LDA_X, xcspin);
+        xc_func_init(&cfunc, XC_LDA_C_PZ_MOD, xcspin);
+        for (int it = 0; it < ntimes; it++)
+        {
+            libxc_lda_tm.start();
+            xc_lda_exc_vxc(&xfunc, np, xrho.data(), exc.data(), vrho.data());
+            xc_lda_exc_vxc(&cfunc, np, xrho.data(), ctmp.data(), vctmp.data());
+            libxc_lda_tm.stop();
+        }
+        xc_func_end(&xfunc);
+        xc_func_end(&cfunc);
+        libxc_lda_tm.print(std::cout);
+
+        const POTDTYPE* vxc = (nspin == 1) ? lda.pvxc1_ : lda.pvxc1_up_;
+        for (int i = 0; i < np; i++)
+            CHECK(vxc[i]
+                  == Approx(vrho[nspin * i] + vctmp[nspin * i]).epsilon(1.e-6));
+
+        Timer libxc_pbe_tm("LibXC PBE" + spin);
+        xc_func_init(&xfunc, XC_GGA_X_PBE, xcspin);
+        xc_func_init(&cfunc, XC_GGA_C_PBE, xcspin);
+        for (int it = 0; it < ntimes; it++)
+        {
+            libxc_pbe_tm.start();
+            xc_gga_exc_vxc(&xfunc, np, xrho.data(), sigma.data(), exc.data(),
+                vrho.data(), vsigma.data());
+            xc_gga_exc_vxc(&cfunc, np, xrho.data(), sigma.data(), ctmp.data(),
+                vctmp.data(), vsctmp.data());
+            libxc_pbe_tm.stop();
+        }
+        xc_func_end(&xfunc);
+        xc_func_end(&cfunc);
+        libxc_pbe_tm.print(std::cout);
+
+        // vsigma = -0.5*vxc2 (spin unpolarized),
+        // vsigma_uu = -0.5*vxc2_upup, vsigma_ud = -vxc2_updn
+        for (int i = 0; i < np; i++)
+        {
+            const double rhotot = (nspin == 1) ? rho[0][i]
+                                               : rho[0][i] + rho[1][i];
+            CHECK(pbe.energyDensity(i)
+                  == Approx(rhotot * (exc[i] + ctmp[i])).epsilon(1.e-6));
+            if (nspin == 1)
+            {
+                CHECK(pbe.pvxc1_[i]
+                      == Approx(vrho[i] + vctmp[i]).epsilon(1.e-6));
+                CHECK(-0.5 * pbe.pvxc2_[i]
+                      == Approx(vsigma[i] + vsctmp[i]).epsilon(1.e-6));
+            }
+            else
+            {
+                CHECK(pbe.pvxc1_up_[i]
+                      == Approx(vrho[2 * i] + vctmp[2 * i]).epsilon(1.e-6));
+                CHECK(-0.5 * pbe.pvxc2_upup_[i]
+                      == Approx(vsigma[3 * i] + vsctmp[3 * i]).epsilon(1.e-6));
+                CHECK(-pbe.pvxc2_updn_[i]
+                      == Approx(vsigma[3 * i + 1] + vsctmp[3 * i + 1])
+                             .epsilon(1.e-6));
+            }
+        }
+#endif
+    }
+}
@@ -7,8 +7,12 @@
 #
 #usage:
 #python compareTimers.py output1 output2
+#
+#output1 and output2 can be MGmol outputs or JSON files
+#written by the hierarchical profiler (Run.profile_output),
+#in which case max. times over MPI tasks are compared for each region
 
-import sys, string, operator
+import sys, string, operator, json
 
 #ignore timers smaller than abs_threshold
 abs_threshold=5.
@@ -16,26 +20,24 @@ abs_threshold=5.
 #ignore timers of relative difference less than rel_threshold
 rel_threshold=0.05
 
-#read files
-input1=open(sys.argv[1],'r')
-input2=open(sys.argv[2],'r')
-
-lines1=input1.readlines()
-lines2=input2.readlines()
-
-#extract timers from files
-timers1={}
-timers2={}
-
-for line in lines1:
-  if line.count('Timer:'):
-    words=line.split()
-    timers1[words[1]]=words[6]
-
-for line in lines2:
-  if line.count('Timer:'):
-    words=line.split()
-    timers2[words[1]]=words[6]
+#extract timers from file
+def readTimers(filename):
+  timers={}
+  if filename.endswith('.json'):
+    with open(filename,'r') as f:
+      data=json.load(f)
+    for region in data['regions']:
+      timers[region['path']]=repr(region['time']['max'])
+  else:
+    with open(filename,'r') as f:
+      for line in f:
+        if line.count('Timer:'):
+          words=line.split()
+          timers[words[1]]=words[6]
+  return timers
+
+timers1=readTimers(sys.argv[1])
+timers2=readTimers(sys.argv[2])
 
 #analyse timers
 results={}